@@ -0,0 +1,77 @@
+// AllPairsTripRouter.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <cstdio>
+#include "AllPairsTripRouter.hpp"
+#include "CompactDigraph.hpp"
+#include "RoadMapFingerprint.hpp"
+#include "TripMetricWeight.hpp"
+
+
+AllPairsTripRouter::AllPairsTripRouter(const RoadMap& roadMap, const std::string& indexPath)
+    : roadMap_{roadMap}, indexPath_{indexPath}, fingerprint_{roadMapFingerprint(roadMap)}
+{
+}
+
+
+std::vector<std::vector<int>> AllPairsTripRouter::findRoutes(const std::vector<Trip>& trips)
+{
+    std::vector<std::vector<int>> routes;
+
+    for (const Trip& trip : trips)
+    {
+        routes.push_back(matrix(trip.metric).shortestPath(trip.startVertex, trip.endVertex).vertices);
+    }
+
+    return routes;
+}
+
+
+const AllPairsMatrix& AllPairsTripRouter::matrix(TripMetric metric)
+{
+    std::unique_ptr<AllPairsMatrix>& matrix = metric == TripMetric::Distance ? distance_ : time_;
+
+    if (matrix)
+    {
+        return *matrix;
+    }
+
+    std::string path;
+
+    if (!indexPath_.empty())
+    {
+        path = indexPath_ + (metric == TripMetric::Distance ? ".distance" : ".time");
+
+        try
+        {
+            matrix = std::make_unique<AllPairsMatrix>(AllPairsMatrix::map(path, fingerprint_));
+            return *matrix;
+        }
+        catch (DigraphException&)
+        {
+            // missing, stale, or damaged; rebuild below
+        }
+    }
+
+    CompactDigraph graph{roadMap_, VertexOrder::CuthillMcKee};
+    matrix = std::make_unique<AllPairsMatrix>(
+        graph, graph.arcWeights(roadMap_, tripMetricWeight(metric)));
+
+    if (!path.empty())
+    {
+        try
+        {
+            matrix->save(path, fingerprint_);
+        }
+        catch (DigraphException&)
+        {
+            // unwritable; drop whatever was written and answer trips
+            // from the matrix in memory
+            std::remove(path.c_str());
+        }
+    }
+
+    return *matrix;
+}
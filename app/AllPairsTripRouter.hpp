@@ -0,0 +1,48 @@
+// AllPairsTripRouter.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// An AllPairsTripRouter answers each trip by reading its route out of an
+// AllPairsMatrix, without any searching.  The matrix for a metric is only
+// computed the first time a trip needs it.  Given the path of an index
+// file, the matrices are saved to that path with ".distance" or ".time"
+// appended, and mapped from there next time, as long as they were built
+// from the same RoadMap.  If the index can't be written, trips are still
+// answered from the matrices in memory.
+//
+// The matrices take eight bytes per pair of intersections, so this is
+// meant for maps of up to around twenty thousand intersections.
+
+#ifndef ALLPAIRSTRIPROUTER_HPP
+#define ALLPAIRSTRIPROUTER_HPP
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "AllPairs.hpp"
+#include "TripRouter.hpp"
+
+
+
+class AllPairsTripRouter : public TripRouter
+{
+public:
+    explicit AllPairsTripRouter(const RoadMap& roadMap, const std::string& indexPath = "");
+
+    std::vector<std::vector<int>> findRoutes(const std::vector<Trip>& trips) override;
+
+
+private:
+    const RoadMap& roadMap_;
+    std::string indexPath_;
+    std::uint64_t fingerprint_;
+    std::unique_ptr<AllPairsMatrix> distance_;
+    std::unique_ptr<AllPairsMatrix> time_;
+
+    const AllPairsMatrix& matrix(TripMetric metric);
+};
+
+
+
+#endif
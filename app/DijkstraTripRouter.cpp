@@ -0,0 +1,75 @@
+// DijkstraTripRouter.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <map>
+#include <utility>
+#include "DijkstraTripRouter.hpp"
+#include "TripMetricWeight.hpp"
+
+
+DijkstraTripRouter::DijkstraTripRouter(const RoadMap& roadMap)
+    : roadMap_{roadMap}
+{
+}
+
+
+std::vector<std::vector<int>> DijkstraTripRouter::findRoutes(const std::vector<Trip>& trips)
+{
+    // the paths found by forward searches, keyed by metric and start
+    // vertex, and by backward searches, keyed by metric and end vertex
+    std::map<std::pair<TripMetric, int>, std::map<int, DigraphPath>> fromStart;
+    std::map<std::pair<TripMetric, int>, std::map<int, DigraphPath>> toEnd;
+
+    for (TripMetric metric : {TripMetric::Distance, TripMetric::Time})
+    {
+        std::map<int, std::vector<int>> endsByStart;
+        std::map<int, std::vector<int>> startsByEnd;
+
+        for (const Trip& trip : trips)
+        {
+            if (trip.metric == metric)
+            {
+                endsByStart[trip.startVertex].push_back(trip.endVertex);
+                startsByEnd[trip.endVertex].push_back(trip.startVertex);
+            }
+        }
+
+        // One search per distinct vertex on whichever side has fewer.
+        if (startsByEnd.size() < endsByStart.size())
+        {
+            for (auto& [end, starts] : startsByEnd)
+            {
+                toEnd[{metric, end}] = roadMap_.findShortestPathsFrom(
+                    starts, end, tripMetricWeight(metric));
+            }
+        }
+        else
+        {
+            for (auto& [start, ends] : endsByStart)
+            {
+                fromStart[{metric, start}] = roadMap_.findShortestPathsTo(
+                    start, ends, tripMetricWeight(metric));
+            }
+        }
+    }
+
+    std::vector<std::vector<int>> routes;
+
+    for (const Trip& trip : trips)
+    {
+        auto found = fromStart.find({trip.metric, trip.startVertex});
+
+        if (found != fromStart.end())
+        {
+            routes.push_back(found->second.at(trip.endVertex).vertices);
+        }
+        else
+        {
+            routes.push_back(toEnd.at({trip.metric, trip.endVertex}).at(trip.startVertex).vertices);
+        }
+    }
+
+    return routes;
+}
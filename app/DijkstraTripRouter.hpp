@@ -0,0 +1,34 @@
+// DijkstraTripRouter.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A DijkstraTripRouter needs no preprocessing.  For each metric, it groups
+// the trips either by start vertex, running one findShortestPathsTo()
+// search forward from each start vertex, or by end vertex, running one
+// findShortestPathsFrom() search backward from each end vertex, whichever
+// needs fewer searches.  Either kind of search stops as soon as it has
+// reached every vertex its group needs, instead of exploring the whole map.
+
+#ifndef DIJKSTRATRIPROUTER_HPP
+#define DIJKSTRATRIPROUTER_HPP
+
+#include "TripRouter.hpp"
+
+
+
+class DijkstraTripRouter : public TripRouter
+{
+public:
+    explicit DijkstraTripRouter(const RoadMap& roadMap);
+
+    std::vector<std::vector<int>> findRoutes(const std::vector<Trip>& trips) override;
+
+
+private:
+    const RoadMap& roadMap_;
+};
+
+
+
+#endif
@@ -0,0 +1,87 @@
+// DistanceTableReport.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include <iomanip>
+#include <limits>
+#include "DistanceTable.hpp"
+#include "DistanceTableReport.hpp"
+#include "RoadMapHierarchy.hpp"
+#include "TimeFormat.hpp"
+
+
+namespace
+{
+    std::vector<int> distinct(std::vector<int> vertices)
+    {
+        std::sort(vertices.begin(), vertices.end());
+        vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+        return vertices;
+    }
+}
+
+
+void writeDistanceTables(std::ostream& out, const RoadMap& roadMap, const std::vector<Trip>& trips)
+{
+    RoadMapHierarchy hierarchy{roadMap};
+
+    for (TripMetric metric : {TripMetric::Distance, TripMetric::Time})
+    {
+        std::vector<int> sources;
+        std::vector<int> targets;
+
+        for (const Trip& trip : trips)
+        {
+            if (trip.metric == metric)
+            {
+                sources.push_back(trip.startVertex);
+                targets.push_back(trip.endVertex);
+            }
+        }
+
+        if (sources.empty())
+        {
+            continue;
+        }
+
+        sources = distinct(sources);
+        targets = distinct(targets);
+
+        DistanceTable table = distanceTable(hierarchy.metric(metric), sources, targets);
+
+        out << (metric == TripMetric::Distance ? "Shortest distances" : "Shortest driving times")
+            << " from " << sources.size() << (sources.size() == 1 ? " origin" : " origins")
+            << " to " << targets.size() << (targets.size() == 1 ? " destination" : " destinations")
+            << std::endl;
+
+        for (std::size_t row = 0; row < sources.size(); ++row)
+        {
+            out << "  From " << roadMap.vertexInfo(sources[row]) << std::endl;
+
+            for (std::size_t column = 0; column < targets.size(); ++column)
+            {
+                double value = table.distance(row, column);
+                out << "    to " << roadMap.vertexInfo(targets[column]) << ": ";
+
+                if (value == std::numeric_limits<double>::infinity())
+                {
+                    out << "no route";
+                }
+                else if (metric == TripMetric::Distance)
+                {
+                    out << std::setprecision(1) << std::fixed << value << " miles";
+                }
+                else
+                {
+                    out << formatTime(value * 3600);
+                }
+
+                out << std::endl;
+            }
+        }
+
+        out << std::endl;
+    }
+}
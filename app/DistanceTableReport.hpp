@@ -0,0 +1,28 @@
+// DistanceTableReport.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// writeDistanceTables() is the program's batch mode: rather than a route
+// for each trip, it writes a table of shortest distances or driving times
+// between every start vertex and every end vertex named in the trips,
+// which is what a dispatcher matching depots to customers needs.
+
+#ifndef DISTANCETABLEREPORT_HPP
+#define DISTANCETABLEREPORT_HPP
+
+#include <ostream>
+#include <vector>
+#include "RoadMap.hpp"
+#include "Trip.hpp"
+
+
+
+// writeDistanceTables() writes, for each TripMetric used by the given
+// trips, a table from each distinct start vertex of those trips to each
+// distinct end vertex of those trips.
+void writeDistanceTables(std::ostream& out, const RoadMap& roadMap, const std::vector<Trip>& trips);
+
+
+
+#endif
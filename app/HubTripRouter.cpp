@@ -0,0 +1,51 @@
+// HubTripRouter.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <fstream>
+#include "HubTripRouter.hpp"
+
+
+HubTripRouter::HubTripRouter(const RoadMap& roadMap, const std::string& indexPath)
+{
+    if (!indexPath.empty())
+    {
+        std::ifstream in{indexPath, std::ios::binary};
+
+        if (in)
+        {
+            try
+            {
+                labels_ = std::make_unique<RoadMapHubLabels>(roadMap, in);
+                return;
+            }
+            catch (DigraphException&)
+            {
+                // stale or damaged; rebuild below
+            }
+        }
+    }
+
+    labels_ = std::make_unique<RoadMapHubLabels>(roadMap);
+
+    if (!indexPath.empty())
+    {
+        std::ofstream out{indexPath, std::ios::binary};
+        labels_->write(out);
+    }
+}
+
+
+std::vector<std::vector<int>> HubTripRouter::findRoutes(const std::vector<Trip>& trips)
+{
+    std::vector<std::vector<int>> routes;
+
+    for (const Trip& trip : trips)
+    {
+        routes.push_back(
+            labels_->labels(trip.metric).shortestPath(trip.startVertex, trip.endVertex).vertices);
+    }
+
+    return routes;
+}
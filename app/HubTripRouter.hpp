@@ -0,0 +1,35 @@
+// HubTripRouter.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A HubTripRouter answers each trip from the RoadMap's hub labels.  Given
+// the path of an index file, it loads the labels from that file when it
+// holds labels for the same RoadMap, and otherwise builds them and saves
+// them there for next time.
+
+#ifndef HUBTRIPROUTER_HPP
+#define HUBTRIPROUTER_HPP
+
+#include <memory>
+#include <string>
+#include "RoadMapHubLabels.hpp"
+#include "TripRouter.hpp"
+
+
+
+class HubTripRouter : public TripRouter
+{
+public:
+    explicit HubTripRouter(const RoadMap& roadMap, const std::string& indexPath = "");
+
+    std::vector<std::vector<int>> findRoutes(const std::vector<Trip>& trips) override;
+
+
+private:
+    std::unique_ptr<RoadMapHubLabels> labels_;
+};
+
+
+
+#endif
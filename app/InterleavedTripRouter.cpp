@@ -0,0 +1,50 @@
+// InterleavedTripRouter.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <utility>
+#include "InterleavedSearch.hpp"
+#include "InterleavedTripRouter.hpp"
+#include "TripMetricWeight.hpp"
+
+
+InterleavedTripRouter::InterleavedTripRouter(const RoadMap& roadMap)
+    : graph_{roadMap, VertexOrder::CuthillMcKee},
+      distance_{graph_.arcWeights(roadMap, tripMetricWeight(TripMetric::Distance))},
+      time_{graph_.arcWeights(roadMap, tripMetricWeight(TripMetric::Time))}
+{
+}
+
+
+std::vector<std::vector<int>> InterleavedTripRouter::findRoutes(const std::vector<Trip>& trips)
+{
+    std::vector<std::vector<int>> routes(trips.size());
+
+    // Trips are batched by metric, since every search in a batch uses the
+    // same weights.
+    for (TripMetric metric : {TripMetric::Distance, TripMetric::Time})
+    {
+        std::vector<std::pair<int, int>> queries;
+        std::vector<int> tripIndices;
+
+        for (int i = 0; i < static_cast<int>(trips.size()); ++i)
+        {
+            if (trips[i].metric == metric)
+            {
+                queries.push_back({graph_.index(trips[i].startVertex), graph_.index(trips[i].endVertex)});
+                tripIndices.push_back(i);
+            }
+        }
+
+        std::vector<DigraphPath> paths = interleavedShortestPaths(
+            graph_, metric == TripMetric::Distance ? distance_ : time_, queries);
+
+        for (int i = 0; i < static_cast<int>(paths.size()); ++i)
+        {
+            routes[tripIndices[i]] = std::move(paths[i].vertices);
+        }
+    }
+
+    return routes;
+}
@@ -0,0 +1,37 @@
+// InterleavedTripRouter.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// An InterleavedTripRouter runs one point-to-point search per trip, but
+// runs several of them at once on a single thread, each taking turns while
+// the others wait for memory (see interleavedShortestPaths()).  This pays
+// off on maps too large to fit in the cache, where a lone search spends
+// most of its time waiting.
+
+#ifndef INTERLEAVEDTRIPROUTER_HPP
+#define INTERLEAVEDTRIPROUTER_HPP
+
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "TripRouter.hpp"
+
+
+
+class InterleavedTripRouter : public TripRouter
+{
+public:
+    explicit InterleavedTripRouter(const RoadMap& roadMap);
+
+    std::vector<std::vector<int>> findRoutes(const std::vector<Trip>& trips) override;
+
+
+private:
+    CompactDigraph graph_;
+    std::vector<double> distance_;
+    std::vector<double> time_;
+};
+
+
+
+#endif
@@ -0,0 +1,28 @@
+// OverlayTripRouter.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include "OverlayTripRouter.hpp"
+
+
+OverlayTripRouter::OverlayTripRouter(const RoadMap& roadMap)
+    : overlay_{roadMap},
+      distanceQuery_{overlay_.metric(TripMetric::Distance)},
+      timeQuery_{overlay_.metric(TripMetric::Time)}
+{
+}
+
+
+std::vector<std::vector<int>> OverlayTripRouter::findRoutes(const std::vector<Trip>& trips)
+{
+    std::vector<std::vector<int>> routes;
+
+    for (const Trip& trip : trips)
+    {
+        OverlayQuery& query = trip.metric == TripMetric::Distance ? distanceQuery_ : timeQuery_;
+        routes.push_back(query.shortestPath(trip.startVertex, trip.endVertex).vertices);
+    }
+
+    return routes;
+}
@@ -0,0 +1,33 @@
+// OverlayTripRouter.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// An OverlayTripRouter builds a RoadMapOverlay for its RoadMap up front,
+// then answers each trip with one query on the overlay.
+
+#ifndef OVERLAYTRIPROUTER_HPP
+#define OVERLAYTRIPROUTER_HPP
+
+#include "RoadMapOverlay.hpp"
+#include "TripRouter.hpp"
+
+
+
+class OverlayTripRouter : public TripRouter
+{
+public:
+    explicit OverlayTripRouter(const RoadMap& roadMap);
+
+    std::vector<std::vector<int>> findRoutes(const std::vector<Trip>& trips) override;
+
+
+private:
+    RoadMapOverlay overlay_;
+    OverlayQuery distanceQuery_;
+    OverlayQuery timeQuery_;
+};
+
+
+
+#endif
@@ -0,0 +1,59 @@
+// PhastTripRouter.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include <map>
+#include <utility>
+#include "Phast.hpp"
+#include "PhastTripRouter.hpp"
+
+
+PhastTripRouter::PhastTripRouter(const RoadMap& roadMap)
+    : hierarchy_{roadMap}
+{
+}
+
+
+std::vector<std::vector<int>> PhastTripRouter::findRoutes(const std::vector<Trip>& trips)
+{
+    const CompactDigraph& graph = hierarchy_.graph();
+
+    // the tree from each distinct start vertex, keyed by metric and start vertex
+    std::map<std::pair<TripMetric, int>, SingleSourcePaths> trees;
+
+    for (TripMetric metric : {TripMetric::Distance, TripMetric::Time})
+    {
+        std::vector<int> starts;
+
+        for (const Trip& trip : trips)
+        {
+            if (trip.metric == metric)
+            {
+                starts.push_back(trip.startVertex);
+            }
+        }
+
+        std::sort(starts.begin(), starts.end());
+        starts.erase(std::unique(starts.begin(), starts.end()), starts.end());
+
+        PhastQuery query{hierarchy_.metric(metric)};
+        std::vector<SingleSourcePaths> paths = query.shortestPaths(starts);
+
+        for (std::size_t i = 0; i < starts.size(); ++i)
+        {
+            trees[{metric, starts[i]}] = std::move(paths[i]);
+        }
+    }
+
+    std::vector<std::vector<int>> routes;
+
+    for (const Trip& trip : trips)
+    {
+        const SingleSourcePaths& tree = trees.at({trip.metric, trip.startVertex});
+        routes.push_back(predecessorPath(graph, tree.predecessors, trip.startVertex, trip.endVertex));
+    }
+
+    return routes;
+}
@@ -0,0 +1,33 @@
+// PhastTripRouter.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A PhastTripRouter works like a DijkstraTripRouter, computing one
+// shortest path tree per distinct start vertex and metric, except that it
+// computes all of the trees up front with PHAST sweeps of a RoadMap's
+// contraction hierarchy, several at a time.
+
+#ifndef PHASTTRIPROUTER_HPP
+#define PHASTTRIPROUTER_HPP
+
+#include "RoadMapHierarchy.hpp"
+#include "TripRouter.hpp"
+
+
+
+class PhastTripRouter : public TripRouter
+{
+public:
+    explicit PhastTripRouter(const RoadMap& roadMap);
+
+    std::vector<std::vector<int>> findRoutes(const std::vector<Trip>& trips) override;
+
+
+private:
+    RoadMapHierarchy hierarchy_;
+};
+
+
+
+#endif
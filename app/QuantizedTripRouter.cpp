@@ -0,0 +1,59 @@
+// QuantizedTripRouter.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include "QuantizedTripRouter.hpp"
+#include "TripMetricWeight.hpp"
+
+
+namespace
+{
+    std::vector<std::uint64_t> quantizedWeights(
+        const CompactDigraph& graph, const RoadMap& roadMap, TripMetric metric)
+    {
+        auto weight = tripMetricQuantizedWeight(metric);
+        std::vector<std::uint64_t> weights;
+
+        for (const RoadSegment& segment : graph.arcInfos(roadMap))
+        {
+            weights.push_back(weight(segment));
+        }
+
+        return weights;
+    }
+}
+
+
+QuantizedTripRouter::QuantizedTripRouter(const RoadMap& roadMap)
+    : graph_{roadMap, VertexOrder::CuthillMcKee},
+      distance_{quantizedWeights(graph_, roadMap, TripMetric::Distance)},
+      time_{quantizedWeights(graph_, roadMap, TripMetric::Time)}
+{
+}
+
+
+std::vector<std::vector<int>> QuantizedTripRouter::findRoutes(const std::vector<Trip>& trips)
+{
+    std::vector<std::vector<int>> routes;
+
+    for (const Trip& trip : trips)
+    {
+        auto key = std::make_pair(trip.metric, trip.startVertex);
+        auto found = paths_.find(key);
+
+        if (found == paths_.end())
+        {
+            const std::vector<std::uint64_t>& weights =
+                trip.metric == TripMetric::Distance ? distance_ : time_;
+
+            found = paths_.emplace(key, quantizedShortestPaths(
+                graph_, weights, graph_.index(trip.startVertex))).first;
+        }
+
+        routes.push_back(predecessorPath(
+            graph_, found->second.predecessors, trip.startVertex, trip.endVertex));
+    }
+
+    return routes;
+}
@@ -0,0 +1,43 @@
+// QuantizedTripRouter.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A QuantizedTripRouter runs one search of the whole map per distinct
+// start vertex and metric.  Its searches use weights quantized to integers
+// (see tripMetricQuantizedWeight()) and a radix heap in place of a binary
+// heap.
+
+#ifndef QUANTIZEDTRIPROUTER_HPP
+#define QUANTIZEDTRIPROUTER_HPP
+
+#include <cstdint>
+#include <map>
+#include <utility>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "QuantizedShortestPaths.hpp"
+#include "TripRouter.hpp"
+
+
+
+class QuantizedTripRouter : public TripRouter
+{
+public:
+    explicit QuantizedTripRouter(const RoadMap& roadMap);
+
+    std::vector<std::vector<int>> findRoutes(const std::vector<Trip>& trips) override;
+
+
+private:
+    CompactDigraph graph_;
+    std::vector<std::uint64_t> distance_;
+    std::vector<std::uint64_t> time_;
+
+    // the paths found by each search, keyed by metric and start vertex
+    std::map<std::pair<TripMetric, int>, QuantizedPaths> paths_;
+};
+
+
+
+#endif
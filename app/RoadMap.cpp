@@ -0,0 +1,37 @@
+// RoadMap.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <utility>
+#include "RoadMap.hpp"
+
+
+RoadMap::RoadMap()
+    : names_{std::make_shared<StringPool>()}
+{
+}
+
+
+RoadMap::RoadMap(std::shared_ptr<StringPool> names)
+    : names_{std::move(names)}
+{
+}
+
+
+void RoadMap::addVertex(int vertex, std::string_view name)
+{
+    // A RoadMap that has been moved from has given its pool away.
+    if (names_ == nullptr)
+    {
+        names_ = std::make_shared<StringPool>();
+    }
+
+    Digraph::addVertex(vertex, names_->intern(name));
+}
+
+
+const std::shared_ptr<StringPool>& RoadMap::names() const noexcept
+{
+    return names_;
+}
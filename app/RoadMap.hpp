@@ -3,22 +3,59 @@
 // ICS 46 Winter 2022
 // Project #5: Rock and Roll Stops the Traffic
 //
-// This header defines a type RoadMap, which is simply a shorthand name for a
-// particular instantiation of the Digraph template, where each vertex has a
-// string for its information and each edge has a RoadSegment for its information.
+// This header declares a class RoadMap, which is a particular kind of Digraph,
+// where each vertex has the name of a location for its information and each
+// edge has a RoadSegment for its information.
+//
+// The names are kept in a StringPool, so each one is stored only once, and
+// a vertex's information is a std::string_view of its name in the pool.
+// That makes vertexInfo() cheap enough to call for every line of output.
+// Copies of a RoadMap share the same pool, which lives as long as any of
+// them does.
+//
+// A RoadMap is passed to the algorithms in core/ as the Digraph it is, so
+// it inherits publicly, but vertices must only ever be added through
+// RoadMap::addVertex().  Digraph::addVertex() (reached through a Digraph
+// reference, or by naming it explicitly) would store a std::string_view
+// of a name the pool doesn't own, which dangles once the caller's string
+// goes away.
 
 #ifndef ROADMAP_HPP
 #define ROADMAP_HPP
 
-#include <string>
+#include <memory>
+#include <string_view>
 #include "Digraph.hpp"
 #include "RoadSegment.hpp"
+#include "StringPool.hpp"
 
 
 
-using RoadMap = Digraph<std::string, RoadSegment>;
+class RoadMap : public Digraph<std::string_view, RoadSegment>
+{
+public:
+    // The default constructor initializes an empty RoadMap with a pool of
+    // names of its own.
+    RoadMap();
 
+    // This constructor initializes an empty RoadMap whose names are kept in
+    // the given pool, which might be shared with other RoadMaps.
+    explicit RoadMap(std::shared_ptr<StringPool> names);
 
+    // addVertex() adds a vertex with the given vertex number, whose name is
+    // a copy of the given one in this RoadMap's pool.  If there is already
+    // a vertex with the given vertex number, a DigraphException is thrown.
+    // This hides Digraph::addVertex(), which must not be used on a RoadMap.
+    void addVertex(int vertex, std::string_view name);
+
+    // names() returns the pool this RoadMap's names are kept in.
+    const std::shared_ptr<StringPool>& names() const noexcept;
 
-#endif
 
+private:
+    std::shared_ptr<StringPool> names_;
+};
+
+
+
+#endif
@@ -0,0 +1,36 @@
+// RoadMapFingerprint.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include "RoadMapFingerprint.hpp"
+
+
+std::uint64_t roadMapFingerprint(const RoadMap& roadMap)
+{
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    auto add = [&](const void* data, std::size_t size)
+        {
+            const unsigned char* bytes = static_cast<const unsigned char*>(data);
+
+            for (std::size_t i = 0; i < size; ++i)
+            {
+                hash = (hash ^ bytes[i]) * 1099511628211ULL;
+            }
+        };
+
+    for (int vertex : roadMap.vertexRange())
+    {
+        add(&vertex, sizeof(vertex));
+
+        for (const DigraphEdge<RoadSegment>& edge : roadMap.edgeRange(vertex))
+        {
+            add(&edge.toVertex, sizeof(edge.toVertex));
+            add(&edge.einfo.miles, sizeof(edge.einfo.miles));
+            add(&edge.einfo.milesPerHour, sizeof(edge.einfo.milesPerHour));
+        }
+    }
+
+    return hash;
+}
@@ -0,0 +1,25 @@
+// RoadMapFingerprint.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// roadMapFingerprint() summarizes a RoadMap in a single number, which is
+// stored alongside anything precomputed from the RoadMap and saved to a
+// file, so that it's never used with a different (or since-changed)
+// RoadMap by mistake.
+
+#ifndef ROADMAPFINGERPRINT_HPP
+#define ROADMAPFINGERPRINT_HPP
+
+#include <cstdint>
+#include "RoadMap.hpp"
+
+
+
+// roadMapFingerprint() computes a 64-bit FNV-1a hash of the structure of
+// a RoadMap and both of its metrics.
+std::uint64_t roadMapFingerprint(const RoadMap& roadMap);
+
+
+
+#endif
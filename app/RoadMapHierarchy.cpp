@@ -0,0 +1,45 @@
+// RoadMapHierarchy.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include "RoadMapHierarchy.hpp"
+#include "TripMetricWeight.hpp"
+
+
+RoadMapHierarchy::RoadMapHierarchy(const RoadMap& roadMap, int threadCount)
+    : graph_{roadMap},
+      segments_{graph_.arcInfos(roadMap)},
+      hierarchy_{graph_},
+      distance_{hierarchy_,
+          segmentWeights(segments_, tripMetricWeight(TripMetric::Distance)), threadCount},
+      time_{hierarchy_,
+          segmentWeights(segments_, tripMetricWeight(TripMetric::Time)), threadCount}
+{
+}
+
+
+const CompactDigraph& RoadMapHierarchy::graph() const noexcept
+{
+    return graph_;
+}
+
+
+const CustomizableContractionHierarchy& RoadMapHierarchy::hierarchy() const noexcept
+{
+    return hierarchy_;
+}
+
+
+const CustomizedMetric& RoadMapHierarchy::metric(TripMetric metric) const noexcept
+{
+    return metric == TripMetric::Distance ? distance_ : time_;
+}
+
+
+CustomizedMetric RoadMapHierarchy::customize(
+    std::function<double(const RoadSegment&)> edgeWeightFunc,
+    int threadCount) const
+{
+    return CustomizedMetric{hierarchy_, segmentWeights(segments_, edgeWeightFunc), threadCount};
+}
@@ -0,0 +1,67 @@
+// RoadMapHierarchy.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A RoadMapHierarchy is the metric-independent preprocessing of a RoadMap
+// (a customizable contraction hierarchy), kept together with what's
+// needed to customize it for any metric later.  The two TripMetrics are
+// customized up front; other metrics, like traffic-adjusted driving time
+// or a cost that accounts for tolls, can be customized at any time
+// without redoing the expensive part of the preprocessing.
+
+#ifndef ROADMAPHIERARCHY_HPP
+#define ROADMAPHIERARCHY_HPP
+
+#include <functional>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "CustomizableContractionHierarchy.hpp"
+#include "RoadMap.hpp"
+#include "TripMetric.hpp"
+
+
+
+class RoadMapHierarchy
+{
+public:
+    // This constructor builds the hierarchy for the given RoadMap and
+    // customizes it for both TripMetrics, using up to threadCount threads
+    // for customization.  The RoadMap isn't needed afterward.
+    explicit RoadMapHierarchy(const RoadMap& roadMap, int threadCount = defaultThreadCount());
+
+    // RoadMapHierarchies refer to themselves internally, so they can't be
+    // copied or moved.
+    RoadMapHierarchy(const RoadMapHierarchy&) = delete;
+    RoadMapHierarchy& operator=(const RoadMapHierarchy&) = delete;
+
+    // graph() returns the compact form of the RoadMap the hierarchy was
+    // built from.
+    const CompactDigraph& graph() const noexcept;
+
+    // hierarchy() returns the metric-independent part of the hierarchy.
+    const CustomizableContractionHierarchy& hierarchy() const noexcept;
+
+    // metric() returns the hierarchy customized for the given TripMetric.
+    const CustomizedMetric& metric(TripMetric metric) const noexcept;
+
+    // customize() returns the hierarchy customized for the given function
+    // determining the weight of a RoadSegment, using up to threadCount
+    // threads.  The result refers to this RoadMapHierarchy, which must
+    // outlive it.
+    CustomizedMetric customize(
+        std::function<double(const RoadSegment&)> edgeWeightFunc,
+        int threadCount = defaultThreadCount()) const;
+
+
+private:
+    CompactDigraph graph_;
+    std::vector<RoadSegment> segments_;
+    CustomizableContractionHierarchy hierarchy_;
+    CustomizedMetric distance_;
+    CustomizedMetric time_;
+};
+
+
+
+#endif
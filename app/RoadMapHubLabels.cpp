@@ -0,0 +1,69 @@
+// RoadMapHubLabels.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include "CustomizableContractionHierarchy.hpp"
+#include "RoadMapFingerprint.hpp"
+#include "RoadMapHubLabels.hpp"
+#include "TripMetricWeight.hpp"
+
+
+namespace
+{
+    std::uint64_t readFingerprint(const RoadMap& roadMap, std::istream& in)
+    {
+        std::uint64_t stored = 0;
+        in.read(reinterpret_cast<char*>(&stored), sizeof(stored));
+
+        if (!in || stored != roadMapFingerprint(roadMap))
+        {
+            throw DigraphException{"RoadMapHubLabels: the labels are for a different road map."};
+        }
+
+        return stored;
+    }
+}
+
+
+RoadMapHubLabels::RoadMapHubLabels(const RoadMap& roadMap)
+    : RoadMapHubLabels{roadMap, CompactDigraph{roadMap}}
+{
+}
+
+
+RoadMapHubLabels::RoadMapHubLabels(const RoadMap& roadMap, const CompactDigraph& graph)
+    : RoadMapHubLabels{roadMap, graph, hierarchyHubOrder(CustomizableContractionHierarchy{graph})}
+{
+}
+
+
+RoadMapHubLabels::RoadMapHubLabels(
+    const RoadMap& roadMap, const CompactDigraph& graph, const std::vector<int>& order)
+    : fingerprint_{roadMapFingerprint(roadMap)},
+      distance_{graph, graph.arcWeights(roadMap, tripMetricWeight(TripMetric::Distance)), order},
+      time_{graph, graph.arcWeights(roadMap, tripMetricWeight(TripMetric::Time)), order}
+{
+}
+
+
+RoadMapHubLabels::RoadMapHubLabels(const RoadMap& roadMap, std::istream& in)
+    : fingerprint_{readFingerprint(roadMap, in)},
+      distance_{HubLabels::read(in)},
+      time_{HubLabels::read(in)}
+{
+}
+
+
+const HubLabels& RoadMapHubLabels::labels(TripMetric metric) const noexcept
+{
+    return metric == TripMetric::Distance ? distance_ : time_;
+}
+
+
+void RoadMapHubLabels::write(std::ostream& out) const
+{
+    out.write(reinterpret_cast<const char*>(&fingerprint_), sizeof(fingerprint_));
+    distance_.write(out);
+    time_.write(out);
+}
@@ -0,0 +1,60 @@
+// RoadMapHubLabels.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// RoadMapHubLabels are the hub labels of a RoadMap for both TripMetrics,
+// with hubs picked in the order of a contraction hierarchy's ranks.
+// Building them takes far longer than answering any number of queries,
+// so they can be saved to a file and loaded again later.  The file
+// records a fingerprint of the RoadMap it was built from, so labels for
+// a different (or since-changed) RoadMap are never used by mistake.
+
+#ifndef ROADMAPHUBLABELS_HPP
+#define ROADMAPHUBLABELS_HPP
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "HubLabels.hpp"
+#include "RoadMap.hpp"
+#include "TripMetric.hpp"
+
+
+
+class RoadMapHubLabels
+{
+public:
+    // This constructor builds the labels for the given RoadMap.
+    explicit RoadMapHubLabels(const RoadMap& roadMap);
+
+    // This constructor reads labels for the given RoadMap from a stream
+    // written by write().  If the stream doesn't contain labels, or they
+    // were built from a different RoadMap, a DigraphException is thrown.
+    RoadMapHubLabels(const RoadMap& roadMap, std::istream& in);
+
+    // labels() returns the labels for the given TripMetric.
+    const HubLabels& labels(TripMetric metric) const noexcept;
+
+    // write() writes the labels to the given binary stream.
+    void write(std::ostream& out) const;
+
+
+private:
+    // The graph and hub order are built once and shared by the labels
+    // for both TripMetrics.
+    RoadMapHubLabels(const RoadMap& roadMap, const CompactDigraph& graph);
+
+    RoadMapHubLabels(
+        const RoadMap& roadMap, const CompactDigraph& graph, const std::vector<int>& order);
+
+    std::uint64_t fingerprint_;
+    HubLabels distance_;
+    HubLabels time_;
+};
+
+
+
+#endif
@@ -0,0 +1,92 @@
+// RoadMapOverlay.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <utility>
+#include "RoadMapOverlay.hpp"
+#include "TripMetricWeight.hpp"
+
+
+namespace
+{
+    // Cells on the levels of the overlay hold at most this many vertices;
+    // levels whose cells would hold the whole map are left out.
+    const std::vector<int> cellSizes{64, 1024, 16384};
+
+
+    GraphPartition partitionRoadMap(const CompactDigraph& graph, int threadCount)
+    {
+        std::vector<int> sizes;
+
+        for (int size : cellSizes)
+        {
+            if (size < graph.vertexCount())
+            {
+                sizes.push_back(size);
+            }
+        }
+
+        return partitionGraph(graph, sizes, threadCount);
+    }
+}
+
+
+RoadMapOverlay::RoadMapOverlay(const RoadMap& roadMap, int threadCount)
+    : graph_{roadMap},
+      segments_{graph_.arcInfos(roadMap)},
+      overlay_{graph_, partitionRoadMap(graph_, threadCount)},
+      distance_{overlay_,
+          segmentWeights(segments_, tripMetricWeight(TripMetric::Distance)), threadCount},
+      time_{overlay_,
+          segmentWeights(segments_, tripMetricWeight(TripMetric::Time)), threadCount}
+{
+}
+
+
+const CompactDigraph& RoadMapOverlay::graph() const noexcept
+{
+    return graph_;
+}
+
+
+const OverlayGraph& RoadMapOverlay::overlay() const noexcept
+{
+    return overlay_;
+}
+
+
+const OverlayMetric& RoadMapOverlay::metric(TripMetric metric) const noexcept
+{
+    return metric == TripMetric::Distance ? distance_ : time_;
+}
+
+
+int RoadMapOverlay::applyTrafficDeltas(const std::vector<TrafficDelta>& deltas, int threadCount)
+{
+    // Every delta is checked before any of them is applied.
+    std::vector<int> arcs;
+
+    for (const TrafficDelta& delta : deltas)
+    {
+        int arc = graph_.findArc(graph_.index(delta.fromVertex), graph_.index(delta.toVertex));
+
+        if (arc == -1)
+        {
+            throw DigraphException{"RoadMapOverlay applyTrafficDeltas(): the edge does not exist."};
+        }
+
+        arcs.push_back(arc);
+    }
+
+    auto timeWeight = tripMetricWeight(TripMetric::Time);
+    std::vector<std::pair<int, double>> changes;
+
+    for (std::size_t i = 0; i < deltas.size(); ++i)
+    {
+        segments_[arcs[i]].milesPerHour = deltas[i].milesPerHour;
+        changes.push_back({arcs[i], timeWeight(segments_[arcs[i]])});
+    }
+
+    return time_.updateArcWeights(changes, threadCount);
+}
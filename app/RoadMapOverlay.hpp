@@ -0,0 +1,66 @@
+// RoadMapOverlay.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A RoadMapOverlay is a multi-level overlay graph for a RoadMap, customized
+// for both TripMetrics.  Since each cell's cliques only depend on the road
+// segments inside it, traffic updates are applied by customizing again
+// just the cells containing the changed segments, rather than redoing
+// the whole customization.
+
+#ifndef ROADMAPOVERLAY_HPP
+#define ROADMAPOVERLAY_HPP
+
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "MultiLevelOverlay.hpp"
+#include "RoadMap.hpp"
+#include "TrafficDelta.hpp"
+#include "TripMetric.hpp"
+
+
+
+class RoadMapOverlay
+{
+public:
+    // This constructor partitions the given RoadMap, builds its overlay,
+    // and customizes it for both TripMetrics, using up to threadCount
+    // threads.  The RoadMap isn't needed afterward.
+    explicit RoadMapOverlay(const RoadMap& roadMap, int threadCount = defaultThreadCount());
+
+    // RoadMapOverlays refer to themselves internally, so they can't be
+    // copied or moved.
+    RoadMapOverlay(const RoadMapOverlay&) = delete;
+    RoadMapOverlay& operator=(const RoadMapOverlay&) = delete;
+
+    // graph() returns the compact form of the RoadMap the overlay was
+    // built from.
+    const CompactDigraph& graph() const noexcept;
+
+    // overlay() returns the metric-independent part of the overlay.
+    const OverlayGraph& overlay() const noexcept;
+
+    // metric() returns the overlay customized for the given TripMetric.
+    const OverlayMetric& metric(TripMetric metric) const noexcept;
+
+    // applyTrafficDeltas() changes the speed of each road segment named
+    // in the given deltas and customizes the driving time metric again
+    // for the affected cells only.  It returns the number of cells that
+    // were customized again.  If a delta names a road segment that does
+    // not exist, a DigraphException is thrown and nothing is changed.
+    int applyTrafficDeltas(
+        const std::vector<TrafficDelta>& deltas, int threadCount = defaultThreadCount());
+
+
+private:
+    CompactDigraph graph_;
+    std::vector<RoadSegment> segments_;
+    OverlayGraph overlay_;
+    OverlayMetric distance_;
+    OverlayMetric time_;
+};
+
+
+
+#endif
@@ -0,0 +1,23 @@
+// RoadMapVersion.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <utility>
+#include "CompactDigraphAlgorithms.hpp"
+#include "RoadMapVersion.hpp"
+
+
+std::shared_ptr<const RoadMapVersion> makeRoadMapVersion(RoadMap roadMap, bool buildHubLabels)
+{
+    bool stronglyConnected = isStronglyConnected(CompactDigraph{roadMap});
+    std::optional<RoadMapHubLabels> hubLabels;
+
+    if (buildHubLabels)
+    {
+        hubLabels.emplace(roadMap);
+    }
+
+    return std::make_shared<const RoadMapVersion>(
+        RoadMapVersion{std::move(roadMap), stronglyConnected, std::move(hubLabels)});
+}
@@ -0,0 +1,46 @@
+// RoadMapVersion.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A RoadMapVersion bundles one version of the road map together with the
+// information precomputed from it.  Versions are immutable once built and
+// are published through a RoadMapHolder, so that a new map extract can be
+// swapped in while queries against the previous one are still running.
+// Any hub labels travel with the map they were built from, so a reader
+// holding a version never mixes one map's labels with another's.  They're
+// the most expensive preprocessing there is, though, so they're only built
+// when the caller asks for them.
+
+#ifndef ROADMAPVERSION_HPP
+#define ROADMAPVERSION_HPP
+
+#include <memory>
+#include <optional>
+#include "RoadMap.hpp"
+#include "RoadMapHubLabels.hpp"
+#include "SnapshotHolder.hpp"
+
+
+
+struct RoadMapVersion
+{
+    RoadMap roadMap;
+    bool stronglyConnected;
+    std::optional<RoadMapHubLabels> hubLabels;
+};
+
+
+using RoadMapHolder = SnapshotHolder<RoadMapVersion>;
+
+
+// makeRoadMapVersion() takes ownership of the given RoadMap, computes
+// what is attached to a version of it (including hub labels, if
+// buildHubLabels is true), and returns the finished, immutable version
+// ready to be published.
+std::shared_ptr<const RoadMapVersion> makeRoadMapVersion(
+    RoadMap roadMap, bool buildHubLabels = false);
+
+
+
+#endif
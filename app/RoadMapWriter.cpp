@@ -10,24 +10,21 @@ void RoadMapWriter::writeRoadMap(std::ostream& out, const RoadMap& roadMap)
 {
     out << "LOCATIONS" << std::endl;
 
-    for (int vertex : roadMap.vertices())
+    for (int vertex : roadMap.vertexRange())
     {
-        out << "    " << vertex << ": " << roadMap.vertexInfo(vertex) << std::endl;
+        out << "    " << vertex << ": " << roadMap.vertexInfoRef(vertex) << std::endl;
     }
 
     out << std::endl;
     out << "ROAD SEGMENTS" << std::endl;
 
-    for (std::pair<int, int> edge : roadMap.edges())
+    for (const DigraphEdge<RoadSegment>& edge : roadMap.edgeRange())
     {
-        out << "    " << edge.first << "," << edge.second << ": ";
-
-        RoadSegment segment = roadMap.edgeInfo(edge.first, edge.second);
-        out << segment.miles << "miles; " << segment.milesPerHour << "mph";
+        out << "    " << edge.fromVertex << "," << edge.toVertex << ": ";
+        out << edge.einfo.miles << "miles; " << edge.einfo.milesPerHour << "mph";
 
         out << std::endl;
     }
 
     out << std::endl;
 }
-
@@ -0,0 +1,412 @@
+// SimplifiedRoadMap.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <algorithm>
+#include <deque>
+#include <set>
+#include <utility>
+#include "SimplifiedRoadMap.hpp"
+
+
+namespace
+{
+    // A PassThrough describes how to leave an intersection that can be
+    // collapsed: from whichever neighbor you came, carry on to the other.
+    // A one-way pass-through can only be entered from "in" and left to
+    // "out"; a two-way one goes both ways between its two neighbors.
+    struct PassThrough
+    {
+        int in;
+        int out;
+        bool twoWay;
+    };
+
+
+    std::map<int, PassThrough> findPassThroughs(const RoadMap& roadMap)
+    {
+        std::map<int, std::vector<int>> incoming;
+
+        for (auto& [from, to] : roadMap.edges())
+        {
+            incoming[to].push_back(from);
+        }
+
+        std::map<int, PassThrough> passThroughs;
+
+        for (int v : roadMap.vertices())
+        {
+            std::vector<int> out;
+
+            for (auto& [from, to] : roadMap.edges(v))
+            {
+                out.push_back(to);
+            }
+
+            std::vector<int>& in = incoming[v];
+            std::sort(in.begin(), in.end());
+            std::sort(out.begin(), out.end());
+
+            if (std::find(out.begin(), out.end(), v) != out.end())
+            {
+                continue;
+            }
+
+            if (in.size() == 1 && out.size() == 1 && in[0] != out[0])
+            {
+                passThroughs[v] = PassThrough{in[0], out[0], false};
+            }
+            else if (in.size() == 2 && out.size() == 2 && in == out)
+            {
+                passThroughs[v] = PassThrough{in[0], in[1], true};
+            }
+        }
+
+        return passThroughs;
+    }
+
+
+    // A Run is what one road segment of the simplified RoadMap stands for:
+    // the road from a kept intersection "start" through its neighbor
+    // "first" and any pass-through intersections after it ("hops"), up to
+    // the next kept intersection "end".  A run with no hops is a road
+    // segment copied unchanged.
+    struct Run
+    {
+        int start;
+        int first;
+        int end;
+        std::vector<int> hops;
+        RoadSegment segment;
+        bool alive;
+    };
+
+
+    // A RunCollapser finds the runs of a RoadMap.  Collapsing a run can
+    // conflict with another segment between the same two intersections
+    // (parallel or divided streets make this common), which is resolved
+    // on the spot by keeping the first hop of one of them as a real
+    // intersection, dropping only the runs that pass through that hop, and
+    // tracing those again in two shorter pieces.  Each conflict costs time
+    // proportional to the runs it touches, not the size of the map.
+    class RunCollapser
+    {
+    public:
+        RunCollapser(const RoadMap& roadMap, std::map<int, PassThrough> passThroughs);
+
+        // collapse() finds every run, resolving conflicts as it goes.
+        void collapse();
+
+        bool isPassThrough(int v) const;
+
+        // runFrom() returns the run leaving "start" toward "first", or
+        // nullptr if there isn't one (because it leads back to "start").
+        const Run* runFrom(int start, int first) const;
+
+
+    private:
+        const RoadMap& roadMap_;
+        std::map<int, PassThrough> passThroughs_;
+
+        std::vector<Run> runs_;
+        std::map<std::pair<int, int>, int> byEnds_;
+        std::map<std::pair<int, int>, int> byFirst_;
+        std::map<int, std::vector<int>> runsThrough_;
+        std::map<int, int> coverage_;
+        std::set<int> looped_;
+
+        std::deque<std::pair<int, int>> work_;
+
+        Run trace(int start, int first) const;
+        void processWork();
+        void add(Run run);
+        void remove(int id);
+        void keep(int v);
+    };
+
+
+    RunCollapser::RunCollapser(const RoadMap& roadMap, std::map<int, PassThrough> passThroughs)
+        : roadMap_{roadMap}, passThroughs_{std::move(passThroughs)}
+    {
+    }
+
+
+    void RunCollapser::collapse()
+    {
+        for (int start : roadMap_.vertices())
+        {
+            if (!isPassThrough(start))
+            {
+                for (auto& [tail, first] : roadMap_.edges(start))
+                {
+                    work_.push_back({start, first});
+                }
+            }
+        }
+
+        processWork();
+
+        // Every pass-through intersection should be on some run; any that
+        // aren't are on rings of nothing but pass-throughs, and each such
+        // ring keeps one of them.
+        std::vector<int> candidates;
+
+        for (auto& [v, p] : passThroughs_)
+        {
+            candidates.push_back(v);
+        }
+
+        for (int v : candidates)
+        {
+            if (isPassThrough(v) && coverage_[v] == 0 && looped_.count(v) == 0)
+            {
+                keep(v);
+                processWork();
+            }
+        }
+    }
+
+
+    bool RunCollapser::isPassThrough(int v) const
+    {
+        return passThroughs_.count(v) != 0;
+    }
+
+
+    const Run* RunCollapser::runFrom(int start, int first) const
+    {
+        auto found = byFirst_.find({start, first});
+        return found == byFirst_.end() ? nullptr : &runs_[found->second];
+    }
+
+
+    Run RunCollapser::trace(int start, int first) const
+    {
+        Run run{start, first, first, {}, roadMap_.edgeInfo(start, first), true};
+        double hours = run.segment.miles / run.segment.milesPerHour;
+
+        int previous = start;
+
+        for (auto found = passThroughs_.find(run.end); found != passThroughs_.end();
+            found = passThroughs_.find(run.end))
+        {
+            const PassThrough& p = found->second;
+            int next = p.twoWay && previous == p.out ? p.in : p.out;
+            const RoadSegment& hop = roadMap_.edgeInfo(run.end, next);
+
+            run.hops.push_back(run.end);
+            run.segment.miles += hop.miles;
+            hours += hop.miles / hop.milesPerHour;
+
+            previous = run.end;
+            run.end = next;
+        }
+
+        if (!run.hops.empty() && hours > 0.0)
+        {
+            run.segment.milesPerHour = run.segment.miles / hours;
+        }
+
+        return run;
+    }
+
+
+    void RunCollapser::processWork()
+    {
+        while (!work_.empty())
+        {
+            auto [start, first] = work_.front();
+            work_.pop_front();
+
+            if (byFirst_.count({start, first}) != 0)
+            {
+                continue;
+            }
+
+            Run run = trace(start, first);
+
+            // A run leading back where it started can't be part of a
+            // shortest path.
+            if (run.end == start)
+            {
+                looped_.insert(run.hops.begin(), run.hops.end());
+                continue;
+            }
+
+            // Two segments between the same intersections (which could be
+            // best for different metrics) can't both be kept, so the first
+            // hop of one of them becomes a real intersection.  Roads
+            // never repeat, so at least one of the two has hops.
+            auto existing = byEnds_.find({start, run.end});
+
+            if (existing != byEnds_.end())
+            {
+                keep(!run.hops.empty() ? run.hops.front() : runs_[existing->second].hops.front());
+                work_.push_front({start, first});
+                continue;
+            }
+
+            add(std::move(run));
+        }
+    }
+
+
+    void RunCollapser::add(Run run)
+    {
+        int id = runs_.size();
+
+        byEnds_[{run.start, run.end}] = id;
+        byFirst_[{run.start, run.first}] = id;
+
+        for (int hop : run.hops)
+        {
+            coverage_[hop]++;
+            runsThrough_[hop].push_back(id);
+        }
+
+        runs_.push_back(std::move(run));
+    }
+
+
+    void RunCollapser::remove(int id)
+    {
+        Run& run = runs_[id];
+        run.alive = false;
+
+        byEnds_.erase({run.start, run.end});
+        byFirst_.erase({run.start, run.first});
+
+        for (int hop : run.hops)
+        {
+            coverage_[hop]--;
+        }
+    }
+
+
+    void RunCollapser::keep(int v)
+    {
+        passThroughs_.erase(v);
+
+        // The runs through v now end there instead; they're traced again
+        // from their starts, and v gets runs of its own.
+        for (int id : runsThrough_[v])
+        {
+            if (runs_[id].alive)
+            {
+                remove(id);
+                work_.push_back({runs_[id].start, runs_[id].first});
+            }
+        }
+
+        runsThrough_.erase(v);
+
+        for (auto& [tail, head] : roadMap_.edges(v))
+        {
+            work_.push_back({v, head});
+        }
+    }
+}
+
+
+SimplifiedRoadMap::SimplifiedRoadMap(const RoadMap& roadMap, const std::vector<int>& protectedVertices)
+{
+    std::map<int, PassThrough> passThroughs = findPassThroughs(roadMap);
+
+    for (int v : protectedVertices)
+    {
+        passThroughs.erase(v);
+    }
+
+    RunCollapser collapser{roadMap, std::move(passThroughs)};
+    collapser.collapse();
+
+    roadMap_ = RoadMap{roadMap.names()};
+
+    for (int v : roadMap.vertices())
+    {
+        if (!collapser.isPassThrough(v))
+        {
+            roadMap_.addVertex(v, roadMap.vertexInfo(v));
+        }
+    }
+
+    // Segments are added in the same order as the original map's edges,
+    // so searches on the simplified map break ties the same way.
+    for (int start : roadMap_.vertices())
+    {
+        for (auto& [tail, first] : roadMap.edges(start))
+        {
+            const Run* run = collapser.runFrom(start, first);
+
+            if (run == nullptr)
+            {
+                continue;
+            }
+
+            if (!run->hops.empty())
+            {
+                int begin = hops_.size();
+                hopRanges_[{start, run->end}] = {begin, begin + static_cast<int>(run->hops.size())};
+                hops_.insert(hops_.end(), run->hops.begin(), run->hops.end());
+            }
+
+            roadMap_.addEdge(start, run->end, run->segment);
+        }
+    }
+}
+
+
+const RoadMap& SimplifiedRoadMap::roadMap() const noexcept
+{
+    return roadMap_;
+}
+
+
+int SimplifiedRoadMap::hopCount(int fromVertex, int toVertex) const
+{
+    // edgeInfo() throws if there's no such segment
+    roadMap_.edgeInfo(fromVertex, toVertex);
+
+    auto found = hopRanges_.find({fromVertex, toVertex});
+    return found == hopRanges_.end() ? 0 : found->second.second - found->second.first;
+}
+
+
+std::vector<int> SimplifiedRoadMap::expandRoute(const std::vector<int>& route) const
+{
+    std::vector<int> expanded;
+
+    for (std::size_t i = 0; i < route.size(); ++i)
+    {
+        if (i > 0)
+        {
+            auto found = hopRanges_.find({route[i - 1], route[i]});
+
+            if (found != hopRanges_.end())
+            {
+                expanded.insert(
+                    expanded.end(), hops_.begin() + found->second.first,
+                    hops_.begin() + found->second.second);
+            }
+        }
+
+        expanded.push_back(route[i]);
+    }
+
+    return expanded;
+}
+
+
+std::vector<int> tripEndpoints(const std::vector<Trip>& trips)
+{
+    std::vector<int> endpoints;
+
+    for (const Trip& trip : trips)
+    {
+        endpoints.push_back(trip.startVertex);
+        endpoints.push_back(trip.endVertex);
+    }
+
+    return endpoints;
+}
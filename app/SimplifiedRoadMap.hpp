@@ -0,0 +1,76 @@
+// SimplifiedRoadMap.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A SimplifiedRoadMap is a smaller RoadMap with the same shortest paths as
+// a given one, made by collapsing chains of "pass-through" intersections
+// into single road segments.  An intersection is passed through when the
+// only way to leave it is to carry on to the other of its two neighbors:
+// either it has one road in and one road out to different places (like a
+// freeway ramp), or it lies on a two-way street with two neighbors (like a
+// point in the middle of a block).  A maximal run of such intersections
+// becomes one segment whose length and driving time are the totals along
+// the run, so every shortest path in the simplified RoadMap is a shortest
+// path in the original one with its pass-through intersections left out.
+//
+// The original hops of every collapsed segment are kept, so a route in the
+// simplified RoadMap can be expanded back into the original route, with
+// every "Continue to" step in it.  Intersections given as protected (such
+// as the start and end of each trip) are always kept.
+//
+// A run is left partly uncollapsed when collapsing it would give two
+// segments between the same intersections (which could be best for
+// different metrics), and rings of pass-through intersections keep one of
+// them, so no intersection reachable by a protected one is lost.
+
+#ifndef SIMPLIFIEDROADMAP_HPP
+#define SIMPLIFIEDROADMAP_HPP
+
+#include <map>
+#include <utility>
+#include <vector>
+#include "RoadMap.hpp"
+#include "Trip.hpp"
+
+
+
+class SimplifiedRoadMap
+{
+public:
+    // This constructor simplifies the given RoadMap, never collapsing the
+    // intersections with the given vertex numbers.
+    SimplifiedRoadMap(const RoadMap& roadMap, const std::vector<int>& protectedVertices);
+
+    // roadMap() returns the simplified RoadMap.
+    const RoadMap& roadMap() const noexcept;
+
+    // hopCount() returns the number of intersections that were collapsed
+    // into the segment from one vertex to another of the simplified
+    // RoadMap, which is zero for segments copied unchanged.
+    int hopCount(int fromVertex, int toVertex) const;
+
+    // expandRoute() turns a route in the simplified RoadMap (a sequence of
+    // vertex numbers) into the corresponding route in the original one.
+    std::vector<int> expandRoute(const std::vector<int>& route) const;
+
+
+private:
+    RoadMap roadMap_;
+
+    // The collapsed intersections of all segments back to back; the ones
+    // for the segment between two vertices are in the positions that
+    // hopRanges_ maps that pair of vertices to, in driving order.
+    std::vector<int> hops_;
+    std::map<std::pair<int, int>, std::pair<int, int>> hopRanges_;
+};
+
+
+
+// tripEndpoints() returns the start and end vertex of every trip, which
+// are the intersections that simplifying a RoadMap for them must keep.
+std::vector<int> tripEndpoints(const std::vector<Trip>& trips);
+
+
+
+#endif
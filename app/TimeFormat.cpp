@@ -0,0 +1,31 @@
+// TimeFormat.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <iomanip>
+#include <sstream>
+#include "TimeFormat.hpp"
+
+
+std::string formatTime(double seconds)
+{
+    std::ostringstream out;
+
+    int wholeHours = static_cast<int>(seconds / 3600);
+    if (wholeHours > 0)
+    {
+        out << wholeHours << (wholeHours == 1 ? " hr " : " hrs ");
+        seconds -= wholeHours * 3600;
+    }
+
+    int wholeMinutes = static_cast<int>(seconds / 60);
+    if (wholeMinutes > 0)
+    {
+        out << wholeMinutes << (wholeMinutes == 1 ? " min " : " mins ");
+        seconds -= wholeMinutes * 60;
+    }
+
+    out << std::setprecision(1) << std::fixed << seconds << " secs";
+    return out.str();
+}
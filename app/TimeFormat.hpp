@@ -0,0 +1,23 @@
+// TimeFormat.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// formatTime() formats a driving time the way the program's output shows
+// it, so that routes and distance tables read the same.
+
+#ifndef TIMEFORMAT_HPP
+#define TIMEFORMAT_HPP
+
+#include <string>
+
+
+
+// formatTime() formats the given number of seconds as whole hours and
+// minutes (each left out when there are none) followed by the remaining
+// seconds to one decimal place, e.g., "1 hr 4 mins 3.5 secs".
+std::string formatTime(double seconds);
+
+
+
+#endif
@@ -0,0 +1,24 @@
+// TrafficDelta.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A TrafficDelta describes one change in traffic conditions: the road
+// segment from one location to another is now being travelled at a
+// different speed (in miles per hour).
+
+#ifndef TRAFFICDELTA_HPP
+#define TRAFFICDELTA_HPP
+
+
+
+struct TrafficDelta
+{
+    int fromVertex;
+    int toVertex;
+    double milesPerHour;
+};
+
+
+
+#endif
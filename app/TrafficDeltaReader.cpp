@@ -0,0 +1,30 @@
+// TrafficDeltaReader.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include <sstream>
+#include "TrafficDeltaReader.hpp"
+
+
+std::vector<TrafficDelta> TrafficDeltaReader::readTrafficDeltas(InputReader& in)
+{
+    std::vector<TrafficDelta> deltas;
+
+    int numberOfDeltas = in.readIntLine();
+
+    for (int i = 0; i < numberOfDeltas; ++i)
+    {
+        std::istringstream deltaLine{in.readLine()};
+
+        int fromVertex;
+        int toVertex;
+        double milesPerHour;
+
+        deltaLine >> fromVertex >> toVertex >> milesPerHour;
+
+        deltas.push_back({fromVertex, toVertex, milesPerHour});
+    }
+
+    return deltas;
+}
@@ -0,0 +1,38 @@
+// TrafficDeltaReader.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A TrafficDeltaReader reads a batch of traffic updates from the given
+// input.  The format follows the one used for road segments and trips:
+// a line with the number of updates, followed by one line per update
+// containing the "from" location, the "to" location, and the new speed
+// in miles per hour, e.g.,
+//
+//     # number of updates
+//     2
+//
+//     # the updates
+//     11 10 23.5
+//     10 9 31.0
+
+#ifndef TRAFFICDELTAREADER_HPP
+#define TRAFFICDELTAREADER_HPP
+
+#include <vector>
+#include "TrafficDelta.hpp"
+#include "InputReader.hpp"
+
+
+
+class TrafficDeltaReader
+{
+public:
+    // readTrafficDeltas() reads a batch of traffic updates from the given
+    // input, returning them as a vector of TrafficDelta structs.
+    std::vector<TrafficDelta> readTrafficDeltas(InputReader& in);
+};
+
+
+
+#endif
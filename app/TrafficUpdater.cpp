@@ -0,0 +1,30 @@
+// TrafficUpdater.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include "TrafficUpdater.hpp"
+
+
+int TrafficUpdater::applyDeltas(
+    RoadMap& roadMap, const std::vector<TrafficDelta>& deltas,
+    std::vector<RoadMapShortestPathTree>& trees)
+{
+    int changed = 0;
+
+    for (const TrafficDelta& delta : deltas)
+    {
+        RoadSegment oldSegment = roadMap.edgeInfo(delta.fromVertex, delta.toVertex);
+        RoadSegment newSegment{oldSegment.miles, delta.milesPerHour};
+
+        roadMap.updateEdgeInfo(delta.fromVertex, delta.toVertex, newSegment);
+
+        for (RoadMapShortestPathTree& tree : trees)
+        {
+            changed += tree.edgeUpdated(
+                roadMap, delta.fromVertex, delta.toVertex, oldSegment);
+        }
+    }
+
+    return changed;
+}
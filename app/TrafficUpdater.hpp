@@ -0,0 +1,39 @@
+// TrafficUpdater.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A TrafficUpdater applies batches of traffic updates to a RoadMap in
+// place, and repairs any shortest path trees computed from that RoadMap
+// so they don't have to be thrown away and recomputed.
+
+#ifndef TRAFFICUPDATER_HPP
+#define TRAFFICUPDATER_HPP
+
+#include <string_view>
+#include <vector>
+#include "RoadMap.hpp"
+#include "ShortestPathTree.hpp"
+#include "TrafficDelta.hpp"
+
+
+
+using RoadMapShortestPathTree = ShortestPathTree<std::string_view, RoadSegment>;
+
+
+class TrafficUpdater
+{
+public:
+    // applyDeltas() changes the speed of each road segment named in the
+    // given deltas, repairing each of the given trees after every change.
+    // It returns the total number of tree vertices whose distance changed.
+    // If a delta names a road segment that does not exist, a
+    // DigraphException is thrown; the deltas before it remain applied.
+    int applyDeltas(
+        RoadMap& roadMap, const std::vector<TrafficDelta>& deltas,
+        std::vector<RoadMapShortestPathTree>& trees);
+};
+
+
+
+#endif
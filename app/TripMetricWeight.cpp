@@ -0,0 +1,44 @@
+// TripMetricWeight.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include "QuantizedShortestPaths.hpp"
+#include "TripMetricWeight.hpp"
+
+
+std::function<double(const RoadSegment&)> tripMetricWeight(TripMetric metric)
+{
+    if (metric == TripMetric::Distance)
+    {
+        return [](const RoadSegment& r){ return r.miles; };
+    }
+    else
+    {
+        return [](const RoadSegment& r){ return r.miles / r.milesPerHour; };
+    }
+}
+
+
+std::function<std::uint64_t(const RoadSegment&)> tripMetricQuantizedWeight(TripMetric metric)
+{
+    // Time weights are in hours.
+    double unitsPerWeight = metric == TripMetric::Distance ? 1e6 : 3.6e9;
+    return quantizedWeight<RoadSegment>(tripMetricWeight(metric), unitsPerWeight);
+}
+
+
+std::vector<double> segmentWeights(
+    const std::vector<RoadSegment>& segments,
+    const std::function<double(const RoadSegment&)>& edgeWeightFunc)
+{
+    std::vector<double> weights;
+    weights.reserve(segments.size());
+
+    for (const RoadSegment& segment : segments)
+    {
+        weights.push_back(edgeWeightFunc(segment));
+    }
+
+    return weights;
+}
@@ -0,0 +1,46 @@
+// TripMetricWeight.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// tripMetricWeight() translates a TripMetric into the function that
+// determines the weight of a RoadSegment, which is the form every
+// shortest path algorithm in core/ expects a metric to be in.
+// tripMetricQuantizedWeight() does the same for the algorithms that
+// expect integer weights, and segmentWeights() applies a weight function
+// to a whole array of RoadSegments at once.
+
+#ifndef TRIPMETRICWEIGHT_HPP
+#define TRIPMETRICWEIGHT_HPP
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+#include "RoadSegment.hpp"
+#include "TripMetric.hpp"
+
+
+
+// tripMetricWeight() returns a function giving the weight of a RoadSegment
+// under the given TripMetric: its length in miles for TripMetric::Distance,
+// or the time it takes to drive in hours for TripMetric::Time.
+std::function<double(const RoadSegment&)> tripMetricWeight(TripMetric metric);
+
+
+// tripMetricQuantizedWeight() returns a function giving the weight of a
+// RoadSegment under the given TripMetric as a whole number of millionths
+// of a mile or microseconds, far finer than the tenths that are printed.
+std::function<std::uint64_t(const RoadSegment&)> tripMetricQuantizedWeight(TripMetric metric);
+
+
+// segmentWeights() returns the weight of each of the given RoadSegments,
+// in the same order, under the given weight function.  It's how arc
+// weights are recomputed from the RoadSegments a CompactDigraph's arcs
+// stand for, without looking them up in the RoadMap again.
+std::vector<double> segmentWeights(
+    const std::vector<RoadSegment>& segments,
+    const std::function<double(const RoadSegment&)>& edgeWeightFunc);
+
+
+
+#endif
@@ -0,0 +1,51 @@
+// TripRouter.cpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+
+#include "AllPairsTripRouter.hpp"
+#include "DijkstraTripRouter.hpp"
+#include "HubTripRouter.hpp"
+#include "InterleavedTripRouter.hpp"
+#include "OverlayTripRouter.hpp"
+#include "PhastTripRouter.hpp"
+#include "QuantizedTripRouter.hpp"
+#include "TripRouter.hpp"
+
+
+std::unique_ptr<TripRouter> makeTripRouter(
+    const std::string& engine, const RoadMap& roadMap, const std::string& indexPath)
+{
+    if (engine == "dijkstra")
+    {
+        return std::make_unique<DijkstraTripRouter>(roadMap);
+    }
+    else if (engine == "overlay")
+    {
+        return std::make_unique<OverlayTripRouter>(roadMap);
+    }
+    else if (engine == "phast")
+    {
+        return std::make_unique<PhastTripRouter>(roadMap);
+    }
+    else if (engine == "hub")
+    {
+        return std::make_unique<HubTripRouter>(roadMap, indexPath);
+    }
+    else if (engine == "quantized")
+    {
+        return std::make_unique<QuantizedTripRouter>(roadMap);
+    }
+    else if (engine == "interleaved")
+    {
+        return std::make_unique<InterleavedTripRouter>(roadMap);
+    }
+    else if (engine == "all-pairs")
+    {
+        return std::make_unique<AllPairsTripRouter>(roadMap, indexPath);
+    }
+    else
+    {
+        return nullptr;
+    }
+}
@@ -0,0 +1,60 @@
+// TripRouter.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// A TripRouter finds the route for each of a batch of trips on one
+// RoadMap.  There are several ways to do that, with different trade-offs
+// between preprocessing time, memory, and query time, so the one that
+// main() uses is chosen by name with makeTripRouter().
+
+#ifndef TRIPROUTER_HPP
+#define TRIPROUTER_HPP
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "RoadMap.hpp"
+#include "Trip.hpp"
+
+
+
+class TripRouter
+{
+public:
+    virtual ~TripRouter() = default;
+
+    // findRoutes() returns the route for each of the given trips, in the
+    // same order: the vertex numbers along the shortest path under the
+    // trip's metric, from its start vertex to its end vertex.  A trip
+    // whose end vertex can't be reached gets an empty route.
+    virtual std::vector<std::vector<int>> findRoutes(const std::vector<Trip>& trips) = 0;
+};
+
+
+
+// makeTripRouter() returns a TripRouter for the given RoadMap using the
+// engine with the given name, or nullptr if there's no such engine.  The
+// RoadMap must outlive the TripRouter and not change while it's in use.
+// Engines whose preprocessing can be saved keep it in the file at
+// indexPath, if one is given.  The engines are:
+//
+// * "dijkstra": for each metric, targeted Dijkstra searches that stop once
+//   their trips' other ends are settled: forward from each distinct start
+//   vertex, or backward from each distinct end vertex when there are fewer
+//   of those (see DijkstraTripRouter)
+// * "overlay": queries on a multi-level overlay graph (see RoadMapOverlay)
+// * "phast": one PHAST tree per distinct start vertex and metric
+// * "hub": hub label lookups (see RoadMapHubLabels); saved to indexPath
+// * "quantized": one full Dijkstra search per distinct start vertex and
+//   metric, with integer weights and a radix heap
+// * "interleaved": one point-to-point search per trip, several at a time
+//   on one thread (see InterleavedTripRouter)
+// * "all-pairs": all-pairs matrix lookups (see AllPairsTripRouter); saved
+//   next to indexPath
+std::unique_ptr<TripRouter> makeTripRouter(
+    const std::string& engine, const RoadMap& roadMap, const std::string& indexPath = "");
+
+
+
+#endif
@@ -7,166 +7,169 @@
 // console user interface.
 
 
+#include "CompactDigraphAlgorithms.hpp"
+#include "DistanceTableReport.hpp"
 #include "InputReader.hpp"
 #include <iostream>
 #include "RoadMapReader.hpp"
+#include "SimplifiedRoadMap.hpp"
+#include "TimeFormat.hpp"
 #include "TripReader.hpp"
+#include "TripRouter.hpp"
 #include <iomanip>
+#include <memory>
 #include <sstream>
 
 
-// convertTime() converts seconds into its components - hours,
-// minutes, and seconds
-std::string convertTime(double& s)
+// printDistanceRoute() prints the given route for a trip whose metric is
+// TripMetric::Distance.
+void printDistanceRoute(const RoadMap& roadMap, const Trip& trip,
+    const std::vector<int>& route)
 {
-    std::string time = "";
-    if (s >= 3600)
+    std::cout << "Shortest distance from " 
+        << roadMap.vertexInfo(trip.startVertex) << " to " <<
+        roadMap.vertexInfo(trip.endVertex) << std::endl;
+    std::cout << "  Begin at " 
+        << roadMap.vertexInfo(trip.startVertex) << std::endl;
+    double totalDistance = 0.0;
+    for (std::size_t i = 1; i < route.size(); i++)
     {
-        int t = s;
-        int i = t / 3600;
-        if (i == 1)
+        double dis = roadMap.edgeInfo(route[i-1], route[i]).miles;
+        totalDistance += dis;
+        std::stringstream tmp;
+        tmp << std::setprecision(1) << std::fixed << dis;
+        dis = std::stod(tmp.str());
+        std::cout << "  Continue to " <<
+        roadMap.vertexInfo(route[i]) << " (" << dis<<" miles)"
+        << std::endl;
+    }
+    std::cout << "Total distance: "<< std::setprecision(1) << 
+        std::fixed << totalDistance<<" miles\n\n";
+}
+
+
+// printTimeRoute() prints the given route for a trip whose metric is
+// TripMetric::Time.
+void printTimeRoute(const RoadMap& roadMap, const Trip& trip,
+    const std::vector<int>& route)
+{
+    std::cout << "Shortest driving time from " 
+        << roadMap.vertexInfo(trip.startVertex) << " to " <<
+        roadMap.vertexInfo(trip.endVertex) << std::endl;
+    std::cout << "  Begin at " 
+        << roadMap.vertexInfo(trip.startVertex) << std::endl;
+    double totalTime = 0.0;
+    for (std::size_t i = 1; i < route.size(); i++)
+    {
+        double dis = roadMap.edgeInfo(route[i-1], route[i]).miles;
+        double mph = roadMap.edgeInfo(route[i-1], route[i]).milesPerHour;
+        double s = (dis/mph) * 3600;
+        totalTime += s;
+        std::string time = formatTime(s);
+        std::cout << "  Continue to " <<
+        roadMap.vertexInfo(route[i]) << " ("<< 
+        std::setprecision(1) << std::fixed << dis<<" miles @ "
+        << std::setprecision(1) << std::fixed << mph 
+        << "mph = "<<time << ")" << std::endl;
+    }
+    std::string time = formatTime(totalTime);
+    std::cout << "Total time: "<< time << "\n\n";
+}
+
+
+// The engine used to find routes can be chosen by running the program
+// with --engine=NAME, and engines that can save their preprocessing will
+// keep it in the file given by --index=PATH; see makeTripRouter().  Running
+// it with --distance-table writes distance tables between the trips' start
+// and end vertices instead of routes; see writeDistanceTables().  Tables
+// are always computed with a contraction hierarchy, so --engine and --index
+// can't be given with --distance-table, and table mode deliberately skips
+// the "Disconnected Map" check, since a table shows unreachable pairs as
+// "no route".  Running it with --simplify searches a SimplifiedRoadMap
+// instead of the whole map, which gives the same routes.
+int main(int argc, char* argv[])
+{
+    std::string engine = "dijkstra";
+    std::string indexPath = "";
+    bool routerOptionGiven = false;
+    bool distanceTables = false;
+    bool simplify = false;
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg.rfind("--engine=", 0) == 0)
         {
-            time += "1 hr ";
+            engine = arg.substr(9);
+            routerOptionGiven = true;
         }
-        else
+        else if (arg == "--distance-table")
         {
-            time += std::to_string(i);
-            time += " hrs ";
+            distanceTables = true;
         }
-        s = s - i * 3600;
-    }
-    if (s >= 60)
-    {
-        int t = s;
-        int i = t / 60;
-        if (i == 1)
+        else if (arg == "--simplify")
         {
-            time += "1 min ";
+            simplify = true;
+        }
+        else if (arg.rfind("--index=", 0) == 0)
+        {
+            indexPath = arg.substr(8);
+            routerOptionGiven = true;
         }
         else
         {
-            time += std::to_string(i);
-            time += " mins ";
+            std::cerr << "Unknown option: " << arg << std::endl;
+            return 1;
         }
-        s = s - i * 60;
     }
-    return time;
-}
-
 
-// sortPredocessors() takes the resulf of calling findShortestPaths() and
-// sorts the result into topological ordering.
-std::vector<int> sortPredocessors(Trip& trip, 
-    std::map<int, std::map<int, int>>& map)
-{
-    std::vector<int> order;
-    order.push_back(trip.endVertex);
-    int current = trip.endVertex;
-    int pred = map[trip.startVertex][trip.endVertex];
-    while (current != pred)
+    if (distanceTables && routerOptionGiven)
     {
-        order.push_back(pred);
-        current = pred;
-        pred = map[trip.startVertex][current];
+        std::cerr << "--engine and --index can't be used with --distance-table" << std::endl;
+        return 1;
     }
-    return order;
-}
-
 
-int main()
-{
     InputReader inputReader{std::cin};
     RoadMapReader roadMapReader;
     RoadMap roadMap = roadMapReader.readRoadMap(inputReader);
     TripReader tripReader;
     std::vector<Trip> trips = tripReader.readTrips(inputReader);
 
-    std::map<int, std::map<int, int>> shortPathMap;
-    std::map<int, std::map<int, int>> shortTimeMap;
-    if (roadMap.isStronglyConnected())
+    std::unique_ptr<SimplifiedRoadMap> simplified;
+    if (simplify)
+    {
+        simplified = std::make_unique<SimplifiedRoadMap>(roadMap, tripEndpoints(trips));
+    }
+    const RoadMap& searchMap = simplified ? simplified->roadMap() : roadMap;
+
+    if (distanceTables)
+    {
+        writeDistanceTables(std::cout, searchMap, trips);
+        return 0;
+    }
+
+    std::unique_ptr<TripRouter> router = makeTripRouter(engine, searchMap, indexPath);
+    if (router == nullptr)
     {
-        for (Trip& trip : trips)
+        std::cerr << "Unknown engine: " << engine << std::endl;
+        return 1;
+    }
+
+    if (isStronglyConnected(CompactDigraph{roadMap}))
+    {
+        std::vector<std::vector<int>> routes = router->findRoutes(trips);
+        for (std::size_t i = 0; i < trips.size(); i++)
         {
-            if (trip.metric == TripMetric::Distance)
+            if (simplified)
             {
-                // the shortest path starting from the given startVertex
-                // has not already been found
-                if (shortPathMap.find(trip.startVertex) == shortPathMap.end())
-                {
-                    shortPathMap[trip.startVertex] = 
-                        roadMap.findShortestPaths(trip.startVertex, 
-                        [](const RoadSegment& r){ return r.miles; });
-                }
-
-                std::cout << "Shortest distance from " 
-                    << roadMap.vertexInfo(trip.startVertex) << " to " <<
-                    roadMap.vertexInfo(trip.endVertex) << std::endl;
-                std::cout << "  Begin at " 
-                    << roadMap.vertexInfo(trip.startVertex) << std::endl;
-                double totalDistance = 0.0;
-                std::vector<int> order = sortPredocessors(trip, shortPathMap);
-                int fromVertex = trip.startVertex;
-                for (int i = order.size()-2; i >= 0; i--)
-                {
-                    int toVertex = order[i];
-                    double dis = roadMap.edgeInfo(fromVertex, toVertex).miles;
-                    totalDistance += dis;
-                    std::stringstream tmp;
-                    tmp << std::setprecision(1) << std::fixed << dis;
-                    dis = std::stod(tmp.str());
-                    std::cout << "  Continue to " <<
-                    roadMap.vertexInfo(order[i]) << " (" << dis<<" miles)"
-                    << std::endl;
-                    fromVertex = toVertex;
-                }
-                std::cout << "Total distance: "<< std::setprecision(1) << 
-                    std::fixed << totalDistance<<" miles\n\n";
-                
+                routes[i] = simplified->expandRoute(routes[i]);
             }
-            else if (trip.metric == TripMetric::Time)
+            if (trips[i].metric == TripMetric::Distance)
             {
-                // the shortest path starting from the given startVertex
-                // has not already been found
-                if (shortTimeMap.find(trip.startVertex) == shortTimeMap.end())
-                {
-                    shortTimeMap[trip.startVertex] = 
-                        roadMap.findShortestPaths(trip.startVertex, 
-                        [](const RoadSegment& r)
-                        { return (r.miles/r.milesPerHour);});
-                }
-
-                std::cout << "Shortest driving time from " 
-                    << roadMap.vertexInfo(trip.startVertex) << " to " <<
-                    roadMap.vertexInfo(trip.endVertex) << std::endl;
-                std::cout << "  Begin at " 
-                    << roadMap.vertexInfo(trip.startVertex) << std::endl;
-                double totalTime = 0.0;
-                std::vector<int> order = sortPredocessors(trip, shortTimeMap);
-                int fromVertex = trip.startVertex;
-                for (int i = order.size()-2; i >= 0; i--)
-                {
-                    int toVertex = order[i];
-                    double dis = roadMap.edgeInfo(fromVertex, toVertex).miles;
-                    double mph = roadMap.edgeInfo(fromVertex, 
-                        toVertex).milesPerHour;
-                    double s = (dis/mph) * 3600;
-                    totalTime += s;
-                    std::string time = convertTime(s);
-                    std::stringstream tmp;
-                    tmp << std::setprecision(1) << std::fixed << s;
-                    time += tmp.str() + " secs";
-                    std::cout << "  Continue to " <<
-                    roadMap.vertexInfo(order[i]) << " ("<< 
-                    std::setprecision(1) << std::fixed << dis<<" miles @ "
-                    << std::setprecision(1) << std::fixed << mph 
-                    << "mph = "<<time << ")" << std::endl;
-                    fromVertex = toVertex;
-                }
-                std::string time = convertTime(totalTime);
-                std::stringstream tmp;
-                tmp << std::setprecision(1) << std::fixed << totalTime;
-                time += tmp.str() + " secs";
-                std::cout << "Total time: "<< time << "\n\n";
+                printDistanceRoute(roadMap, trips[i], routes[i]);
+            }
+            else if (trips[i].metric == TripMetric::Time)
+            {
+                printTimeRoute(roadMap, trips[i], routes[i]);
             }
         }
     }
@@ -177,4 +180,3 @@ int main()
 
     return 0;
 }
-
@@ -0,0 +1,593 @@
+// AllPairs.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called AllPairsMatrix, which holds the
+// shortest distance from every vertex of a graph to every other, along with
+// the "next hop" -- the second vertex on a shortest path -- for every pair,
+// so that any shortest path can be read out one table lookup per vertex.
+//
+// A graph with n vertices needs n * n entries in each table, so this is only
+// sensible for graphs of up to a few tens of thousands of vertices; the
+// entries are kept small (a float distance and a 32-bit next hop, eight bytes
+// per pair) for that reason.  There are two ways to fill the tables in:
+//
+// * Floyd-Warshall, which takes n^3 steps no matter how many arcs there are,
+//   but whose steps are so simple that they run many at a time as SIMD
+//   instructions.  The matrix is processed in square blocks small enough to
+//   stay in cache, in the usual three phases per block of intermediate
+//   vertices (the diagonal block, then the blocks in its row and column,
+//   then all the rest), and the blocks in each phase after the first are
+//   independent of each other, so they're split across threads.
+//
+// * One Dijkstra search from every vertex, split across threads, which
+//   takes roughly n * (n + m) log n steps for a graph with m arcs.
+//
+// Which is faster depends on how dense the graph is, so by default it's
+// chosen by chooseAllPairsMethod().
+//
+// The tables can be saved to a file and later mapped straight into memory
+// with mmap(), so loading them takes no time at all and pages are only read
+// from disk as they're used.  The file records a caller-chosen fingerprint,
+// so a file built from a different graph is never used by mistake.
+
+#ifndef ALLPAIRS_HPP
+#define ALLPAIRS_HPP
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ArcRelaxation.hpp"
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "ParallelFor.hpp"
+
+
+
+enum class AllPairsMethod
+{
+    Automatic,
+    FloydWarshall,
+    Dijkstra
+};
+
+
+
+// chooseAllPairsMethod() returns the method expected to fill in the tables
+// faster for a graph with the given number of vertices and arcs.
+AllPairsMethod chooseAllPairsMethod(int vertexCount, int arcCount) noexcept;
+
+
+
+class AllPairsMatrix
+{
+public:
+    // This constructor computes the tables for the given graph with the
+    // given arc weights (indexed by arc number), using the given method and
+    // up to threadCount threads.  If a weight is negative or NaN, or the
+    // number of weights is wrong, a DigraphException is thrown.
+    AllPairsMatrix(
+        const CompactDigraph& graph, const std::vector<double>& arcWeights,
+        AllPairsMethod method = AllPairsMethod::Automatic,
+        int threadCount = defaultThreadCount());
+
+    // map() maps the tables saved in the file with the given path into
+    // memory.  If the file can't be mapped, doesn't contain tables, or was
+    // saved with a different fingerprint, a DigraphException is thrown.
+    static AllPairsMatrix map(const std::string& path, std::uint64_t fingerprint = 0);
+
+    // An AllPairsMatrix may point into its own tables, so it can be moved
+    // but not copied.
+    AllPairsMatrix(AllPairsMatrix&&) noexcept = default;
+    AllPairsMatrix& operator=(AllPairsMatrix&&) noexcept = default;
+
+    // save() writes the tables, along with the given fingerprint, to the
+    // file with the given path.  If the file can't be written, a
+    // DigraphException is thrown.
+    void save(const std::string& path, std::uint64_t fingerprint = 0) const;
+
+    // vertexCount() returns the number of vertices in the graph.
+    int vertexCount() const noexcept;
+
+    // distance() returns the shortest distance between the two vertices
+    // with the given vertex numbers, which is infinite if there's no path.
+    // If either vertex does not exist, a DigraphException is thrown.
+    double distance(int startVertex, int endVertex) const;
+
+    // shortestPath() returns a shortest path between the two vertices with
+    // the given vertex numbers, with no vertices if there's no path.  If
+    // either vertex does not exist, a DigraphException is thrown.
+    DigraphPath shortestPath(int startVertex, int endVertex) const;
+
+
+private:
+    AllPairsMatrix() = default;
+
+    // The file (and mapping) begins with this header, followed by the
+    // vertex numbers, then the distances, then the next hops.
+    struct Header
+    {
+        char magic[8];
+        std::uint32_t vertexCount;
+        std::uint32_t reserved;
+        std::uint64_t fingerprint;
+    };
+
+    struct Mapping
+    {
+        void* address;
+        std::size_t size;
+
+        ~Mapping();
+    };
+
+    // When the tables were computed, they're owned here; when they were
+    // mapped from a file, the mapping is.  Either way, the pointers below
+    // point into them (moving a vector leaves its elements where they are).
+    std::vector<std::int32_t> ownedVertexNumbers_;
+    std::vector<float> ownedDistances_;
+    std::vector<std::int32_t> ownedNextHops_;
+    std::unique_ptr<Mapping> mapping_;
+
+    int vertexCount_ = 0;
+    const std::int32_t* vertexNumbers_ = nullptr;
+    const float* distances_ = nullptr;
+    const std::int32_t* nextHops_ = nullptr;
+    std::unordered_map<int, int> indices_;
+
+    void fillIndices();
+    int index(int vertexNumber, const char* operation) const;
+    std::size_t entry(int from, int to) const noexcept;
+};
+
+
+
+namespace AllPairsDetails
+{
+    constexpr char magic[8] = {'A', 'L', 'L', 'P', 'A', 'I', 'R', '1'};
+
+    // blockSize is the width of the square blocks Floyd-Warshall works on;
+    // a block of distances and one of next hops take 32KB together.
+    constexpr int blockSize = 64;
+
+
+    // relaxBlock() improves the block of rows [rowBegin, rowEnd) and columns
+    // [columnBegin, columnEnd) through the intermediate vertices in
+    // [kBegin, kEnd).  The innermost loop has no branches, so it can be
+    // vectorized.
+    inline void relaxBlock(
+        float* dist, std::int32_t* next, int n,
+        int rowBegin, int rowEnd, int columnBegin, int columnEnd, int kBegin, int kEnd)
+    {
+        for (int k = kBegin; k < kEnd; ++k)
+        {
+            const float* throughRow = dist + static_cast<std::size_t>(k) * n;
+
+            for (int i = rowBegin; i < rowEnd; ++i)
+            {
+                float* distRow = dist + static_cast<std::size_t>(i) * n;
+                std::int32_t* nextRow = next + static_cast<std::size_t>(i) * n;
+                float toK = distRow[k];
+                std::int32_t hop = nextRow[k];
+
+                if (toK == std::numeric_limits<float>::infinity())
+                {
+                    continue;
+                }
+
+                for (int j = columnBegin; j < columnEnd; ++j)
+                {
+                    float candidate = toK + throughRow[j];
+                    bool better = candidate < distRow[j];
+                    distRow[j] = better ? candidate : distRow[j];
+                    nextRow[j] = better ? hop : nextRow[j];
+                }
+            }
+        }
+    }
+
+
+    inline void floydWarshall(
+        float* dist, std::int32_t* next, int n, int threadCount)
+    {
+        int blocks = (n + blockSize - 1) / blockSize;
+
+        auto blockBegin = [](int b) { return b * blockSize; };
+        auto blockEnd = [n](int b) { return std::min(n, (b + 1) * blockSize); };
+
+        for (int kb = 0; kb < blocks; ++kb)
+        {
+            int kBegin = blockBegin(kb);
+            int kEnd = blockEnd(kb);
+
+            relaxBlock(dist, next, n, kBegin, kEnd, kBegin, kEnd, kBegin, kEnd);
+
+            // The blocks in row kb and column kb depend only on themselves
+            // and the diagonal block.
+            parallelFor(0, 2 * blocks, threadCount,
+                [&](int task)
+                {
+                    int b = task / 2;
+
+                    if (b == kb)
+                    {
+                        return;
+                    }
+                    else if (task % 2 == 0)
+                    {
+                        relaxBlock(dist, next, n, kBegin, kEnd, blockBegin(b), blockEnd(b), kBegin, kEnd);
+                    }
+                    else
+                    {
+                        relaxBlock(dist, next, n, blockBegin(b), blockEnd(b), kBegin, kEnd, kBegin, kEnd);
+                    }
+                });
+
+            // Every other block depends only on itself and the blocks in
+            // its row and column from the previous phase.
+            parallelFor(0, blocks * blocks, threadCount,
+                [&](int task)
+                {
+                    int ib = task / blocks;
+                    int jb = task % blocks;
+
+                    if (ib != kb && jb != kb)
+                    {
+                        relaxBlock(
+                            dist, next, n, blockBegin(ib), blockEnd(ib),
+                            blockBegin(jb), blockEnd(jb), kBegin, kEnd);
+                    }
+                });
+        }
+    }
+
+
+    // dijkstraRow() fills in the row of distances and next hops for one
+    // start vertex; dist, settled, and predecessor are scratch space.
+    inline void dijkstraRow(
+        const CompactDigraph& graph, const std::vector<double>& arcWeights, int start,
+        float* distRow, std::int32_t* nextRow,
+        std::vector<double>& dist, std::vector<int>& settled, std::vector<int>& predecessor)
+    {
+        int n = graph.vertexCount();
+        constexpr double infinity = std::numeric_limits<double>::infinity();
+
+        using Entry = std::pair<double, int>;
+        std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+        dist.assign(n, infinity);
+        predecessor.assign(n, -1);
+        settled.clear();
+
+        dist[start] = 0.0;
+        queue.push({0.0, start});
+
+        while (!queue.empty())
+        {
+            auto [d, v] = queue.top();
+            queue.pop();
+
+            if (d > dist[v])
+            {
+                continue;
+            }
+
+            settled.push_back(v);
+
+            int first = graph.arcBegin(v);
+
+            relaxArcs(
+                graph.arcHeads() + first, arcWeights.data() + first, graph.arcEnd(v) - first, d,
+                dist.data(),
+                [&](int i, double candidate)
+                {
+                    int w = graph.arcHead(first + i);
+                    predecessor[w] = v;
+                    queue.push({candidate, w});
+                });
+        }
+
+        std::fill(distRow, distRow + n, std::numeric_limits<float>::infinity());
+        std::fill(nextRow, nextRow + n, -1);
+
+        // Vertices are settled after their predecessors, so each one's next
+        // hop is already known by the time it's needed.
+        for (int v : settled)
+        {
+            distRow[v] = static_cast<float>(dist[v]);
+
+            if (v != start)
+            {
+                nextRow[v] = predecessor[v] == start ? v : nextRow[predecessor[v]];
+            }
+        }
+    }
+}
+
+
+
+inline AllPairsMethod chooseAllPairsMethod(int vertexCount, int arcCount) noexcept
+{
+    // Floyd-Warshall does n^3 steps and the searches about n * (n + m) log n,
+    // but with several of Floyd-Warshall's done at once by SIMD instructions,
+    // and the searches' slowed by the heap and scattered memory accesses,
+    // each of the searches' steps costs roughly sixteen of Floyd-Warshall's.
+    double n = vertexCount;
+    double floyd = n * n * n / 16.0;
+    double dijkstra = n * (n + arcCount) * std::log2(n + 1.0);
+
+    return floyd <= dijkstra ? AllPairsMethod::FloydWarshall : AllPairsMethod::Dijkstra;
+}
+
+
+inline AllPairsMatrix::AllPairsMatrix(
+    const CompactDigraph& graph, const std::vector<double>& arcWeights,
+    AllPairsMethod method, int threadCount)
+{
+    using namespace AllPairsDetails;
+
+    int n = graph.vertexCount();
+
+    if (static_cast<int>(arcWeights.size()) != graph.arcCount())
+    {
+        throw DigraphException{"AllPairsMatrix: there must be one weight per arc."};
+    }
+
+    for (double weight : arcWeights)
+    {
+        if (!(weight >= 0.0))
+        {
+            throw DigraphException{"AllPairsMatrix: weights can't be negative."};
+        }
+    }
+
+    if (method == AllPairsMethod::Automatic)
+    {
+        method = chooseAllPairsMethod(n, graph.arcCount());
+    }
+
+    std::size_t entries = static_cast<std::size_t>(n) * n;
+
+    for (int v = 0; v < n; ++v)
+    {
+        ownedVertexNumbers_.push_back(graph.vertexNumber(v));
+    }
+
+    if (method == AllPairsMethod::FloydWarshall)
+    {
+        ownedDistances_.assign(entries, std::numeric_limits<float>::infinity());
+        ownedNextHops_.assign(entries, -1);
+
+        for (int v = 0; v < n; ++v)
+        {
+            ownedDistances_[static_cast<std::size_t>(v) * n + v] = 0.0f;
+
+            for (int arc = graph.arcBegin(v); arc < graph.arcEnd(v); ++arc)
+            {
+                std::size_t e = static_cast<std::size_t>(v) * n + graph.arcHead(arc);
+                float weight = static_cast<float>(arcWeights[arc]);
+
+                if (weight < ownedDistances_[e])
+                {
+                    ownedDistances_[e] = weight;
+                    ownedNextHops_[e] = graph.arcHead(arc);
+                }
+            }
+        }
+
+        floydWarshall(ownedDistances_.data(), ownedNextHops_.data(), n, threadCount);
+    }
+    else
+    {
+        ownedDistances_.resize(entries);
+        ownedNextHops_.resize(entries);
+
+        parallelForChunks(0, n, threadCount,
+            [&](int begin, int end, int)
+            {
+                std::vector<double> dist;
+                std::vector<int> settled;
+                std::vector<int> predecessor;
+
+                for (int s = begin; s < end; ++s)
+                {
+                    std::size_t row = static_cast<std::size_t>(s) * n;
+
+                    dijkstraRow(
+                        graph, arcWeights, s, ownedDistances_.data() + row,
+                        ownedNextHops_.data() + row, dist, settled, predecessor);
+                }
+            });
+    }
+
+    vertexCount_ = n;
+    vertexNumbers_ = ownedVertexNumbers_.data();
+    distances_ = ownedDistances_.data();
+    nextHops_ = ownedNextHops_.data();
+    fillIndices();
+}
+
+
+inline AllPairsMatrix AllPairsMatrix::map(const std::string& path, std::uint64_t fingerprint)
+{
+    using namespace AllPairsDetails;
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd == -1)
+    {
+        throw DigraphException{"AllPairsMatrix map(): can't open " + path};
+    }
+
+    struct stat status;
+    void* address = MAP_FAILED;
+
+    if (::fstat(fd, &status) == 0 && status.st_size >= static_cast<off_t>(sizeof(Header)))
+    {
+        address = ::mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    }
+
+    ::close(fd);
+
+    if (address == MAP_FAILED)
+    {
+        throw DigraphException{"AllPairsMatrix map(): " + path + " doesn't contain tables."};
+    }
+
+    AllPairsMatrix matrix;
+    matrix.mapping_.reset(new Mapping{address, static_cast<std::size_t>(status.st_size)});
+
+    Header header;
+    std::memcpy(&header, address, sizeof(header));
+
+    std::size_t n = header.vertexCount;
+    std::size_t expectedSize =
+        sizeof(Header) + n * sizeof(std::int32_t)
+        + n * n * (sizeof(float) + sizeof(std::int32_t));
+
+    if (std::memcmp(header.magic, magic, sizeof(magic)) != 0
+        || n > static_cast<std::size_t>(std::numeric_limits<int>::max())
+        || matrix.mapping_->size != expectedSize)
+    {
+        throw DigraphException{"AllPairsMatrix map(): " + path + " doesn't contain tables."};
+    }
+
+    if (header.fingerprint != fingerprint)
+    {
+        throw DigraphException{"AllPairsMatrix map(): " + path + " was built from a different graph."};
+    }
+
+    const char* bytes = static_cast<const char*>(address);
+
+    matrix.vertexCount_ = n;
+    matrix.vertexNumbers_ = reinterpret_cast<const std::int32_t*>(bytes + sizeof(Header));
+    matrix.distances_ = reinterpret_cast<const float*>(matrix.vertexNumbers_ + n);
+    matrix.nextHops_ = reinterpret_cast<const std::int32_t*>(matrix.distances_ + n * n);
+    matrix.fillIndices();
+
+    return matrix;
+}
+
+
+inline void AllPairsMatrix::save(const std::string& path, std::uint64_t fingerprint) const
+{
+    using namespace AllPairsDetails;
+
+    Header header{};
+    std::memcpy(header.magic, magic, sizeof(magic));
+    header.vertexCount = vertexCount_;
+    header.fingerprint = fingerprint;
+
+    std::size_t n = vertexCount_;
+    std::ofstream out{path, std::ios::binary};
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(vertexNumbers_), n * sizeof(std::int32_t));
+    out.write(reinterpret_cast<const char*>(distances_), n * n * sizeof(float));
+    out.write(reinterpret_cast<const char*>(nextHops_), n * n * sizeof(std::int32_t));
+
+    if (!out)
+    {
+        throw DigraphException{"AllPairsMatrix save(): can't write " + path};
+    }
+}
+
+
+inline int AllPairsMatrix::vertexCount() const noexcept
+{
+    return vertexCount_;
+}
+
+
+inline double AllPairsMatrix::distance(int startVertex, int endVertex) const
+{
+    return distances_[entry(index(startVertex, "distance"), index(endVertex, "distance"))];
+}
+
+
+inline DigraphPath AllPairsMatrix::shortestPath(int startVertex, int endVertex) const
+{
+    int s = index(startVertex, "shortestPath");
+    int t = index(endVertex, "shortestPath");
+
+    DigraphPath path{distances_[entry(s, t)], {}};
+
+    if (path.length == std::numeric_limits<double>::infinity())
+    {
+        return path;
+    }
+
+    path.vertices.push_back(vertexNumbers_[s]);
+
+    for (int v = s; v != t; )
+    {
+        v = nextHops_[entry(v, t)];
+
+        // Only a damaged file could send the path around in circles.
+        if (v < 0 || v >= vertexCount_ || static_cast<int>(path.vertices.size()) > vertexCount_)
+        {
+            throw DigraphException{"AllPairsMatrix shortestPath(): the tables are corrupt."};
+        }
+
+        path.vertices.push_back(vertexNumbers_[v]);
+    }
+
+    return path;
+}
+
+
+inline AllPairsMatrix::Mapping::~Mapping()
+{
+    ::munmap(address, size);
+}
+
+
+inline void AllPairsMatrix::fillIndices()
+{
+    indices_.clear();
+
+    for (int v = 0; v < vertexCount_; ++v)
+    {
+        indices_.emplace(vertexNumbers_[v], v);
+    }
+}
+
+
+inline int AllPairsMatrix::index(int vertexNumber, const char* operation) const
+{
+    auto found = indices_.find(vertexNumber);
+
+    if (found == indices_.end())
+    {
+        throw DigraphException{
+            std::string{"AllPairsMatrix "} + operation + "(): vertex number "
+            + std::to_string(vertexNumber) + " does not exist."};
+    }
+
+    return found->second;
+}
+
+
+inline std::size_t AllPairsMatrix::entry(int from, int to) const noexcept
+{
+    return static_cast<std::size_t>(from) * vertexCount_ + to;
+}
+
+
+
+#endif
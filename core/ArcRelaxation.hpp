@@ -0,0 +1,92 @@
+// ArcRelaxation.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares relaxArcs(), the inner loop of Dijkstra's
+// algorithm and its relatives: given a vertex that has just been settled,
+// it checks whether going through that vertex shortens the distance to
+// each of the heads of its outgoing arcs.
+//
+// The arcs are given as two separate arrays, one of heads and one of
+// weights, which is how a CompactDigraph and the structures built on it
+// already store them.  When the compiler is allowed to use AVX2 (for
+// example, with -mavx2 or -march=native), four arcs are checked at once:
+// their candidate distances are computed in one vector addition and
+// compared against the current distances of their heads, fetched with a
+// single gather.  Only the arcs that actually improve a distance are then
+// handled one at a time.  Most arcs don't, so this pays off most for
+// vertices with many arcs, like freeway interchanges and overlay cliques.
+// Without AVX2, the same arcs are checked one at a time, with exactly the
+// same results.
+
+#ifndef ARCRELAXATION_HPP
+#define ARCRELAXATION_HPP
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+
+
+// relaxArcs() relaxes "count" arcs leaving a vertex whose distance is
+// "base": the i-th arc points to the vertex heads[i] and has weight
+// weights[i].  Whenever base + weights[i] is less than distances[heads[i]],
+// that distance is lowered to it and improved(i, base + weights[i]) is
+// called.  Arcs are relaxed in increasing order of i.
+template <typename Improved>
+void relaxArcs(
+    const int* heads, const double* weights, int count, double base,
+    double* distances, Improved improved);
+
+
+
+template <typename Improved>
+void relaxArcs(
+    const int* heads, const double* weights, int count, double base,
+    double* distances, Improved improved)
+{
+    auto relaxOne = [&](int i)
+        {
+            double candidate = base + weights[i];
+
+            if (candidate < distances[heads[i]])
+            {
+                distances[heads[i]] = candidate;
+                improved(i, candidate);
+            }
+        };
+
+    int i = 0;
+
+#if defined(__AVX2__)
+    __m256d baseVector = _mm256_set1_pd(base);
+    __m256d allLanes = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+
+    for (; i + 4 <= count; i += 4)
+    {
+        __m128i headVector = _mm_loadu_si128(reinterpret_cast<const __m128i*>(heads + i));
+        __m256d candidates = _mm256_add_pd(baseVector, _mm256_loadu_pd(weights + i));
+        __m256d current = _mm256_mask_i32gather_pd(
+            _mm256_setzero_pd(), distances, headVector, allLanes, 8);
+        int improvedLanes = _mm256_movemask_pd(_mm256_cmp_pd(candidates, current, _CMP_LT_OQ));
+
+        // Each improvement is checked again one at a time, in case an
+        // earlier arc in the same group already lowered the distance.
+        while (improvedLanes != 0)
+        {
+            relaxOne(i + __builtin_ctz(improvedLanes));
+            improvedLanes &= improvedLanes - 1;
+        }
+    }
+#endif
+
+    for (; i < count; ++i)
+    {
+        relaxOne(i);
+    }
+}
+
+
+
+#endif
@@ -0,0 +1,252 @@
+// ArenaAllocator.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called Arena, which hands out memory
+// from large blocks by bumping a pointer, and a class template called
+// ArenaAllocator, a standard allocator that gets its memory from an Arena.
+//
+// A Digraph allocates a map node for every vertex and a list node for every
+// edge, so building a large one makes millions of tiny allocations, and
+// destroying it frees them again one at a time.  A Digraph whose Allocator
+// is an ArenaAllocator instead carves all of those nodes out of a handful of
+// big blocks; freeing a node does nothing, and the memory is given back all
+// at once when the Arena is released or destroyed.  For example:
+//
+//     Arena arena;
+//     Digraph<std::string, double, ArenaAllocator<char>> d{arena};
+//
+// The Arena must outlive everything that allocates from it.  Since freed
+// memory isn't reused until the whole Arena is released, an Arena is best
+// for graphs that are built once and then mostly read, not ones that have
+// many vertices and edges removed and added over their lifetime.
+
+#ifndef ARENAALLOCATOR_HPP
+#define ARENAALLOCATOR_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+#include "Digraph.hpp"
+
+
+
+class Arena
+{
+public:
+    // This constructor initializes an empty Arena that gets memory from the
+    // system in blocks of (at least) the given number of bytes.
+    explicit Arena(std::size_t blockSize = std::size_t{1} << 20);
+
+    // The destructor gives all of the Arena's memory back to the system.
+    ~Arena() noexcept;
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    // allocate() returns the given number of bytes with the given
+    // alignment, which must be a power of two.
+    void* allocate(std::size_t bytes, std::size_t alignment);
+
+    // release() gives all of the Arena's memory back to the system at once.
+    // Nothing allocated from it can be used afterward.
+    void release() noexcept;
+
+    // bytesAllocated() returns the number of bytes handed out since the
+    // Arena was created or last released, not counting alignment padding.
+    std::size_t bytesAllocated() const noexcept;
+
+
+private:
+    std::size_t blockSize_;
+    std::vector<char*> blocks_;
+    char* next_;
+    char* end_;
+    std::size_t bytesAllocated_;
+};
+
+
+
+template <typename T>
+class ArenaAllocator
+{
+public:
+    using value_type = T;
+
+    // Moving, copying, or swapping a container takes its allocator along,
+    // so that it keeps freeing memory into the Arena it came from.
+    using propagate_on_container_copy_assignment = std::true_type;
+    using propagate_on_container_move_assignment = std::true_type;
+    using propagate_on_container_swap = std::true_type;
+
+    // The default constructor makes an ArenaAllocator with no Arena, which
+    // gets its memory from the system the usual way.
+    ArenaAllocator() noexcept;
+
+    // This constructor makes an ArenaAllocator that gets its memory from
+    // the given Arena.
+    ArenaAllocator(Arena& arena) noexcept;
+
+    // This constructor rebinds an ArenaAllocator for one type to another,
+    // sharing the same Arena.
+    template <typename U>
+    ArenaAllocator(const ArenaAllocator<U>& other) noexcept;
+
+    T* allocate(std::size_t n);
+    void deallocate(T* p, std::size_t n) noexcept;
+
+    // arena() returns the Arena this allocator gets its memory from, or
+    // nullptr if it gets it from the system.
+    Arena* arena() const noexcept;
+
+
+private:
+    Arena* arena_;
+};
+
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept;
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept;
+
+
+
+inline Arena::Arena(std::size_t blockSize)
+    : blockSize_{blockSize}, next_{nullptr}, end_{nullptr}, bytesAllocated_{0}
+{
+}
+
+
+inline Arena::~Arena() noexcept
+{
+    release();
+}
+
+
+inline void* Arena::allocate(std::size_t bytes, std::size_t alignment)
+{
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+    {
+        throw DigraphException{"Arena allocate(): the alignment must be a power of two."};
+    }
+
+    std::uintptr_t address = reinterpret_cast<std::uintptr_t>(next_);
+    std::uintptr_t aligned = (address + alignment - 1) & ~(alignment - 1);
+
+    if (next_ == nullptr || aligned + bytes > reinterpret_cast<std::uintptr_t>(end_))
+    {
+        // Requests too big for a normal block get a block of their own,
+        // with room to align them.
+        std::size_t size = std::max(blockSize_, bytes + alignment);
+        char* block = static_cast<char*>(::operator new(size));
+
+        blocks_.push_back(block);
+        next_ = block;
+        end_ = block + size;
+
+        address = reinterpret_cast<std::uintptr_t>(next_);
+        aligned = (address + alignment - 1) & ~(alignment - 1);
+    }
+
+    next_ += (aligned - address) + bytes;
+    bytesAllocated_ += bytes;
+
+    return reinterpret_cast<void*>(aligned);
+}
+
+
+inline void Arena::release() noexcept
+{
+    for (char* block : blocks_)
+    {
+        ::operator delete(block);
+    }
+
+    blocks_.clear();
+    next_ = nullptr;
+    end_ = nullptr;
+    bytesAllocated_ = 0;
+}
+
+
+inline std::size_t Arena::bytesAllocated() const noexcept
+{
+    return bytesAllocated_;
+}
+
+
+
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator() noexcept
+    : arena_{nullptr}
+{
+}
+
+
+template <typename T>
+ArenaAllocator<T>::ArenaAllocator(Arena& arena) noexcept
+    : arena_{&arena}
+{
+}
+
+
+template <typename T>
+template <typename U>
+ArenaAllocator<T>::ArenaAllocator(const ArenaAllocator<U>& other) noexcept
+    : arena_{other.arena()}
+{
+}
+
+
+template <typename T>
+T* ArenaAllocator<T>::allocate(std::size_t n)
+{
+    if (arena_ == nullptr)
+    {
+        return std::allocator<T>{}.allocate(n);
+    }
+
+    return static_cast<T*>(arena_->allocate(n * sizeof(T), alignof(T)));
+}
+
+
+template <typename T>
+void ArenaAllocator<T>::deallocate(T* p, std::size_t n) noexcept
+{
+    if (arena_ == nullptr)
+    {
+        std::allocator<T>{}.deallocate(p, n);
+    }
+}
+
+
+template <typename T>
+Arena* ArenaAllocator<T>::arena() const noexcept
+{
+    return arena_;
+}
+
+
+template <typename T, typename U>
+bool operator==(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+    return a.arena() == b.arena();
+}
+
+
+template <typename T, typename U>
+bool operator!=(const ArenaAllocator<T>& a, const ArenaAllocator<U>& b) noexcept
+{
+    return !(a == b);
+}
+
+
+
+#endif
@@ -0,0 +1,576 @@
+// CompactDigraph.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called CompactDigraph, which is a
+// read-only snapshot of the structure of a Digraph laid out in
+// compressed sparse row ("CSR") form.  Vertices are renumbered with
+// consecutive indices starting at zero, and the outgoing arcs of each
+// vertex are stored next to each other in flat arrays, which is the
+// layout that all of the preprocessing and acceleration code needs.
+//
+// A CompactDigraph only stores structure; it doesn't store edge weights.
+// Each arc is numbered, so weights (or anything else per edge) live in a
+// separate std::vector indexed by arc number.  That's what allows the same
+// CompactDigraph to be reused with more than one metric.
+//
+// Vertex numbers from the original Digraph are only used at the edges of
+// an API; internally, everything is in terms of indices, and index() and
+// vertexNumber() translate between the two.
+//
+// By default, indices follow vertex numbers, which in a RoadMap follow the
+// order of the input file and so have nothing to do with where vertices
+// are.  A search then jumps all over memory as it moves from a vertex to
+// its neighbors.  Indexing vertices in reverse Cuthill-McKee order instead
+// (a breadth-first order that gives each vertex's neighbors nearby
+// indices) keeps the data a search touches close together, so far fewer
+// of its memory accesses miss the cache.
+
+#ifndef COMPACTDIGRAPH_HPP
+#define COMPACTDIGRAPH_HPP
+
+#include <algorithm>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "Digraph.hpp"
+
+
+
+// A VertexOrder determines how a CompactDigraph indexes vertices:
+// in increasing order of their vertex numbers, or in reverse
+// Cuthill-McKee order.
+enum class VertexOrder
+{
+    VertexNumber,
+    CuthillMcKee
+};
+
+
+
+class CompactDigraph
+{
+public:
+    // The default constructor initializes an empty CompactDigraph.
+    CompactDigraph();
+
+    // This constructor takes a snapshot of the structure of the given
+    // Digraph.  Vertices are indexed in the given order, and the arcs
+    // leaving each vertex keep the order in which the Digraph stores them.
+    template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+    explicit CompactDigraph(
+        const Digraph<VertexInfo, EdgeInfo, Allocator>& d, VertexOrder order = VertexOrder::VertexNumber);
+
+    // vertexCount() returns the number of vertices.
+    int vertexCount() const noexcept;
+
+    // arcCount() returns the number of arcs (directed edges).
+    int arcCount() const noexcept;
+
+    // index() returns the index of the vertex with the given vertex
+    // number.  If there is no such vertex, a DigraphException is thrown.
+    int index(int vertexNumber) const;
+
+    // vertexNumber() returns the original vertex number of the vertex
+    // with the given index.
+    int vertexNumber(int index) const noexcept;
+
+    // The arcs leaving the vertex with index v are numbered from
+    // arcBegin(v) up to, but not including, arcEnd(v).
+    int arcBegin(int v) const noexcept;
+    int arcEnd(int v) const noexcept;
+
+    // arcHead() and arcTail() return the index of the vertex an arc
+    // points to and the index of the vertex it leaves, respectively.
+    int arcHead(int arc) const noexcept;
+    int arcTail(int arc) const noexcept;
+
+    // arcHeads() returns the heads of all of the arcs as one array,
+    // indexed by arc number, for loops that work on many arcs at once.
+    const int* arcHeads() const noexcept;
+
+    // The arcs entering the vertex with index v are listed in positions
+    // reverseArcBegin(v) up to, but not including, reverseArcEnd(v);
+    // reverseArc() turns a position into the arc's number.
+    int reverseArcBegin(int v) const noexcept;
+    int reverseArcEnd(int v) const noexcept;
+    int reverseArc(int position) const noexcept;
+
+    // findArc() returns the number of the arc from the vertex with index
+    // "tail" to the one with index "head", or -1 if there isn't one.
+    int findArc(int tail, int head) const noexcept;
+
+    // arcInfos() returns the EdgeInfo of every arc, indexed by arc number,
+    // taken from the given Digraph.  It must be the Digraph this
+    // CompactDigraph was built from, unchanged since then.
+    template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+    std::vector<EdgeInfo> arcInfos(const Digraph<VertexInfo, EdgeInfo, Allocator>& d) const;
+
+    // arcWeights() is like arcInfos(), except that it returns the weight
+    // of each arc as determined by the given function.
+    template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+    std::vector<double> arcWeights(
+        const Digraph<VertexInfo, EdgeInfo, Allocator>& d,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+
+private:
+    std::vector<int> vertexNumbers_;
+    std::unordered_map<int, int> indices_;
+    std::vector<int> firstArc_;
+    std::vector<int> heads_;
+    std::vector<int> tails_;
+    std::vector<int> firstReverseArc_;
+    std::vector<int> reverseArcs_;
+
+    // buildReverseArcs() fills in the reverse arc lists from the forward ones.
+    void buildReverseArcs();
+
+    // cuthillMcKeeOrder() returns the indices of the vertices in reverse
+    // Cuthill-McKee order, treating arcs as undirected edges.
+    std::vector<int> cuthillMcKeeOrder() const;
+
+    // reorder() renumbers the vertices so that the vertex at position i
+    // of the given order gets index i, rebuilding the arcs to match.
+    void reorder(const std::vector<int>& order);
+};
+
+
+
+// A SingleSourcePaths holds the result of a one-to-all search on a
+// CompactDigraph, indexed by vertex index: the shortest distance to each
+// vertex (infinity if it can't be reached) and the index of its
+// predecessor on a shortest path (-1 for the start vertex and unreachable
+// vertices).
+struct SingleSourcePaths
+{
+    std::vector<double> distances;
+    std::vector<int> predecessors;
+};
+
+
+// predecessorPath() follows the given predecessors (indexed by vertex
+// index, as in a SingleSourcePaths) back from the given end vertex number,
+// returning the vertex numbers along the path to it from the given start
+// vertex number.  If the end vertex can't be reached, the path is empty.
+std::vector<int> predecessorPath(
+    const CompactDigraph& graph, const std::vector<int>& predecessors,
+    int startVertex, int endVertex);
+
+
+
+inline CompactDigraph::CompactDigraph()
+    : firstArc_{0}, firstReverseArc_{0}
+{
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+CompactDigraph::CompactDigraph(const Digraph<VertexInfo, EdgeInfo, Allocator>& d, VertexOrder order)
+{
+    vertexNumbers_.reserve(d.vertexCount());
+    indices_.reserve(d.vertexCount());
+
+    for (int vertex : d.vertexRange())
+    {
+        indices_.emplace(vertex, vertexNumbers_.size());
+        vertexNumbers_.push_back(vertex);
+    }
+
+    firstArc_.assign(vertexNumbers_.size() + 1, 0);
+    heads_.reserve(d.edgeCount());
+    tails_.reserve(d.edgeCount());
+
+    // edgeRange() lists edges grouped by "from" vertex, in increasing
+    // order of vertex number, which is the order of the indices.
+    for (const auto& edge : d.edgeRange())
+    {
+        int tail = indices_.find(edge.fromVertex)->second;
+        heads_.push_back(indices_.find(edge.toVertex)->second);
+        tails_.push_back(tail);
+        firstArc_[tail + 1]++;
+    }
+
+    for (std::size_t i = 0; i < vertexNumbers_.size(); ++i)
+    {
+        firstArc_[i + 1] += firstArc_[i];
+    }
+
+    buildReverseArcs();
+
+    if (order == VertexOrder::CuthillMcKee)
+    {
+        reorder(cuthillMcKeeOrder());
+    }
+}
+
+
+inline int CompactDigraph::vertexCount() const noexcept
+{
+    return vertexNumbers_.size();
+}
+
+
+inline int CompactDigraph::arcCount() const noexcept
+{
+    return heads_.size();
+}
+
+
+inline int CompactDigraph::index(int vertexNumber) const
+{
+    auto found = indices_.find(vertexNumber);
+
+    if (found == indices_.end())
+    {
+        throw DigraphException{
+            "CompactDigraph index(): vertex number " + std::to_string(vertexNumber)
+            + " does not exist."};
+    }
+
+    return found->second;
+}
+
+
+inline int CompactDigraph::vertexNumber(int index) const noexcept
+{
+    return vertexNumbers_[index];
+}
+
+
+inline int CompactDigraph::arcBegin(int v) const noexcept
+{
+    return firstArc_[v];
+}
+
+
+inline int CompactDigraph::arcEnd(int v) const noexcept
+{
+    return firstArc_[v + 1];
+}
+
+
+inline int CompactDigraph::arcHead(int arc) const noexcept
+{
+    return heads_[arc];
+}
+
+
+inline int CompactDigraph::arcTail(int arc) const noexcept
+{
+    return tails_[arc];
+}
+
+
+inline const int* CompactDigraph::arcHeads() const noexcept
+{
+    return heads_.data();
+}
+
+
+inline int CompactDigraph::reverseArcBegin(int v) const noexcept
+{
+    return firstReverseArc_[v];
+}
+
+
+inline int CompactDigraph::reverseArcEnd(int v) const noexcept
+{
+    return firstReverseArc_[v + 1];
+}
+
+
+inline int CompactDigraph::reverseArc(int position) const noexcept
+{
+    return reverseArcs_[position];
+}
+
+
+inline int CompactDigraph::findArc(int tail, int head) const noexcept
+{
+    for (int arc = firstArc_[tail]; arc < firstArc_[tail + 1]; ++arc)
+    {
+        if (heads_[arc] == head)
+        {
+            return arc;
+        }
+    }
+
+    return -1;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::vector<EdgeInfo> CompactDigraph::arcInfos(const Digraph<VertexInfo, EdgeInfo, Allocator>& d) const
+{
+    std::vector<EdgeInfo> infos;
+    infos.reserve(heads_.size());
+
+    for (int i = 0; i < vertexCount(); ++i)
+    {
+        for (const auto& edge : d.edgeRange(vertexNumbers_[i]))
+        {
+            infos.push_back(edge.einfo);
+        }
+    }
+
+    if (infos.size() != heads_.size())
+    {
+        throw DigraphException{"CompactDigraph arcInfos(): the Digraph has changed."};
+    }
+
+    return infos;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::vector<double> CompactDigraph::arcWeights(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& d,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    std::vector<double> weights;
+    weights.reserve(heads_.size());
+
+    for (const EdgeInfo& einfo : arcInfos(d))
+    {
+        weights.push_back(edgeWeightFunc(einfo));
+    }
+
+    return weights;
+}
+
+
+inline void CompactDigraph::buildReverseArcs()
+{
+    int n = vertexCount();
+
+    // counting sort of the arcs by their heads
+    firstReverseArc_.assign(n + 1, 0);
+
+    for (int head : heads_)
+    {
+        firstReverseArc_[head + 1]++;
+    }
+
+    for (int v = 0; v < n; ++v)
+    {
+        firstReverseArc_[v + 1] += firstReverseArc_[v];
+    }
+
+    reverseArcs_.resize(heads_.size());
+    std::vector<int> next(firstReverseArc_.begin(), firstReverseArc_.end() - 1);
+
+    for (int arc = 0; arc < arcCount(); ++arc)
+    {
+        reverseArcs_[next[heads_[arc]]++] = arc;
+    }
+}
+
+
+inline std::vector<int> CompactDigraph::cuthillMcKeeOrder() const
+{
+    int n = vertexCount();
+
+    auto degree = [&](int v)
+        {
+            return (firstArc_[v + 1] - firstArc_[v])
+                + (firstReverseArc_[v + 1] - firstReverseArc_[v]);
+        };
+
+    // forEachNeighbor() calls f(w) for the head of every arc leaving v and
+    // the tail of every arc entering it.
+    auto forEachNeighbor = [&](int v, auto f)
+        {
+            for (int arc = firstArc_[v]; arc < firstArc_[v + 1]; ++arc)
+            {
+                f(heads_[arc]);
+            }
+
+            for (int i = firstReverseArc_[v]; i < firstReverseArc_[v + 1]; ++i)
+            {
+                f(tails_[reverseArcs_[i]]);
+            }
+        };
+
+    std::vector<int> order;
+    order.reserve(n);
+
+    std::vector<int> level(n, -1);
+    std::vector<char> placed(n, 0);
+    std::vector<int> neighbors;
+
+    // breadthFirst() visits the vertices reachable from start that haven't
+    // been placed yet, appending them to "visited" with each vertex's
+    // unvisited neighbors in increasing order of degree, and returns the
+    // number of levels, along with a vertex of least degree in the last one.
+    auto breadthFirst = [&](int start, std::vector<int>& visited)
+        {
+            std::size_t first = visited.size();
+            visited.push_back(start);
+            level[start] = 0;
+            int levels = 1;
+
+            for (std::size_t i = first; i < visited.size(); ++i)
+            {
+                int v = visited[i];
+                neighbors.clear();
+
+                forEachNeighbor(v,
+                    [&](int w)
+                    {
+                        if (level[w] == -1 && !placed[w])
+                        {
+                            level[w] = level[v] + 1;
+                            levels = std::max(levels, level[w] + 1);
+                            neighbors.push_back(w);
+                        }
+                    });
+
+                std::sort(neighbors.begin(), neighbors.end(),
+                    [&](int a, int b) { return degree(a) < degree(b) || (degree(a) == degree(b) && a < b); });
+
+                visited.insert(visited.end(), neighbors.begin(), neighbors.end());
+            }
+
+            int farthest = visited.back();
+
+            for (std::size_t i = first; i < visited.size(); ++i)
+            {
+                int v = visited[i];
+
+                if (level[v] == levels - 1 && degree(v) < degree(farthest))
+                {
+                    farthest = v;
+                }
+
+                level[v] = -1;
+            }
+
+            return std::make_pair(levels, farthest);
+        };
+
+    std::vector<int> candidates(n);
+
+    for (int v = 0; v < n; ++v)
+    {
+        candidates[v] = v;
+    }
+
+    std::stable_sort(candidates.begin(), candidates.end(),
+        [&](int a, int b) { return degree(a) < degree(b); });
+
+    std::vector<int> sweep;
+
+    for (int candidate : candidates)
+    {
+        if (placed[candidate])
+        {
+            continue;
+        }
+
+        // Starting from a vertex at one "end" of its component keeps the
+        // levels narrow, so look for one: repeatedly jump to a vertex of
+        // least degree in the last level, while that makes more levels.
+        int start = candidate;
+        int levels = 0;
+
+        for (int attempt = 0; attempt < 8; ++attempt)
+        {
+            sweep.clear();
+            auto [newLevels, farthest] = breadthFirst(start, sweep);
+
+            if (newLevels <= levels)
+            {
+                break;
+            }
+
+            levels = newLevels;
+            start = farthest;
+        }
+
+        std::size_t first = order.size();
+        breadthFirst(start, order);
+
+        for (std::size_t i = first; i < order.size(); ++i)
+        {
+            placed[order[i]] = 1;
+        }
+    }
+
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+
+inline void CompactDigraph::reorder(const std::vector<int>& order)
+{
+    int n = vertexCount();
+    std::vector<int> newIndex(n);
+
+    for (int i = 0; i < n; ++i)
+    {
+        newIndex[order[i]] = i;
+    }
+
+    std::vector<int> vertexNumbers(n);
+    std::vector<int> firstArc;
+    std::vector<int> heads;
+    std::vector<int> tails;
+
+    firstArc.reserve(n + 1);
+    heads.reserve(heads_.size());
+    tails.reserve(tails_.size());
+
+    for (int i = 0; i < n; ++i)
+    {
+        int old = order[i];
+        vertexNumbers[i] = vertexNumbers_[old];
+        indices_[vertexNumbers_[old]] = i;
+        firstArc.push_back(heads.size());
+
+        for (int arc = firstArc_[old]; arc < firstArc_[old + 1]; ++arc)
+        {
+            heads.push_back(newIndex[heads_[arc]]);
+            tails.push_back(i);
+        }
+    }
+
+    firstArc.push_back(heads.size());
+
+    vertexNumbers_ = std::move(vertexNumbers);
+    firstArc_ = std::move(firstArc);
+    heads_ = std::move(heads);
+    tails_ = std::move(tails);
+
+    buildReverseArcs();
+}
+
+
+
+inline std::vector<int> predecessorPath(
+    const CompactDigraph& graph, const std::vector<int>& predecessors,
+    int startVertex, int endVertex)
+{
+    std::vector<int> path;
+
+    for (int v = graph.index(endVertex); v != -1; v = predecessors[v])
+    {
+        path.push_back(graph.vertexNumber(v));
+    }
+
+    // Only the start vertex and unreachable vertices have no predecessor.
+    if (path.back() != startVertex)
+    {
+        path.clear();
+    }
+
+    std::reverse(path.begin(), path.end());
+    return path;
+}
+
+
+
+#endif
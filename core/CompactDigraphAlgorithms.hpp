@@ -0,0 +1,192 @@
+// CompactDigraphAlgorithms.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares the basic graph algorithms -- Dijkstra's
+// algorithm and strongly connected components -- for a CompactDigraph.
+// They do the same thing as the Digraph's findShortestPaths() and
+// isStronglyConnected(), but on flat arrays indexed by vertex index, so
+// they run much faster, especially on a CompactDigraph whose vertices are
+// in VertexOrder::CuthillMcKee order.
+
+#ifndef COMPACTDIGRAPHALGORITHMS_HPP
+#define COMPACTDIGRAPHALGORITHMS_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "ArcRelaxation.hpp"
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+
+
+
+// dijkstraShortestPaths() finds the shortest paths in the given graph from
+// the vertex with the given index, with the given arc weights (indexed by
+// arc number).  If the number of weights is wrong, or there is no vertex
+// with the start index, a DigraphException is thrown.
+SingleSourcePaths dijkstraShortestPaths(
+    const CompactDigraph& graph, const std::vector<double>& arcWeights, int startIndex);
+
+
+// stronglyConnectedComponents() returns the strongly connected component
+// of every vertex, indexed by vertex index.  Components are numbered
+// consecutively from zero.
+std::vector<int> stronglyConnectedComponents(const CompactDigraph& graph);
+
+
+// isStronglyConnected() returns true if every vertex of the given graph is
+// reachable from every other, false otherwise.
+bool isStronglyConnected(const CompactDigraph& graph);
+
+
+
+inline SingleSourcePaths dijkstraShortestPaths(
+    const CompactDigraph& graph, const std::vector<double>& arcWeights, int startIndex)
+{
+    int n = graph.vertexCount();
+
+    if (static_cast<int>(arcWeights.size()) != graph.arcCount())
+    {
+        throw DigraphException{"dijkstraShortestPaths(): there must be one weight per arc."};
+    }
+
+    if (startIndex < 0 || startIndex >= n)
+    {
+        throw DigraphException{"dijkstraShortestPaths(): the start vertex is not valid."};
+    }
+
+    SingleSourcePaths paths;
+    paths.distances.assign(n, std::numeric_limits<double>::infinity());
+    paths.predecessors.assign(n, -1);
+
+    std::vector<double>& dist = paths.distances;
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> queue;
+
+    dist[startIndex] = 0.0;
+    queue.push({0.0, startIndex});
+
+    while (!queue.empty())
+    {
+        auto [d, v] = queue.top();
+        queue.pop();
+
+        if (d > dist[v])
+        {
+            continue;
+        }
+
+        int first = graph.arcBegin(v);
+
+        relaxArcs(
+            graph.arcHeads() + first, arcWeights.data() + first, graph.arcEnd(v) - first, d,
+            dist.data(),
+            [&](int i, double candidate)
+            {
+                int w = graph.arcHead(first + i);
+                paths.predecessors[w] = v;
+                queue.push({candidate, w});
+            });
+    }
+
+    return paths;
+}
+
+
+inline std::vector<int> stronglyConnectedComponents(const CompactDigraph& graph)
+{
+    // Tarjan's algorithm, with an explicit stack of (vertex, next arc)
+    // pairs instead of recursion, so long paths can't overflow the stack.
+    int n = graph.vertexCount();
+
+    std::vector<int> component(n, -1);
+    std::vector<int> discovered(n, -1);
+    std::vector<int> lowLink(n, 0);
+    std::vector<char> onStack(n, 0);
+    std::vector<int> stack;
+    std::vector<std::pair<int, int>> callStack;
+
+    int time = 0;
+    int components = 0;
+
+    for (int root = 0; root < n; ++root)
+    {
+        if (discovered[root] != -1)
+        {
+            continue;
+        }
+
+        callStack.push_back({root, graph.arcBegin(root)});
+        discovered[root] = lowLink[root] = time++;
+        stack.push_back(root);
+        onStack[root] = 1;
+
+        while (!callStack.empty())
+        {
+            auto& [v, arc] = callStack.back();
+
+            if (arc < graph.arcEnd(v))
+            {
+                int w = graph.arcHead(arc++);
+
+                if (discovered[w] == -1)
+                {
+                    discovered[w] = lowLink[w] = time++;
+                    stack.push_back(w);
+                    onStack[w] = 1;
+                    callStack.push_back({w, graph.arcBegin(w)});
+                }
+                else if (onStack[w])
+                {
+                    lowLink[v] = std::min(lowLink[v], discovered[w]);
+                }
+
+                continue;
+            }
+
+            int finished = v;
+            callStack.pop_back();
+
+            if (lowLink[finished] == discovered[finished])
+            {
+                int w;
+
+                do
+                {
+                    w = stack.back();
+                    stack.pop_back();
+                    onStack[w] = 0;
+                    component[w] = components;
+                }
+                while (w != finished);
+
+                components++;
+            }
+
+            if (!callStack.empty())
+            {
+                int parent = callStack.back().first;
+                lowLink[parent] = std::min(lowLink[parent], lowLink[finished]);
+            }
+        }
+    }
+
+    return component;
+}
+
+
+inline bool isStronglyConnected(const CompactDigraph& graph)
+{
+    std::vector<int> component = stronglyConnectedComponents(graph);
+    return std::all_of(component.begin(), component.end(), [](int c) { return c == 0; });
+}
+
+
+
+#endif
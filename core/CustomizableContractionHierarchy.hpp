@@ -0,0 +1,785 @@
+// CustomizableContractionHierarchy.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares the classes that make up a customizable
+// contraction hierarchy ("CCH"), a speed-up technique for shortest path
+// queries that splits preprocessing into two phases:
+//
+// * CustomizableContractionHierarchy is the metric-independent phase.
+//   Given only the structure of a CompactDigraph, it orders the vertices
+//   by nested dissection, contracts them in that order, and records the
+//   resulting chordal supergraph: every original arc plus every shortcut
+//   that contraction could ever need, for any weights.  This is the slow
+//   phase, and it only has to be redone when the road network itself
+//   changes.
+//
+// * CustomizedMetric is the metric-dependent phase ("customization").
+//   Given a weight for every arc, it computes the weight of every edge of
+//   the hierarchy by looking at the triangles below it.  It does no
+//   searching at all, so it's fast, and vertices at the same level of
+//   the elimination tree are customized in parallel.  Any number of
+//   metrics can be customized from the same hierarchy.
+//
+// * HierarchyQuery answers shortest path queries against one
+//   CustomizedMetric.  Each query walks up the elimination tree from both
+//   endpoints, and shortcuts are unpacked into original arcs afterward.
+//
+// Internally, the hierarchy numbers its vertices by rank (position in the
+// contraction order), so a vertex's upward edges always point to vertices
+// with larger numbers.  Ranks, CompactDigraph indices, and Digraph vertex
+// numbers are all different things; rank(), vertexAtRank(), and the
+// CompactDigraph translate between them.
+
+#ifndef CUSTOMIZABLECONTRACTIONHIERARCHY_HPP
+#define CUSTOMIZABLECONTRACTIONHIERARCHY_HPP
+
+#include <algorithm>
+#include <limits>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "NestedDissection.hpp"
+#include "ParallelFor.hpp"
+
+
+
+class CustomizableContractionHierarchy
+{
+public:
+    // This constructor builds a hierarchy for the given graph, contracting
+    // vertices in nested dissection order.
+    explicit CustomizableContractionHierarchy(const CompactDigraph& graph);
+
+    // This constructor builds a hierarchy for the given graph, contracting
+    // vertices in the given order (a permutation of the graph's vertex
+    // indices, least important first).  If it isn't a permutation, a
+    // DigraphException is thrown.
+    CustomizableContractionHierarchy(const CompactDigraph& graph, const std::vector<int>& order);
+
+    // graph() returns the graph the hierarchy was built from.
+    const CompactDigraph& graph() const noexcept;
+
+    // vertexCount() returns the number of vertices in the hierarchy.
+    int vertexCount() const noexcept;
+
+    // edgeCount() returns the number of (undirected) edges in the
+    // hierarchy, counting both original edges and shortcuts.
+    int edgeCount() const noexcept;
+
+    // rank() returns the rank of the vertex with the given index in the
+    // graph, and vertexAtRank() goes the other way.
+    int rank(int index) const noexcept;
+    int vertexAtRank(int rank) const noexcept;
+
+    // parent() returns the rank of the parent of the given rank in the
+    // elimination tree, or -1 for a root.
+    int parent(int rank) const noexcept;
+
+    // The upward edges of a rank are numbered from upEdgeBegin() up to,
+    // but not including, upEdgeEnd(), and are sorted by the rank of the
+    // vertex they lead to.  edgeTail() returns the lower-ranked endpoint
+    // of an edge and edgeHead() returns the higher-ranked one.
+    int upEdgeBegin(int rank) const noexcept;
+    int upEdgeEnd(int rank) const noexcept;
+    int edgeTail(int edge) const noexcept;
+    int edgeHead(int edge) const noexcept;
+
+    // The downward edges of a rank (the edges to lower-ranked neighbors)
+    // are listed in positions downEdgeBegin() up to, but not including,
+    // downEdgeEnd(), sorted by the rank of the neighbor; downEdge() turns
+    // a position into an edge number.
+    int downEdgeBegin(int rank) const noexcept;
+    int downEdgeEnd(int rank) const noexcept;
+    int downEdge(int position) const noexcept;
+
+    // findEdge() returns the number of the edge between the given ranks,
+    // or -1 if there isn't one.
+    int findEdge(int lowerRank, int higherRank) const noexcept;
+
+    // levels() returns the ranks grouped by their level in the
+    // elimination tree, bottom level first.  No two ranks on the same
+    // level have a triangle in common below them.
+    const std::vector<std::vector<int>>& levels() const noexcept;
+
+    // arcEdge() returns the edge of the hierarchy that the given arc of
+    // the graph was mapped to (or -1 for an arc from a vertex to itself),
+    // and arcIsUpward() returns whether the arc points from the lower
+    // ranked endpoint of that edge to the higher ranked one.
+    int arcEdge(int arc) const noexcept;
+    bool arcIsUpward(int arc) const noexcept;
+
+
+private:
+    CompactDigraph graph_;
+    std::vector<int> rank_;
+    std::vector<int> vertexAtRank_;
+    std::vector<int> parent_;
+    std::vector<int> firstUpEdge_;
+    std::vector<int> edgeTails_;
+    std::vector<int> edgeHeads_;
+    std::vector<int> firstDownEdge_;
+    std::vector<int> downEdges_;
+    std::vector<std::vector<int>> levels_;
+    std::vector<int> arcEdges_;
+    std::vector<bool> arcIsUpward_;
+
+    void build(const std::vector<int>& order);
+};
+
+
+
+class CustomizedMetric
+{
+public:
+    // This constructor customizes the given hierarchy for the given arc
+    // weights (one per arc of the hierarchy's graph, indexed by arc
+    // number), using up to threadCount threads.  The hierarchy must
+    // outlive the CustomizedMetric.  If the number of weights is wrong, a
+    // DigraphException is thrown.
+    CustomizedMetric(
+        const CustomizableContractionHierarchy& hierarchy,
+        const std::vector<double>& arcWeights,
+        int threadCount = defaultThreadCount());
+
+    // hierarchy() returns the hierarchy this metric was customized from.
+    const CustomizableContractionHierarchy& hierarchy() const noexcept;
+
+    // upWeight() returns the weight of travelling along the given edge from
+    // its lower-ranked endpoint to its higher-ranked one, and downWeight()
+    // the weight in the opposite direction.  Either is infinite if there
+    // is no such path through the lower part of the hierarchy.
+    double upWeight(int edge) const noexcept;
+    double downWeight(int edge) const noexcept;
+
+    // arcWeight() returns the weight the given arc of the hierarchy's
+    // graph was customized with.
+    double arcWeight(int arc) const noexcept;
+
+    // unpackUp() appends to "ranks" the ranks of the vertices visited
+    // when travelling along the given edge upward, in order, excluding its
+    // lower-ranked endpoint but including its higher-ranked one.
+    // unpackDown() does the same for travelling downward.
+    void unpackUp(int edge, std::vector<int>& ranks) const;
+    void unpackDown(int edge, std::vector<int>& ranks) const;
+
+
+private:
+    const CustomizableContractionHierarchy* hierarchy_;
+    std::vector<double> arcWeights_;
+    std::vector<double> up_;
+    std::vector<double> down_;
+    std::vector<int> upMiddle_;
+    std::vector<int> downMiddle_;
+};
+
+
+
+class HierarchyQuery
+{
+public:
+    // This constructor prepares to answer queries against the given
+    // metric, which must outlive the HierarchyQuery.  A HierarchyQuery
+    // reuses its memory from one query to the next, so each thread
+    // answering queries should have its own.
+    explicit HierarchyQuery(const CustomizedMetric& metric);
+
+    // distance() returns the length of the shortest path between the
+    // given vertex numbers, or infinity if there is none.  If either
+    // vertex does not exist, a DigraphException is thrown.
+    double distance(int startVertex, int endVertex);
+
+    // shortestPath() is like distance(), except that it also returns the
+    // sequence of vertex numbers along the path.
+    DigraphPath shortestPath(int startVertex, int endVertex);
+
+
+private:
+    const CustomizedMetric* metric_;
+    std::vector<double> forwardDist_;
+    std::vector<double> backwardDist_;
+    std::vector<int> forwardEdge_;
+    std::vector<int> backwardEdge_;
+    std::vector<int> touched_;
+
+    // search() walks up the elimination tree from both endpoints, given
+    // as ranks, and returns the rank where the best paths meet, or -1.
+    int search(int startRank, int endRank);
+
+    // clear() resets everything the last search touched.
+    void clear();
+};
+
+
+
+inline CustomizableContractionHierarchy::CustomizableContractionHierarchy(
+    const CompactDigraph& graph)
+    : graph_{graph}
+{
+    build(nestedDissectionOrder(graph));
+}
+
+
+inline CustomizableContractionHierarchy::CustomizableContractionHierarchy(
+    const CompactDigraph& graph, const std::vector<int>& order)
+    : graph_{graph}
+{
+    build(order);
+}
+
+
+inline const CompactDigraph& CustomizableContractionHierarchy::graph() const noexcept
+{
+    return graph_;
+}
+
+
+inline int CustomizableContractionHierarchy::vertexCount() const noexcept
+{
+    return rank_.size();
+}
+
+
+inline int CustomizableContractionHierarchy::edgeCount() const noexcept
+{
+    return edgeHeads_.size();
+}
+
+
+inline int CustomizableContractionHierarchy::rank(int index) const noexcept
+{
+    return rank_[index];
+}
+
+
+inline int CustomizableContractionHierarchy::vertexAtRank(int rank) const noexcept
+{
+    return vertexAtRank_[rank];
+}
+
+
+inline int CustomizableContractionHierarchy::parent(int rank) const noexcept
+{
+    return parent_[rank];
+}
+
+
+inline int CustomizableContractionHierarchy::upEdgeBegin(int rank) const noexcept
+{
+    return firstUpEdge_[rank];
+}
+
+
+inline int CustomizableContractionHierarchy::upEdgeEnd(int rank) const noexcept
+{
+    return firstUpEdge_[rank + 1];
+}
+
+
+inline int CustomizableContractionHierarchy::edgeTail(int edge) const noexcept
+{
+    return edgeTails_[edge];
+}
+
+
+inline int CustomizableContractionHierarchy::edgeHead(int edge) const noexcept
+{
+    return edgeHeads_[edge];
+}
+
+
+inline int CustomizableContractionHierarchy::downEdgeBegin(int rank) const noexcept
+{
+    return firstDownEdge_[rank];
+}
+
+
+inline int CustomizableContractionHierarchy::downEdgeEnd(int rank) const noexcept
+{
+    return firstDownEdge_[rank + 1];
+}
+
+
+inline int CustomizableContractionHierarchy::downEdge(int position) const noexcept
+{
+    return downEdges_[position];
+}
+
+
+inline int CustomizableContractionHierarchy::findEdge(int lowerRank, int higherRank) const noexcept
+{
+    auto begin = edgeHeads_.begin() + firstUpEdge_[lowerRank];
+    auto end = edgeHeads_.begin() + firstUpEdge_[lowerRank + 1];
+    auto found = std::lower_bound(begin, end, higherRank);
+
+    if (found == end || *found != higherRank)
+    {
+        return -1;
+    }
+
+    return found - edgeHeads_.begin();
+}
+
+
+inline const std::vector<std::vector<int>>& CustomizableContractionHierarchy::levels() const noexcept
+{
+    return levels_;
+}
+
+
+inline int CustomizableContractionHierarchy::arcEdge(int arc) const noexcept
+{
+    return arcEdges_[arc];
+}
+
+
+inline bool CustomizableContractionHierarchy::arcIsUpward(int arc) const noexcept
+{
+    return arcIsUpward_[arc];
+}
+
+
+inline void CustomizableContractionHierarchy::build(const std::vector<int>& order)
+{
+    int n = graph_.vertexCount();
+
+    if (static_cast<int>(order.size()) != n)
+    {
+        throw DigraphException{"CustomizableContractionHierarchy: the order is not a permutation."};
+    }
+
+    rank_.assign(n, -1);
+    vertexAtRank_ = order;
+
+    for (int r = 0; r < n; ++r)
+    {
+        if (order[r] < 0 || order[r] >= n || rank_[order[r]] != -1)
+        {
+            throw DigraphException{"CustomizableContractionHierarchy: the order is not a permutation."};
+        }
+
+        rank_[order[r]] = r;
+    }
+
+    // Start with every original edge, pointing upward.
+    std::vector<std::vector<int>> upward(n);
+
+    for (int arc = 0; arc < graph_.arcCount(); ++arc)
+    {
+        int tail = rank_[graph_.arcTail(arc)];
+        int head = rank_[graph_.arcHead(arc)];
+
+        if (tail != head)
+        {
+            upward[std::min(tail, head)].push_back(std::max(tail, head));
+        }
+    }
+
+    // Contract the vertices in rank order.  Contracting a vertex connects
+    // all of its upward neighbors to each other; since they'll all end up
+    // connected to the lowest of them anyway, it's enough to hand the rest
+    // to that one, which becomes the vertex's parent in the elimination
+    // tree.
+    parent_.assign(n, -1);
+    firstUpEdge_.assign(n + 1, 0);
+
+    for (int r = 0; r < n; ++r)
+    {
+        std::vector<int>& neighbors = upward[r];
+        std::sort(neighbors.begin(), neighbors.end());
+        neighbors.erase(std::unique(neighbors.begin(), neighbors.end()), neighbors.end());
+
+        if (!neighbors.empty())
+        {
+            int p = neighbors.front();
+            parent_[r] = p;
+            upward[p].insert(upward[p].end(), neighbors.begin() + 1, neighbors.end());
+        }
+
+        firstUpEdge_[r + 1] = firstUpEdge_[r] + neighbors.size();
+    }
+
+    edgeTails_.reserve(firstUpEdge_[n]);
+    edgeHeads_.reserve(firstUpEdge_[n]);
+
+    for (int r = 0; r < n; ++r)
+    {
+        for (int head : upward[r])
+        {
+            edgeTails_.push_back(r);
+            edgeHeads_.push_back(head);
+        }
+
+        std::vector<int>().swap(upward[r]);
+    }
+
+    // Downward edges, grouped by their higher-ranked endpoint; since edges
+    // are numbered in order of their lower-ranked endpoint, each group
+    // comes out sorted.
+    firstDownEdge_.assign(n + 1, 0);
+
+    for (int head : edgeHeads_)
+    {
+        firstDownEdge_[head + 1]++;
+    }
+
+    for (int r = 0; r < n; ++r)
+    {
+        firstDownEdge_[r + 1] += firstDownEdge_[r];
+    }
+
+    downEdges_.resize(edgeHeads_.size());
+    std::vector<int> next(firstDownEdge_.begin(), firstDownEdge_.end() - 1);
+
+    for (int edge = 0; edge < edgeCount(); ++edge)
+    {
+        downEdges_[next[edgeHeads_[edge]]++] = edge;
+    }
+
+    // A rank's level is one more than the highest level below it.
+    std::vector<int> level(n, 0);
+
+    for (int r = 0; r < n; ++r)
+    {
+        for (int position = firstDownEdge_[r]; position < firstDownEdge_[r + 1]; ++position)
+        {
+            level[r] = std::max(level[r], level[edgeTails_[downEdges_[position]]] + 1);
+        }
+
+        if (level[r] >= static_cast<int>(levels_.size()))
+        {
+            levels_.resize(level[r] + 1);
+        }
+
+        levels_[level[r]].push_back(r);
+    }
+
+    arcEdges_.resize(graph_.arcCount());
+    arcIsUpward_.resize(graph_.arcCount());
+
+    for (int arc = 0; arc < graph_.arcCount(); ++arc)
+    {
+        int tail = rank_[graph_.arcTail(arc)];
+        int head = rank_[graph_.arcHead(arc)];
+
+        arcEdges_[arc] = tail == head ? -1 : findEdge(std::min(tail, head), std::max(tail, head));
+        arcIsUpward_[arc] = tail < head;
+    }
+}
+
+
+
+inline CustomizedMetric::CustomizedMetric(
+    const CustomizableContractionHierarchy& hierarchy,
+    const std::vector<double>& arcWeights,
+    int threadCount)
+    : hierarchy_{&hierarchy}, arcWeights_{arcWeights}
+{
+    if (static_cast<int>(arcWeights.size()) != hierarchy.graph().arcCount())
+    {
+        throw DigraphException{"CustomizedMetric: there must be one weight per arc."};
+    }
+
+    int m = hierarchy.edgeCount();
+    double infinity = std::numeric_limits<double>::infinity();
+
+    up_.assign(m, infinity);
+    down_.assign(m, infinity);
+    upMiddle_.assign(m, -1);
+    downMiddle_.assign(m, -1);
+
+    for (int arc = 0; arc < static_cast<int>(arcWeights.size()); ++arc)
+    {
+        int edge = hierarchy.arcEdge(arc);
+
+        if (edge == -1)
+        {
+            continue;
+        }
+
+        double& weight = hierarchy.arcIsUpward(arc) ? up_[edge] : down_[edge];
+        weight = std::min(weight, arcWeights[arc]);
+    }
+
+    // Each edge {y, z} (y below z) can be improved by going through any
+    // vertex x below both of them: y -> x -> z.  Those lower triangles
+    // only involve edges whose lower endpoint is x, which is on a lower
+    // level than y, so whole levels can be processed at once and every
+    // thread only writes to the upward edges of its own vertices.
+    for (const std::vector<int>& level : hierarchy.levels())
+    {
+        parallelFor(0, level.size(), threadCount,
+            [&](int i)
+            {
+                int y = level[i];
+
+                for (int edge = hierarchy.upEdgeBegin(y); edge < hierarchy.upEdgeEnd(y); ++edge)
+                {
+                    int z = hierarchy.edgeHead(edge);
+
+                    int yPosition = hierarchy.downEdgeBegin(y);
+                    int yEnd = hierarchy.downEdgeEnd(y);
+                    int zPosition = hierarchy.downEdgeBegin(z);
+                    int zEnd = hierarchy.downEdgeEnd(z);
+
+                    while (yPosition < yEnd && zPosition < zEnd)
+                    {
+                        int yx = hierarchy.downEdge(yPosition);
+                        int zx = hierarchy.downEdge(zPosition);
+                        int xFromY = hierarchy.edgeTail(yx);
+                        int xFromZ = hierarchy.edgeTail(zx);
+
+                        if (xFromY < xFromZ)
+                        {
+                            ++yPosition;
+                        }
+                        else if (xFromZ < xFromY)
+                        {
+                            ++zPosition;
+                        }
+                        else
+                        {
+                            if (down_[yx] + up_[zx] < up_[edge])
+                            {
+                                up_[edge] = down_[yx] + up_[zx];
+                                upMiddle_[edge] = xFromY;
+                            }
+
+                            if (down_[zx] + up_[yx] < down_[edge])
+                            {
+                                down_[edge] = down_[zx] + up_[yx];
+                                downMiddle_[edge] = xFromY;
+                            }
+
+                            ++yPosition;
+                            ++zPosition;
+                        }
+                    }
+                }
+            });
+    }
+}
+
+
+inline const CustomizableContractionHierarchy& CustomizedMetric::hierarchy() const noexcept
+{
+    return *hierarchy_;
+}
+
+
+inline double CustomizedMetric::upWeight(int edge) const noexcept
+{
+    return up_[edge];
+}
+
+
+inline double CustomizedMetric::downWeight(int edge) const noexcept
+{
+    return down_[edge];
+}
+
+
+inline double CustomizedMetric::arcWeight(int arc) const noexcept
+{
+    return arcWeights_[arc];
+}
+
+
+inline void CustomizedMetric::unpackUp(int edge, std::vector<int>& ranks) const
+{
+    int x = upMiddle_[edge];
+
+    if (x == -1)
+    {
+        ranks.push_back(hierarchy_->edgeHead(edge));
+    }
+    else
+    {
+        // y -> x runs down the edge {x, y}; x -> z runs up the edge {x, z}
+        unpackDown(hierarchy_->findEdge(x, hierarchy_->edgeTail(edge)), ranks);
+        unpackUp(hierarchy_->findEdge(x, hierarchy_->edgeHead(edge)), ranks);
+    }
+}
+
+
+inline void CustomizedMetric::unpackDown(int edge, std::vector<int>& ranks) const
+{
+    int x = downMiddle_[edge];
+
+    if (x == -1)
+    {
+        ranks.push_back(hierarchy_->edgeTail(edge));
+    }
+    else
+    {
+        // z -> x runs down the edge {x, z}; x -> y runs up the edge {x, y}
+        unpackDown(hierarchy_->findEdge(x, hierarchy_->edgeHead(edge)), ranks);
+        unpackUp(hierarchy_->findEdge(x, hierarchy_->edgeTail(edge)), ranks);
+    }
+}
+
+
+
+inline HierarchyQuery::HierarchyQuery(const CustomizedMetric& metric)
+    : metric_{&metric},
+      forwardDist_(metric.hierarchy().vertexCount(), std::numeric_limits<double>::infinity()),
+      backwardDist_(metric.hierarchy().vertexCount(), std::numeric_limits<double>::infinity()),
+      forwardEdge_(metric.hierarchy().vertexCount(), -1),
+      backwardEdge_(metric.hierarchy().vertexCount(), -1)
+{
+}
+
+
+inline double HierarchyQuery::distance(int startVertex, int endVertex)
+{
+    const CustomizableContractionHierarchy& hierarchy = metric_->hierarchy();
+
+    int meeting = search(
+        hierarchy.rank(hierarchy.graph().index(startVertex)),
+        hierarchy.rank(hierarchy.graph().index(endVertex)));
+
+    double result = meeting == -1
+        ? std::numeric_limits<double>::infinity()
+        : forwardDist_[meeting] + backwardDist_[meeting];
+
+    clear();
+    return result;
+}
+
+
+inline DigraphPath HierarchyQuery::shortestPath(int startVertex, int endVertex)
+{
+    const CustomizableContractionHierarchy& hierarchy = metric_->hierarchy();
+    const CompactDigraph& graph = hierarchy.graph();
+
+    int startRank = hierarchy.rank(graph.index(startVertex));
+    int endRank = hierarchy.rank(graph.index(endVertex));
+    int meeting = search(startRank, endRank);
+
+    if (meeting == -1)
+    {
+        clear();
+        return DigraphPath{std::numeric_limits<double>::infinity(), {}};
+    }
+
+    // Collect the edges from the start up to the meeting point, then
+    // unpack them in order, followed by the edges from the meeting point
+    // down to the end.
+    std::vector<int> upEdges;
+
+    for (int r = meeting; r != startRank; r = hierarchy.edgeTail(forwardEdge_[r]))
+    {
+        upEdges.push_back(forwardEdge_[r]);
+    }
+
+    std::vector<int> ranks{startRank};
+
+    for (auto edge = upEdges.rbegin(); edge != upEdges.rend(); ++edge)
+    {
+        metric_->unpackUp(*edge, ranks);
+    }
+
+    for (int r = meeting; r != endRank; r = hierarchy.edgeTail(backwardEdge_[r]))
+    {
+        metric_->unpackDown(backwardEdge_[r], ranks);
+    }
+
+    DigraphPath path{forwardDist_[meeting] + backwardDist_[meeting], {}};
+    path.vertices.reserve(ranks.size());
+
+    for (int r : ranks)
+    {
+        path.vertices.push_back(graph.vertexNumber(hierarchy.vertexAtRank(r)));
+    }
+
+    clear();
+    return path;
+}
+
+
+inline int HierarchyQuery::search(int startRank, int endRank)
+{
+    const CustomizableContractionHierarchy& hierarchy = metric_->hierarchy();
+
+    // Every upward neighbor of a vertex is one of its ancestors in the
+    // elimination tree, so walking up the tree and relaxing upward edges
+    // along the way visits everything an upward search could reach, in
+    // an order where each vertex is final before it's scanned.
+    forwardDist_[startRank] = 0.0;
+
+    for (int r = startRank; r != -1; r = hierarchy.parent(r))
+    {
+        touched_.push_back(r);
+
+        if (forwardDist_[r] == std::numeric_limits<double>::infinity())
+        {
+            continue;
+        }
+
+        for (int edge = hierarchy.upEdgeBegin(r); edge < hierarchy.upEdgeEnd(r); ++edge)
+        {
+            int head = hierarchy.edgeHead(edge);
+            double candidate = forwardDist_[r] + metric_->upWeight(edge);
+
+            if (candidate < forwardDist_[head])
+            {
+                forwardDist_[head] = candidate;
+                forwardEdge_[head] = edge;
+            }
+        }
+    }
+
+    backwardDist_[endRank] = 0.0;
+
+    int meeting = -1;
+    double best = std::numeric_limits<double>::infinity();
+
+    for (int r = endRank; r != -1; r = hierarchy.parent(r))
+    {
+        touched_.push_back(r);
+
+        if (backwardDist_[r] == std::numeric_limits<double>::infinity())
+        {
+            continue;
+        }
+
+        if (forwardDist_[r] + backwardDist_[r] < best)
+        {
+            best = forwardDist_[r] + backwardDist_[r];
+            meeting = r;
+        }
+
+        for (int edge = hierarchy.upEdgeBegin(r); edge < hierarchy.upEdgeEnd(r); ++edge)
+        {
+            int head = hierarchy.edgeHead(edge);
+            double candidate = backwardDist_[r] + metric_->downWeight(edge);
+
+            if (candidate < backwardDist_[head])
+            {
+                backwardDist_[head] = candidate;
+                backwardEdge_[head] = edge;
+            }
+        }
+    }
+
+    return meeting;
+}
+
+
+inline void HierarchyQuery::clear()
+{
+    for (int r : touched_)
+    {
+        forwardDist_[r] = std::numeric_limits<double>::infinity();
+        backwardDist_[r] = std::numeric_limits<double>::infinity();
+        forwardEdge_[r] = -1;
+        backwardEdge_[r] = -1;
+    }
+
+    touched_.clear();
+}
+
+
+
+#endif
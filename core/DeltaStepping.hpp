@@ -0,0 +1,360 @@
+// DeltaStepping.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares deltaSteppingShortestPaths(), which computes
+// the shortest paths from one vertex to all others using several threads
+// at once, and findShortestPathsInParallel(), which does the same for a
+// Digraph and returns its result in the same form as findShortestPaths().
+//
+// Dijkstra's algorithm finishes one vertex at a time, which leaves nothing
+// to do in parallel.  Delta-stepping relaxes the ordering instead: vertices
+// are kept in "buckets" of width delta by their tentative distance, and all
+// vertices in the lowest nonempty bucket are processed together.  Arcs no
+// heavier than delta ("light" arcs) can put vertices back into the current
+// bucket, so they're relaxed repeatedly until the bucket stays empty; heavy
+// arcs can't, so they're relaxed just once, when the bucket is done.  Each
+// of those steps relaxes the arcs of many vertices at once, split across
+// threads, with tentative distances lowered by atomic compare-and-swap.
+//
+// Because floating-point addition never decreases when one of its operands
+// increases, the distances both algorithms settle on are the smallest
+// sums along any path, computed left to right, so they're identical to the
+// bit.  Predecessors are chosen after the distances are known: each
+// vertex's predecessor is the lowest-numbered vertex with an arc into it
+// that lies on a shortest path.  This is the predecessor Dijkstra's
+// algorithm chooses whenever shortest paths are unique.
+
+#ifndef DELTASTEPPING_HPP
+#define DELTASTEPPING_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <map>
+#include <utility>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "ParallelFor.hpp"
+
+
+
+// deltaSteppingShortestPaths() finds the shortest paths in the given graph
+// from the vertex with the given index, with the given arc weights (indexed
+// by arc number), using up to threadCount threads.  The bucket width is
+// delta, or the average arc weight if delta isn't positive.  If a weight is
+// negative or NaN, the number of weights is wrong, or there is no vertex
+// with the start index, a DigraphException is thrown.
+SingleSourcePaths deltaSteppingShortestPaths(
+    const CompactDigraph& graph, const std::vector<double>& arcWeights, int startIndex,
+    int threadCount = defaultThreadCount(), double delta = 0.0);
+
+
+// findShortestPathsInParallel() is a drop-in replacement for the Digraph's
+// findShortestPaths(), computed with deltaSteppingShortestPaths().
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::map<int, int> findShortestPathsInParallel(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& d, int startVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    int threadCount = defaultThreadCount());
+
+
+
+inline SingleSourcePaths deltaSteppingShortestPaths(
+    const CompactDigraph& graph, const std::vector<double>& arcWeights, int startIndex,
+    int threadCount, double delta)
+{
+    int n = graph.vertexCount();
+
+    if (static_cast<int>(arcWeights.size()) != graph.arcCount())
+    {
+        throw DigraphException{"deltaSteppingShortestPaths(): there must be one weight per arc."};
+    }
+
+    if (startIndex < 0 || startIndex >= n)
+    {
+        throw DigraphException{"deltaSteppingShortestPaths(): the start vertex is not valid."};
+    }
+
+    double totalWeight = 0.0;
+    int finiteArcs = 0;
+
+    for (double weight : arcWeights)
+    {
+        if (!(weight >= 0.0))
+        {
+            throw DigraphException{"deltaSteppingShortestPaths(): weights can't be negative."};
+        }
+
+        if (weight != std::numeric_limits<double>::infinity())
+        {
+            totalWeight += weight;
+            finiteArcs++;
+        }
+    }
+
+    if (!(delta > 0.0))
+    {
+        delta = finiteArcs > 0 && totalWeight > 0.0 ? totalWeight / finiteArcs : 1.0;
+    }
+
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    std::vector<std::atomic<double>> dist(n);
+
+    parallelFor(0, n, threadCount,
+        [&](int v)
+        {
+            dist[v].store(infinity, std::memory_order_relaxed);
+        });
+
+    dist[startIndex].store(0.0, std::memory_order_relaxed);
+
+    // lower() tries to lower the tentative distance of v, returning
+    // whether it did.
+    auto lower = [&](int v, double candidate)
+        {
+            double current = dist[v].load(std::memory_order_relaxed);
+
+            while (candidate < current)
+            {
+                if (dist[v].compare_exchange_weak(current, candidate, std::memory_order_relaxed))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        };
+
+    auto bucketOf = [delta](double distance)
+        {
+            return static_cast<std::size_t>(std::floor(distance / delta));
+        };
+
+    // Buckets hold vertices whose distance was lowered into them; a vertex
+    // whose distance was later lowered again is skipped when its old
+    // bucket comes up.  Within a round, lastQueued keeps each vertex from
+    // being processed twice.  Only nonempty buckets are stored, so very
+    // uneven weights don't leave long runs of empty ones.
+    std::map<std::size_t, std::vector<int>> buckets{{0, {startIndex}}};
+    std::vector<int> lastQueued(n, -1);
+    int round = 0;
+
+    int threads = std::max(1, threadCount);
+    std::vector<std::vector<int>> lowered(threads);
+
+    // relaxArcs() relaxes the light or heavy arcs leaving the given vertices
+    // in parallel, leaving the vertices whose distances were lowered in
+    // "lowered".  Starting threads costs more than relaxing a few hundred
+    // vertices' arcs, so small sets are handled by the calling thread.
+    constexpr std::size_t verticesPerThread = 1024;
+
+    auto relaxArcs = [&](const std::vector<int>& vertices, bool light)
+        {
+            int useThreads = static_cast<int>(std::min<std::size_t>(
+                threads, 1 + vertices.size() / verticesPerThread));
+
+            parallelForChunks(0, vertices.size(), useThreads,
+                [&](int begin, int end, int chunk)
+                {
+                    for (int i = begin; i < end; ++i)
+                    {
+                        int v = vertices[i];
+                        double d = dist[v].load(std::memory_order_relaxed);
+
+                        for (int arc = graph.arcBegin(v); arc < graph.arcEnd(v); ++arc)
+                        {
+                            double weight = arcWeights[arc];
+
+                            if ((weight <= delta) == light && lower(graph.arcHead(arc), d + weight))
+                            {
+                                lowered[chunk].push_back(graph.arcHead(arc));
+                            }
+                        }
+                    }
+                });
+        };
+
+    // distribute() files the lowered vertices into their buckets, returning
+    // those that belong in the current one.
+    auto distribute = [&](std::size_t current)
+        {
+            std::vector<int> again;
+            round++;
+
+            for (std::vector<int>& list : lowered)
+            {
+                for (int v : list)
+                {
+                    std::size_t bucket = bucketOf(dist[v].load(std::memory_order_relaxed));
+
+                    if (bucket == current)
+                    {
+                        if (lastQueued[v] != round)
+                        {
+                            lastQueued[v] = round;
+                            again.push_back(v);
+                        }
+                    }
+                    else
+                    {
+                        buckets[bucket].push_back(v);
+                    }
+                }
+
+                list.clear();
+            }
+
+            return again;
+        };
+
+    while (!buckets.empty())
+    {
+        std::size_t current = buckets.begin()->first;
+        std::vector<int> candidates = std::move(buckets.begin()->second);
+        buckets.erase(buckets.begin());
+
+        std::vector<int> frontier;
+        round++;
+
+        for (int v : candidates)
+        {
+            if (lastQueued[v] != round && bucketOf(dist[v].load(std::memory_order_relaxed)) == current)
+            {
+                lastQueued[v] = round;
+                frontier.push_back(v);
+            }
+        }
+
+        // Every vertex settled in this bucket relaxes its heavy arcs once
+        // the bucket is done.  (That can only refill the bucket through
+        // rounding, but if it does, the bucket is processed again.)
+        while (!frontier.empty())
+        {
+            std::vector<int> settled;
+
+            while (!frontier.empty())
+            {
+                settled.insert(settled.end(), frontier.begin(), frontier.end());
+                relaxArcs(frontier, true);
+                frontier = distribute(current);
+            }
+
+            std::sort(settled.begin(), settled.end());
+            settled.erase(std::unique(settled.begin(), settled.end()), settled.end());
+
+            relaxArcs(settled, false);
+            frontier = distribute(current);
+        }
+    }
+
+    SingleSourcePaths paths;
+    paths.distances.resize(n);
+    paths.predecessors.assign(n, -1);
+
+    parallelFor(0, n, threads,
+        [&](int v)
+        {
+            paths.distances[v] = dist[v].load(std::memory_order_relaxed);
+        });
+
+    // Reverse arcs are listed in arc order, so they're grouped by tail in
+    // increasing order, and the first tight arc comes from the lowest tail.
+    // Arcs of weight zero are skipped at first, since they could make
+    // vertices at the same distance each other's predecessors.
+    std::vector<char> onlyZeroArcs(n, 0);
+
+    parallelFor(0, n, threads,
+        [&](int v)
+        {
+            double d = paths.distances[v];
+
+            if (v == startIndex || d == infinity)
+            {
+                return;
+            }
+
+            for (int i = graph.reverseArcBegin(v); i < graph.reverseArcEnd(v); ++i)
+            {
+                int arc = graph.reverseArc(i);
+                int tail = graph.arcTail(arc);
+
+                if (paths.distances[tail] < d && paths.distances[tail] + arcWeights[arc] == d)
+                {
+                    paths.predecessors[v] = tail;
+                    return;
+                }
+            }
+
+            onlyZeroArcs[v] = 1;
+        });
+
+    // The rest are reached through weight-zero arcs from vertices at the
+    // same distance; a breadth-first search along them from the vertices
+    // that already have predecessors attaches them without forming cycles.
+    std::vector<int> queue;
+
+    for (int v = 0; v < n; ++v)
+    {
+        if (!onlyZeroArcs[v] && paths.distances[v] != infinity)
+        {
+            queue.push_back(v);
+        }
+    }
+
+    for (std::size_t i = 0; i < queue.size(); ++i)
+    {
+        int u = queue[i];
+
+        for (int arc = graph.arcBegin(u); arc < graph.arcEnd(u); ++arc)
+        {
+            int v = graph.arcHead(arc);
+
+            if (onlyZeroArcs[v] && paths.distances[u] + arcWeights[arc] == paths.distances[v])
+            {
+                onlyZeroArcs[v] = 0;
+                paths.predecessors[v] = u;
+                queue.push_back(v);
+            }
+        }
+    }
+
+    return paths;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::map<int, int> findShortestPathsInParallel(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& d, int startVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc, int threadCount)
+{
+    if (!d.hasVertex(startVertex))
+    {
+        throw DigraphException{"findShortestPathsInParallel(): the startVertex is not valid."};
+    }
+
+    CompactDigraph graph{d};
+    int start = graph.index(startVertex);
+
+    SingleSourcePaths paths = deltaSteppingShortestPaths(
+        graph, graph.arcWeights(d, edgeWeightFunc), start, threadCount);
+
+    std::map<int, int> result;
+
+    for (int v = 0; v < graph.vertexCount(); ++v)
+    {
+        int predecessor = paths.predecessors[v] == -1 ? v : paths.predecessors[v];
+        result.emplace_hint(result.end(), graph.vertexNumber(v), graph.vertexNumber(predecessor));
+    }
+
+    return result;
+}
+
+
+
+#endif
@@ -18,18 +18,26 @@
 // In general, directed graphs are all the same, except in the sense
 // that they store different kinds of information about each vertex and
 // about each edge; these two types are the type parameters to the
-// Digraph class template.
+// Digraph class template.  A third, optional type parameter is the
+// allocator that the Digraph gets all of its memory from, which makes it
+// possible to keep a whole Digraph in an Arena (see ArenaAllocator.hpp).
 
 #ifndef DIGRAPH_HPP
 #define DIGRAPH_HPP
 
+#include <cstddef>
 #include <exception>
 #include <functional>
+#include <iterator>
+#include <limits>
 #include <list>
 #include <map>
+#include <memory>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 #include <algorithm>
+#include "EdgeIndex.hpp"
 #include <queue>
 #include <iostream>
 
@@ -67,15 +75,134 @@ struct DigraphEdge
 
 
 
-// A DigraphVertex includes two things: a VertexInfo object and a list of
-// its outgoing edges.  Because different kinds of Digraphs store different
-// kinds of vertex and edge information, DigraphVertex is a struct template.
+// A DigraphPath describes one path through a Digraph, as the sequence of
+// vertex numbers it visits (starting with the first vertex and ending with
+// the last one) and its total length under whatever edge weights were used
+// to find it.  A path that doesn't exist has an infinite length and no
+// vertices.
 
-template <typename VertexInfo, typename EdgeInfo>
+struct DigraphPath
+{
+    double length;
+    std::vector<int> vertices;
+};
+
+
+
+// A DigraphVertex includes three things: a VertexInfo object, a list of
+// its outgoing edges, and the vertex numbers of the "from" vertices of its
+// incoming edges (which is what lets a vertex be removed without searching
+// the whole graph for edges that point to it).  Because different kinds of
+// Digraphs store different kinds of vertex and edge information,
+// DigraphVertex is a struct template.  Both lists get their memory from the
+// Digraph's allocator.
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator = std::allocator<char>>
 struct DigraphVertex
 {
+    using EdgeList = std::list<
+        DigraphEdge<EdgeInfo>,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<DigraphEdge<EdgeInfo>>>;
+
+    using IncomingList = std::vector<
+        int, typename std::allocator_traits<Allocator>::template rebind_alloc<int>>;
+
     VertexInfo vinfo;
-    std::list<DigraphEdge<EdgeInfo>> edges;
+    EdgeList edges;
+    IncomingList incoming;
+};
+
+
+
+// A DigraphRange is a pair of iterators over something stored inside a
+// Digraph, which can be used in a range-based for loop.  It refers to the
+// Digraph instead of copying anything out of it, so it costs nothing to
+// make, but it's only good until the Digraph changes.
+
+template <typename Iterator>
+class DigraphRange
+{
+public:
+    DigraphRange(Iterator first, Iterator last);
+
+    Iterator begin() const;
+    Iterator end() const;
+    bool empty() const;
+
+
+private:
+    Iterator first_;
+    Iterator last_;
+};
+
+
+
+// A DigraphVertexIterator walks through the vertices of a Digraph in
+// increasing order of vertex number, giving the vertex number of each.
+
+template <typename AdjacencyIterator>
+class DigraphVertexIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = int;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const int*;
+    using reference = const int&;
+
+    DigraphVertexIterator() = default;
+    explicit DigraphVertexIterator(AdjacencyIterator current);
+
+    const int& operator*() const;
+    DigraphVertexIterator& operator++();
+    DigraphVertexIterator operator++(int);
+
+    bool operator==(const DigraphVertexIterator& other) const;
+    bool operator!=(const DigraphVertexIterator& other) const;
+
+
+private:
+    AdjacencyIterator current_;
+};
+
+
+
+// A DigraphEdgeIterator walks through every edge of a Digraph, giving a
+// reference to each DigraphEdge: first the edges leaving the vertex with
+// the smallest vertex number, in the order they were added, then those
+// leaving the next vertex, and so on.  That's the same order in which
+// edges() lists them.
+
+template <typename AdjacencyIterator, typename EdgeIterator>
+class DigraphEdgeIterator
+{
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = typename std::iterator_traits<EdgeIterator>::value_type;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const value_type*;
+    using reference = const value_type&;
+
+    DigraphEdgeIterator() = default;
+    DigraphEdgeIterator(AdjacencyIterator vertex, AdjacencyIterator lastVertex);
+
+    reference operator*() const;
+    pointer operator->() const;
+    DigraphEdgeIterator& operator++();
+    DigraphEdgeIterator operator++(int);
+
+    bool operator==(const DigraphEdgeIterator& other) const;
+    bool operator!=(const DigraphEdgeIterator& other) const;
+
+
+private:
+    AdjacencyIterator vertex_;
+    AdjacencyIterator lastVertex_;
+    EdgeIterator edge_;
+
+    // skipFinishedVertices() moves on from vertices whose edges have all
+    // been visited, until it reaches an edge or runs out of vertices.
+    void skipFinishedVertices();
 };
 
 
@@ -86,6 +213,9 @@ struct DigraphVertex
 // * VertexInfo, which specifies the kind of object stored for each vertex
 // * EdgeInfo, which specifies the kind of object stored for each edge
 //
+// and optionally an Allocator, which is rebound to allocate whatever the
+// Digraph stores; it's std::allocator unless you say otherwise.
+//
 // You'll need to implement the member functions declared here; each has a
 // comment detailing how it is intended to work.
 //
@@ -93,14 +223,33 @@ struct DigraphVertex
 // Vertex numbers are not necessarily sequential and they are not necessarily
 // zero- or one-based.
 
-template <typename VertexInfo, typename EdgeInfo>
+template <typename VertexInfo, typename EdgeInfo, typename Allocator = std::allocator<char>>
 class Digraph
 {
+private:
+    using Vertex = DigraphVertex<VertexInfo, EdgeInfo, Allocator>;
+    using AdjacencyList = std::map<
+        int, Vertex, std::less<int>,
+        typename std::allocator_traits<Allocator>::template rebind_alloc<std::pair<const int, Vertex>>>;
+
+
 public:
+    // These are the kinds of iterators that the views returned by
+    // vertexRange(), edgeRange(), and incomingRange() are made of.
+    using VertexIterator = DigraphVertexIterator<typename AdjacencyList::const_iterator>;
+    using EdgeIterator = DigraphEdgeIterator<
+        typename AdjacencyList::const_iterator, typename Vertex::EdgeList::const_iterator>;
+    using OutgoingEdgeIterator = typename Vertex::EdgeList::const_iterator;
+    using IncomingIterator = typename Vertex::IncomingList::const_iterator;
+
     // The default constructor initializes a new, empty Digraph so that
     // contains no vertices and no edges.
     Digraph();
 
+    // This constructor initializes a new, empty Digraph that gets all of
+    // its memory from the given allocator.
+    explicit Digraph(const Allocator& allocator);
+
     // The copy constructor initializes a new Digraph to be a deep copy
     // of another one (i.e., any change to the copy will not affect the
     // original).
@@ -138,17 +287,48 @@ public:
     // not exist, a DigraphException is thrown instead.
     std::vector<std::pair<int, int>> edges(int vertex) const;
 
+    // vertexRange() is like vertices(), except that it returns a view of
+    // the vertex numbers instead of copying them into a std::vector.
+    DigraphRange<VertexIterator> vertexRange() const;
+
+    // edgeRange() returns a view of every edge in this Digraph, in the
+    // same order that edges() lists them, with each edge's EdgeInfo.
+    // Nothing is copied, so it's the fastest way to visit every edge.
+    DigraphRange<EdgeIterator> edgeRange() const;
+
+    // This overload of edgeRange() returns a view of the edges outgoing
+    // from the given vertex number, with their EdgeInfo.  If the given
+    // vertex does not exist, a DigraphException is thrown instead.
+    DigraphRange<OutgoingEdgeIterator> edgeRange(int vertex) const;
+
+    // incomingRange() returns a view of the "from" vertex numbers of the
+    // edges incoming to the given vertex number, in no particular order.
+    // If the given vertex does not exist, a DigraphException is thrown
+    // instead.
+    DigraphRange<IncomingIterator> incomingRange(int vertex) const;
+
     // vertexInfo() returns the VertexInfo object belonging to the vertex
     // with the given vertex number.  If that vertex does not exist, a
     // DigraphException is thrown instead.
     VertexInfo vertexInfo(int vertex) const;
 
+    // vertexInfoRef() is like vertexInfo(), except that it returns a
+    // reference to the VertexInfo object stored in the Digraph instead
+    // of a copy of it.  The reference stays valid until the vertex is
+    // removed.
+    const VertexInfo& vertexInfoRef(int vertex) const;
+
     // edgeInfo() returns the EdgeInfo object belonging to the edge
     // with the given "from" and "to" vertex numbers.  If either of those
     // vertices does not exist *or* if the edge does not exist, a
     // DigraphException is thrown instead.
     EdgeInfo edgeInfo(int fromVertex, int toVertex) const;
 
+    // edgeInfoRef() is like edgeInfo(), except that it returns a reference
+    // to the EdgeInfo object stored in the Digraph instead of a copy of
+    // it.  The reference stays valid until the edge is removed.
+    const EdgeInfo& edgeInfoRef(int fromVertex, int toVertex) const;
+
     // addVertex() adds a vertex to the Digraph with the given vertex
     // number and VertexInfo object.  If there is already a vertex in
     // the graph with the given vertex number, a DigraphException is
@@ -162,6 +342,13 @@ public:
     // present in the graph, a DigraphException is thrown instead.
     void addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo);
 
+    // updateEdgeInfo() replaces the EdgeInfo object belonging to the
+    // edge with the given "from" and "to" vertex numbers, leaving the
+    // edge itself in place.  If either of those vertices does not
+    // exist *or* if the edge does not exist, a DigraphException is
+    // thrown instead.
+    void updateEdgeInfo(int fromVertex, int toVertex, const EdgeInfo& einfo);
+
     // removeVertex() removes the vertex (and all of its incoming
     // and outgoing edges) with the given vertex number from the
     // Digraph.  If the vertex does not exist already, a DigraphException
@@ -175,6 +362,10 @@ public:
     // thrown instead.
     void removeEdge(int fromVertex, int toVertex);
 
+    // hasVertex() returns true if the graph has a vertex with the given
+    // vertex number.
+    bool hasVertex(int vertex) const;
+
     // vertexCount() returns the number of vertices in the graph.
     int vertexCount() const noexcept;
 
@@ -207,6 +398,45 @@ public:
         int startVertex,
         std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
 
+    // findShortestPathsTo() is like findShortestPaths(), except that it
+    // only determines the shortest paths to the given target vertices,
+    // stopping as soon as every one of them has been reached, rather than
+    // exploring the whole graph.  The result maps each target's vertex
+    // number to its path from the start vertex (see DigraphPath), which
+    // has no vertices and an infinite length if the target can't be
+    // reached.  If the start vertex or any target does not exist, a
+    // DigraphException is thrown.
+    std::map<int, DigraphPath> findShortestPathsTo(
+        int startVertex, const std::vector<int>& targetVertices,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // findShortestPathsFrom() is the mirror image of findShortestPathsTo():
+    // it determines the shortest paths from each of the given source
+    // vertices to one end vertex, by searching backward from the end
+    // vertex along incoming edges, and stops as soon as every source has
+    // been reached.  The result maps each source's vertex number to its
+    // path to the end vertex.  If the end vertex or any source does not
+    // exist, a DigraphException is thrown.
+    std::map<int, DigraphPath> findShortestPathsFrom(
+        const std::vector<int>& sourceVertices, int endVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // findNearest() determines which of the given candidate vertices are
+    // closest to the start vertex, stopping as soon as it has found k of
+    // them.  It returns the paths from the start vertex to (at most) the
+    // k nearest reachable candidates, nearest first.  If the start vertex
+    // or any candidate does not exist, a DigraphException is thrown.
+    std::vector<DigraphPath> findNearest(
+        int startVertex, const std::vector<int>& candidateVertices, int k,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
+    // findNearestTo() is the mirror image of findNearest(): it determines
+    // which of the candidate vertices can reach the end vertex soonest,
+    // returning their paths to the end vertex, nearest first.
+    std::vector<DigraphPath> findNearestTo(
+        const std::vector<int>& candidateVertices, int endVertex, int k,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc) const;
+
 
 private:
     // Add whatever member variables you think you need here.  One
@@ -214,7 +444,12 @@ private:
     // and the values are DigraphVertex<VertexInfo, EdgeInfo> objects.
     int vertexCount_;
     int edgeCount_;
-    std::map<int, DigraphVertex<VertexInfo, EdgeInfo>> adjList;
+    AdjacencyList adjList;
+
+    // edgeIndex_ finds the position of each edge in its "from" vertex's
+    // list of edges, so that looking up, updating, or removing an edge
+    // doesn't have to scan that list.
+    EdgeIndex<typename Vertex::EdgeList::iterator, Allocator> edgeIndex_;
 
 
     // You can also feel free to add any additional member functions
@@ -223,90 +458,276 @@ private:
 
     // DFTr() depth first traverses the graph starting at the given
     // vertex, and returns the number of vertices it visits
-    void DFTr(const std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>& g, 
-        const DigraphVertex<VertexInfo, EdgeInfo>& v, int num,
+    void DFTr(const AdjacencyList& g,
+        const Vertex& v, int num,
         std::vector<int>& visited, int& find) const;
 
+    // rebuildEdgeIndex() indexes every edge in adjList from scratch.
+    void rebuildEdgeIndex();
+
+    // forgetIncoming() removes one occurrence of the given "from" vertex
+    // from the given vertex's list of incoming edges.
+    static void forgetIncoming(Vertex& vertex, int fromVertex);
+
+    // searchFrom() runs Dijkstra's algorithm from the given origin, along
+    // outgoing edges or, if backward is true, along incoming edges.  As
+    // each vertex is settled, it calls settled(vertex, distance, path),
+    // where path(vertex) returns the settled vertex's DigraphPath (from
+    // the origin or, if backward, to it); the search stops as soon as
+    // settled() returns false.  Only the vertices the search reaches are
+    // ever recorded, so a search that stops early never touches the rest
+    // of the graph.
+    template <typename Settled>
+    void searchFrom(
+        int origin, bool backward,
+        const std::function<double(const EdgeInfo&)>& edgeWeightFunc,
+        Settled settled) const;
+
+    // checkVertices() throws a DigraphException with the given message
+    // unless every one of the given vertices exists.
+    void checkVertices(const std::vector<int>& vertices, const char* message) const;
+
 };
 
 
 
+template <typename Iterator>
+DigraphRange<Iterator>::DigraphRange(Iterator first, Iterator last)
+    : first_{first}, last_{last}
+{
+}
+
+
+template <typename Iterator>
+Iterator DigraphRange<Iterator>::begin() const
+{
+    return first_;
+}
+
+
+template <typename Iterator>
+Iterator DigraphRange<Iterator>::end() const
+{
+    return last_;
+}
+
+
+template <typename Iterator>
+bool DigraphRange<Iterator>::empty() const
+{
+    return first_ == last_;
+}
+
+
+
+template <typename AdjacencyIterator>
+DigraphVertexIterator<AdjacencyIterator>::DigraphVertexIterator(AdjacencyIterator current)
+    : current_{current}
+{
+}
+
+
+template <typename AdjacencyIterator>
+const int& DigraphVertexIterator<AdjacencyIterator>::operator*() const
+{
+    return current_->first;
+}
+
+
+template <typename AdjacencyIterator>
+DigraphVertexIterator<AdjacencyIterator>& DigraphVertexIterator<AdjacencyIterator>::operator++()
+{
+    ++current_;
+    return *this;
+}
+
+
+template <typename AdjacencyIterator>
+DigraphVertexIterator<AdjacencyIterator> DigraphVertexIterator<AdjacencyIterator>::operator++(int)
+{
+    DigraphVertexIterator old = *this;
+    ++current_;
+    return old;
+}
+
+
+template <typename AdjacencyIterator>
+bool DigraphVertexIterator<AdjacencyIterator>::operator==(const DigraphVertexIterator& other) const
+{
+    return current_ == other.current_;
+}
+
+
+template <typename AdjacencyIterator>
+bool DigraphVertexIterator<AdjacencyIterator>::operator!=(const DigraphVertexIterator& other) const
+{
+    return current_ != other.current_;
+}
+
+
+
+template <typename AdjacencyIterator, typename EdgeIterator>
+DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::DigraphEdgeIterator(
+    AdjacencyIterator vertex, AdjacencyIterator lastVertex)
+    : vertex_{vertex}, lastVertex_{lastVertex}
+{
+    if (vertex_ != lastVertex_)
+    {
+        edge_ = vertex_->second.edges.begin();
+        skipFinishedVertices();
+    }
+}
+
+
+template <typename AdjacencyIterator, typename EdgeIterator>
+typename DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::reference
+DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::operator*() const
+{
+    return *edge_;
+}
+
+
+template <typename AdjacencyIterator, typename EdgeIterator>
+typename DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::pointer
+DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::operator->() const
+{
+    return &*edge_;
+}
+
+
+template <typename AdjacencyIterator, typename EdgeIterator>
+DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>&
+DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::operator++()
+{
+    ++edge_;
+    skipFinishedVertices();
+    return *this;
+}
+
+
+template <typename AdjacencyIterator, typename EdgeIterator>
+DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>
+DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::operator++(int)
+{
+    DigraphEdgeIterator old = *this;
+    ++*this;
+    return old;
+}
+
+
+template <typename AdjacencyIterator, typename EdgeIterator>
+bool DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::operator==(
+    const DigraphEdgeIterator& other) const
+{
+    // Once every vertex has been visited, there's no edge to compare.
+    return vertex_ == other.vertex_ && (vertex_ == lastVertex_ || edge_ == other.edge_);
+}
+
+
+template <typename AdjacencyIterator, typename EdgeIterator>
+bool DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::operator!=(
+    const DigraphEdgeIterator& other) const
+{
+    return !(*this == other);
+}
+
+
+template <typename AdjacencyIterator, typename EdgeIterator>
+void DigraphEdgeIterator<AdjacencyIterator, EdgeIterator>::skipFinishedVertices()
+{
+    while (edge_ == vertex_->second.edges.end())
+    {
+        if (++vertex_ == lastVertex_)
+        {
+            return;
+        }
+
+        edge_ = vertex_->second.edges.begin();
+    }
+}
+
+
+
 // You'll need to implement the member functions below.  There's enough
 // code in place to make them compile, but they'll all need to do the
 // correct thing instead.
 
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>::Digraph()
-    : vertexCount_{0}, edgeCount_{0}
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+Digraph<VertexInfo, EdgeInfo, Allocator>::Digraph()
+    : vertexCount_{0}, edgeCount_{0}, edgeIndex_{Allocator{adjList.get_allocator()}}
 {
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>::Digraph(const Digraph& d)
-    : vertexCount_{0}, edgeCount_{0}
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+Digraph<VertexInfo, EdgeInfo, Allocator>::Digraph(const Allocator& allocator)
+    : vertexCount_{0}, edgeCount_{0}, adjList(typename AdjacencyList::allocator_type{allocator}),
+      edgeIndex_{allocator}
 {
-    std::map<int, DigraphVertex<VertexInfo, EdgeInfo>> tempList;
-    for (auto& [num, vertex] : d.adjList)
-    {
-        // copy constructors of corresponding objects are called
-        tempList[num] = vertex;
-    }
-    adjList = tempList;
-    vertexCount_ = d.vertexCount_;
-    edgeCount_ = d.edgeCount_;
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>::Digraph(Digraph&& d) noexcept
-    : vertexCount_{0}, edgeCount_{0}
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+Digraph<VertexInfo, EdgeInfo, Allocator>::Digraph(const Digraph& d)
+    : vertexCount_{d.vertexCount_}, edgeCount_{d.edgeCount_}, adjList(d.adjList),
+      edgeIndex_{Allocator{adjList.get_allocator()}}
+{
+    // copy constructors of corresponding objects are called, and the
+    // copy gets its memory from the same kind of allocator; the index
+    // has to be rebuilt, because it refers to the original's edges
+    rebuildEdgeIndex();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+Digraph<VertexInfo, EdgeInfo, Allocator>::Digraph(Digraph&& d) noexcept
+    : vertexCount_{0}, edgeCount_{0}, adjList(std::move(d.adjList)),
+      edgeIndex_{std::move(d.edgeIndex_)}
 {
     std::swap(vertexCount_, d.vertexCount_);
     std::swap(edgeCount_, d.edgeCount_);
-    std::swap(adjList, d.adjList);
+    d.adjList.clear();
+    d.edgeIndex_.clear();
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>::~Digraph() noexcept
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+Digraph<VertexInfo, EdgeInfo, Allocator>::~Digraph() noexcept
 {
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(const Digraph& d)
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+Digraph<VertexInfo, EdgeInfo, Allocator>& Digraph<VertexInfo, EdgeInfo, Allocator>::operator=(const Digraph& d)
 {
     if (this != &d)
     {
-        std::map<int, DigraphVertex<VertexInfo, EdgeInfo>> tempList;
-        for (auto& [num, vertex] : d.adjList)
-        {
-            tempList[num] = vertex;
-        }
-        adjList = tempList;
+        AdjacencyList tempList(d.adjList);
+        adjList = std::move(tempList);
         vertexCount_ = d.vertexCount_;
         edgeCount_ = d.edgeCount_;
+        rebuildEdgeIndex();
     }
     return *this;
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-Digraph<VertexInfo, EdgeInfo>& Digraph<VertexInfo, EdgeInfo>::operator=(Digraph&& d) noexcept
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+Digraph<VertexInfo, EdgeInfo, Allocator>& Digraph<VertexInfo, EdgeInfo, Allocator>::operator=(Digraph&& d) noexcept
 {
     if (this != &d)
     {
         std::swap(vertexCount_, d.vertexCount_);
         std::swap(edgeCount_, d.edgeCount_);
         std::swap(adjList, d.adjList); 
+        std::swap(edgeIndex_, d.edgeIndex_);
     }
     return *this;
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-std::vector<int> Digraph<VertexInfo, EdgeInfo>::vertices() const
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::vector<int> Digraph<VertexInfo, EdgeInfo, Allocator>::vertices() const
 {
     std::vector<int> result;
     for (auto& [num, vertex] : adjList)
@@ -317,8 +738,8 @@ std::vector<int> Digraph<VertexInfo, EdgeInfo>::vertices() const
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges() const
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo, Allocator>::edges() const
 {
     std::vector<std::pair<int, int>> result;
     for (auto& [num, vertex] : adjList)
@@ -332,8 +753,8 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges() const
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges(int vertex) const
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo, Allocator>::edges(int vertex) const
 {
     if (adjList.find(vertex) == adjList.end())
     {
@@ -351,8 +772,8 @@ std::vector<std::pair<int, int>> Digraph<VertexInfo, EdgeInfo>::edges(int vertex
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-VertexInfo Digraph<VertexInfo, EdgeInfo>::vertexInfo(int vertex) const
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+VertexInfo Digraph<VertexInfo, EdgeInfo, Allocator>::vertexInfo(int vertex) const
 {
     if (adjList.find(vertex) == adjList.end())
     {
@@ -362,27 +783,99 @@ VertexInfo Digraph<VertexInfo, EdgeInfo>::vertexInfo(int vertex) const
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-EdgeInfo Digraph<VertexInfo, EdgeInfo>::edgeInfo(int fromVertex, int toVertex) const
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+const VertexInfo& Digraph<VertexInfo, EdgeInfo, Allocator>::vertexInfoRef(int vertex) const
 {
-    if (adjList.find(fromVertex) == adjList.end() || 
+    auto found = adjList.find(vertex);
+
+    if (found == adjList.end())
+    {
+        throw DigraphException{"Digraph vertexInfoRef(): the given vertex does not exist."};
+    }
+
+    return found->second.vinfo;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+DigraphRange<typename Digraph<VertexInfo, EdgeInfo, Allocator>::IncomingIterator>
+Digraph<VertexInfo, EdgeInfo, Allocator>::incomingRange(int vertex) const
+{
+    auto found = adjList.find(vertex);
+
+    if (found == adjList.end())
+    {
+        throw DigraphException{"Digraph incomingRange(): the given vertex does not exist."};
+    }
+
+    return {found->second.incoming.begin(), found->second.incoming.end()};
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+const EdgeInfo& Digraph<VertexInfo, EdgeInfo, Allocator>::edgeInfoRef(int fromVertex, int toVertex) const
+{
+    if (auto edge = edgeIndex_.find(fromVertex, toVertex))
+    {
+        return (*edge)->einfo;
+    }
+
+    throw DigraphException{"Digraph edgeInfoRef(): the edge does not exist."};
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+DigraphRange<typename Digraph<VertexInfo, EdgeInfo, Allocator>::VertexIterator>
+Digraph<VertexInfo, EdgeInfo, Allocator>::vertexRange() const
+{
+    return {VertexIterator{adjList.begin()}, VertexIterator{adjList.end()}};
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+DigraphRange<typename Digraph<VertexInfo, EdgeInfo, Allocator>::EdgeIterator>
+Digraph<VertexInfo, EdgeInfo, Allocator>::edgeRange() const
+{
+    return {EdgeIterator{adjList.begin(), adjList.end()}, EdgeIterator{adjList.end(), adjList.end()}};
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+DigraphRange<typename Digraph<VertexInfo, EdgeInfo, Allocator>::OutgoingEdgeIterator>
+Digraph<VertexInfo, EdgeInfo, Allocator>::edgeRange(int vertex) const
+{
+    auto found = adjList.find(vertex);
+
+    if (found == adjList.end())
+    {
+        throw DigraphException{"Digraph edgeRange(): the given vertex does not exist."};
+    }
+
+    return {found->second.edges.begin(), found->second.edges.end()};
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+EdgeInfo Digraph<VertexInfo, EdgeInfo, Allocator>::edgeInfo(int fromVertex, int toVertex) const
+{
+    if (auto edge = edgeIndex_.find(fromVertex, toVertex))
+    {
+        return (*edge)->einfo;
+    }
+    else if (adjList.find(fromVertex) == adjList.end() || 
         adjList.find(toVertex) == adjList.end())
     {
         throw DigraphException{"Digraph edgeInfo(): either of vertices does not exist."};
     }
     else
     {
-        for (auto& edge : adjList.at(fromVertex).edges)
-        {
-            if (edge.toVertex == toVertex) return edge.einfo;
-        }
         throw DigraphException{"Digraph edgeInfo(): the edge does not exist."};
     }
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::addVertex(int vertex, const VertexInfo& vinfo)
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::addVertex(int vertex, const VertexInfo& vinfo)
 {
     if (adjList.find(vertex) != adjList.end())
     {
@@ -393,112 +886,170 @@ void Digraph<VertexInfo, EdgeInfo>::addVertex(int vertex, const VertexInfo& vinf
     }
     else
     {
-        DigraphVertex<VertexInfo, EdgeInfo> v;
-        v.vinfo = vinfo;
-        adjList[vertex] = v;
+        typename Vertex::EdgeList edges(
+            typename Vertex::EdgeList::allocator_type{adjList.get_allocator()});
+        typename Vertex::IncomingList incoming(
+            typename Vertex::IncomingList::allocator_type{adjList.get_allocator()});
+        adjList.emplace(vertex, Vertex{vinfo, std::move(edges), std::move(incoming)});
         vertexCount_++;
     }
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo)
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::addEdge(int fromVertex, int toVertex, const EdgeInfo& einfo)
 {
-    if (adjList.find(fromVertex) == adjList.end() || 
-        adjList.find(toVertex) == adjList.end())
+    auto from = adjList.find(fromVertex);
+    auto to = adjList.find(toVertex);
+
+    if (from == adjList.end() || to == adjList.end())
     {
         throw DigraphException{"Digraph addEdge(): one of the vertices does not exist."};
     }
+    else if (edgeIndex_.find(fromVertex, toVertex) != nullptr)
+    {
+        throw DigraphException{"Digraph addEdge(): the same edge is already present in the graph."};
+    }
     else
     {   
-        for (auto& edge : adjList[fromVertex].edges)
+        typename Vertex::EdgeList& edges = from->second.edges;
+        edges.push_back(DigraphEdge<EdgeInfo>{fromVertex, toVertex, einfo});
+
+        try
         {
-            if (edge.fromVertex == fromVertex && edge.toVertex == toVertex)
-            {
-                throw DigraphException{"Digraph addEdge(): the same edge is already present in the graph."};
-            }
+            edgeIndex_.insert(fromVertex, toVertex, std::prev(edges.end()));
+        }
+        catch (...)
+        {
+            edges.pop_back();
+            throw;
+        }
+
+        try
+        {
+            to->second.incoming.push_back(fromVertex);
+        }
+        catch (...)
+        {
+            edgeIndex_.erase(fromVertex, toVertex);
+            edges.pop_back();
+            throw;
         }
-        DigraphEdge<EdgeInfo> e{fromVertex, toVertex, einfo};
-        adjList[fromVertex].edges.push_back(e);
+
         edgeCount_++;
     }
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::removeVertex(int vertex)
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::updateEdgeInfo(int fromVertex, int toVertex, const EdgeInfo& einfo)
 {
-    if (adjList.find(vertex) == adjList.end())
+    if (auto edge = edgeIndex_.find(fromVertex, toVertex))
+    {
+        (*edge)->einfo = einfo;
+    }
+    else if (adjList.find(fromVertex) == adjList.end() || 
+        adjList.find(toVertex) == adjList.end())
+    {
+        throw DigraphException{"Digraph updateEdgeInfo(): either of vertices does not exist."};
+    }
+    else
+    {
+        throw DigraphException{"Digraph updateEdgeInfo(): the edge does not exist."};
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::removeVertex(int vertex)
+{
+    auto found = adjList.find(vertex);
+
+    if (found == adjList.end())
     {
         throw DigraphException{"Digraph removeVertex(): the vertex does not exist already."};
     }
     else
     {
-        edgeCount_ -= adjList[vertex].edges.size();
-        adjList.erase(vertex);
-        vertexCount_--;
-        for (auto& [num, dVertex] : adjList)
+        // Only the vertex's neighbors need to change: the ones its edges
+        // point to forget where those edges came from, and the ones whose
+        // edges point to it lose those edges.
+        Vertex& removed = found->second;
+
+        for (auto& edge : removed.edges)
         {
-            for (auto edge = dVertex.edges.begin(); edge!= dVertex.edges.end();
-                ++edge)
+            edgeIndex_.erase(vertex, edge.toVertex);
+
+            if (edge.toVertex != vertex)
             {
-                if ((*edge).toVertex == vertex)
-                {
-                    dVertex.edges.erase(edge);
-                    edgeCount_--;
-                    break;
-                }
+                forgetIncoming(adjList.at(edge.toVertex), vertex);
+            }
+        }
+
+        edgeCount_ -= removed.edges.size();
+
+        for (int from : removed.incoming)
+        {
+            if (from != vertex)
+            {
+                adjList.at(from).edges.erase(*edgeIndex_.find(from, vertex));
+                edgeIndex_.erase(from, vertex);
+                edgeCount_--;
             }
         }
+
+        adjList.erase(found);
+        vertexCount_--;
     }
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::removeEdge(int fromVertex, int toVertex)
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::removeEdge(int fromVertex, int toVertex)
 {
     if (adjList.find(fromVertex) == adjList.end() || 
         adjList.find(toVertex) == adjList.end())
     {
         throw DigraphException{"Digraph removeEdge(): one of the vertices does not exist."};
     }
+    else if (auto edge = edgeIndex_.find(fromVertex, toVertex))
+    {
+        adjList.at(fromVertex).edges.erase(*edge);
+        edgeIndex_.erase(fromVertex, toVertex);
+        forgetIncoming(adjList.at(toVertex), fromVertex);
+        edgeCount_--;
+    }
     else
     {
-        std::list<DigraphEdge<EdgeInfo>>& dEdges = adjList[fromVertex].edges;
-        int oldSz = dEdges.size();
-        dEdges.remove_if([&](DigraphEdge<EdgeInfo>& e)
-            {return e.toVertex == toVertex;});
-        int newSz = dEdges.size();
-       
-        if (newSz < oldSz)
-        {
-            edgeCount_--;
-        }
-        else
-        {
-            throw DigraphException{"Digraph removeEdge(): the edge is not already present in the graph."};
-        }
+        throw DigraphException{"Digraph removeEdge(): the edge is not already present in the graph."};
     }
 
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-int Digraph<VertexInfo, EdgeInfo>::vertexCount() const noexcept
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+bool Digraph<VertexInfo, EdgeInfo, Allocator>::hasVertex(int vertex) const
+{
+    return adjList.find(vertex) != adjList.end();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+int Digraph<VertexInfo, EdgeInfo, Allocator>::vertexCount() const noexcept
 {
     return vertexCount_;
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-int Digraph<VertexInfo, EdgeInfo>::edgeCount() const noexcept
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+int Digraph<VertexInfo, EdgeInfo, Allocator>::edgeCount() const noexcept
 {
     return edgeCount_;
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-int Digraph<VertexInfo, EdgeInfo>::edgeCount(int vertex) const
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+int Digraph<VertexInfo, EdgeInfo, Allocator>::edgeCount(int vertex) const
 {
     if (adjList.find(vertex) == adjList.end())
     {
@@ -508,10 +1059,10 @@ int Digraph<VertexInfo, EdgeInfo>::edgeCount(int vertex) const
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-void Digraph<VertexInfo, EdgeInfo>::DFTr(
-    const std::map<int, DigraphVertex<VertexInfo, EdgeInfo>>& g, 
-    const DigraphVertex<VertexInfo, EdgeInfo>& v, int num,
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::DFTr(
+    const AdjacencyList& g,
+    const Vertex& v, int num,
     std::vector<int>& visited, int& find) const
 {
     visited.push_back(num);
@@ -528,8 +1079,35 @@ void Digraph<VertexInfo, EdgeInfo>::DFTr(
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-bool Digraph<VertexInfo, EdgeInfo>::isStronglyConnected() const
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::rebuildEdgeIndex()
+{
+    edgeIndex_.clear();
+    edgeIndex_.reserve(edgeCount_);
+
+    for (auto& [num, vertex] : adjList)
+    {
+        for (auto edge = vertex.edges.begin(); edge != vertex.edges.end(); ++edge)
+        {
+            edgeIndex_.insert(edge->fromVertex, edge->toVertex, edge);
+        }
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::forgetIncoming(Vertex& vertex, int fromVertex)
+{
+    // The order of incoming edges doesn't matter, so the last one can
+    // fill the gap.
+    auto found = std::find(vertex.incoming.begin(), vertex.incoming.end(), fromVertex);
+    *found = vertex.incoming.back();
+    vertex.incoming.pop_back();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+bool Digraph<VertexInfo, EdgeInfo, Allocator>::isStronglyConnected() const
 {
     for (auto& [num, vertex] : adjList)
     {
@@ -543,8 +1121,8 @@ bool Digraph<VertexInfo, EdgeInfo>::isStronglyConnected() const
 }
 
 
-template <typename VertexInfo, typename EdgeInfo>
-std::map<int, int> Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::map<int, int> Digraph<VertexInfo, EdgeInfo, Allocator>::findShortestPaths(
     int startVertex,
     std::function<double(const EdgeInfo&)> edgeWeightFunc) const
 {
@@ -594,6 +1172,244 @@ std::map<int, int> Digraph<VertexInfo, EdgeInfo>::findShortestPaths(
 }
 
 
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::map<int, DigraphPath> Digraph<VertexInfo, EdgeInfo, Allocator>::findShortestPathsTo(
+    int startVertex, const std::vector<int>& targetVertices,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    checkVertices({startVertex}, "Digraph findShortestPathsTo(): the startVertex is not valid.");
+    checkVertices(targetVertices, "Digraph findShortestPathsTo(): a targetVertex is not valid.");
+
+    std::map<int, DigraphPath> result;
+
+    for (int target : targetVertices)
+    {
+        result[target] = DigraphPath{std::numeric_limits<double>::infinity(), {}};
+    }
+
+    std::size_t remaining = result.size();
+
+    if (remaining > 0)
+    {
+        searchFrom(startVertex, false, edgeWeightFunc,
+            [&](int vNum, double, auto path)
+            {
+                auto target = result.find(vNum);
+
+                if (target != result.end())
+                {
+                    target->second = path(vNum);
+                    remaining--;
+                }
+
+                return remaining > 0;
+            });
+    }
+
+    return result;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::map<int, DigraphPath> Digraph<VertexInfo, EdgeInfo, Allocator>::findShortestPathsFrom(
+    const std::vector<int>& sourceVertices, int endVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    checkVertices({endVertex}, "Digraph findShortestPathsFrom(): the endVertex is not valid.");
+    checkVertices(sourceVertices, "Digraph findShortestPathsFrom(): a sourceVertex is not valid.");
+
+    std::map<int, DigraphPath> result;
+
+    for (int source : sourceVertices)
+    {
+        result[source] = DigraphPath{std::numeric_limits<double>::infinity(), {}};
+    }
+
+    std::size_t remaining = result.size();
+
+    if (remaining > 0)
+    {
+        searchFrom(endVertex, true, edgeWeightFunc,
+            [&](int vNum, double, auto path)
+            {
+                auto source = result.find(vNum);
+
+                if (source != result.end())
+                {
+                    source->second = path(vNum);
+                    remaining--;
+                }
+
+                return remaining > 0;
+            });
+    }
+
+    return result;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::vector<DigraphPath> Digraph<VertexInfo, EdgeInfo, Allocator>::findNearest(
+    int startVertex, const std::vector<int>& candidateVertices, int k,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    checkVertices({startVertex}, "Digraph findNearest(): the startVertex is not valid.");
+    checkVertices(candidateVertices, "Digraph findNearest(): a candidateVertex is not valid.");
+
+    std::unordered_set<int> candidates{candidateVertices.begin(), candidateVertices.end()};
+    std::vector<DigraphPath> result;
+
+    if (k > 0 && !candidates.empty())
+    {
+        searchFrom(startVertex, false, edgeWeightFunc,
+            [&](int vNum, double, auto path)
+            {
+                if (candidates.count(vNum) != 0)
+                {
+                    result.push_back(path(vNum));
+                }
+
+                return static_cast<int>(result.size()) < k
+                    && result.size() < candidates.size();
+            });
+    }
+
+    return result;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::vector<DigraphPath> Digraph<VertexInfo, EdgeInfo, Allocator>::findNearestTo(
+    const std::vector<int>& candidateVertices, int endVertex, int k,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc) const
+{
+    checkVertices({endVertex}, "Digraph findNearestTo(): the endVertex is not valid.");
+    checkVertices(candidateVertices, "Digraph findNearestTo(): a candidateVertex is not valid.");
+
+    std::unordered_set<int> candidates{candidateVertices.begin(), candidateVertices.end()};
+    std::vector<DigraphPath> result;
+
+    if (k > 0 && !candidates.empty())
+    {
+        searchFrom(endVertex, true, edgeWeightFunc,
+            [&](int vNum, double, auto path)
+            {
+                if (candidates.count(vNum) != 0)
+                {
+                    result.push_back(path(vNum));
+                }
+
+                return static_cast<int>(result.size()) < k
+                    && result.size() < candidates.size();
+            });
+    }
+
+    return result;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+template <typename Settled>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::searchFrom(
+    int origin, bool backward,
+    const std::function<double(const EdgeInfo&)>& edgeWeightFunc,
+    Settled settled) const
+{
+    // d holds each reached vertex's distance from (or, if backward, to) the
+    // origin, and previous the vertex before it on the way from the origin.
+    std::map<int, double> d;
+    std::map<int, int> previous;
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+
+    auto path = [&](int vNum)
+        {
+            DigraphPath p{d.at(vNum), {}};
+
+            for (int v = vNum; ; v = previous.at(v))
+            {
+                p.vertices.push_back(v);
+
+                if (v == origin)
+                {
+                    break;
+                }
+            }
+
+            // Following previous leads back to the origin, which is where
+            // a forward path starts but a backward path ends.
+            if (!backward)
+            {
+                std::reverse(p.vertices.begin(), p.vertices.end());
+            }
+
+            return p;
+        };
+
+    auto relax = [&](int vNum, double candidate, int via)
+        {
+            auto found = d.find(vNum);
+
+            if (found == d.end() || candidate < found->second)
+            {
+                d[vNum] = candidate;
+                previous[vNum] = via;
+                pq.push({candidate, vNum});
+            }
+        };
+
+    d[origin] = 0.0;
+    previous[origin] = origin;
+    pq.push({0.0, origin});
+
+    while (!pq.empty())
+    {
+        auto [dist, vNum] = pq.top();
+        pq.pop();
+
+        if (dist > d.at(vNum))
+        {
+            continue;
+        }
+
+        if (!settled(vNum, dist, path))
+        {
+            return;
+        }
+
+        if (backward)
+        {
+            for (int from : adjList.at(vNum).incoming)
+            {
+                relax(from, dist + edgeWeightFunc((*edgeIndex_.find(from, vNum))->einfo), vNum);
+            }
+        }
+        else
+        {
+            for (auto& edge : adjList.at(vNum).edges)
+            {
+                relax(edge.toVertex, dist + edgeWeightFunc(edge.einfo), vNum);
+            }
+        }
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+void Digraph<VertexInfo, EdgeInfo, Allocator>::checkVertices(
+    const std::vector<int>& vertices, const char* message) const
+{
+    for (int vertex : vertices)
+    {
+        if (adjList.find(vertex) == adjList.end())
+        {
+            throw DigraphException{message};
+        }
+    }
+}
+
+
 
 #endif
 
@@ -0,0 +1,261 @@
+// DistanceTable.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called DistanceTable, a dense matrix
+// of shortest distances from a list of sources to a list of targets, and
+// distanceTable(), which fills one in using a customized contraction
+// hierarchy and bucket-based many-to-many search.
+//
+// A shortest path from s to t in a hierarchy goes up from s to some vertex
+// x and then down to t, so it's found by an upward search from s meeting a
+// backward upward search from t.  Rather than pairing every source with
+// every target, the backward search from each target is run once, leaving
+// a note ("bucket entry") at every vertex x it reaches saying which target
+// it came from and how far away it is.  Then the upward search from each
+// source just reads the buckets of the vertices it reaches, so the cost
+// is one upward search per source and per target, plus one step per
+// bucket entry met.
+//
+// Both kinds of searches are independent of each other, so the backward
+// searches are split across threads, and then so are the sources, each
+// thread writing its own rows of the table.
+
+#ifndef DISTANCETABLE_HPP
+#define DISTANCETABLE_HPP
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "CustomizableContractionHierarchy.hpp"
+#include "Digraph.hpp"
+#include "ParallelFor.hpp"
+
+
+
+class DistanceTable
+{
+public:
+    // This constructor initializes a table of the given size, with every
+    // distance infinite.
+    DistanceTable(int rowCount, int columnCount);
+
+    // rowCount() and columnCount() return the size of the table.
+    int rowCount() const noexcept;
+    int columnCount() const noexcept;
+
+    // distance() returns (or lets you change) the distance from the source
+    // of the given row to the target of the given column.
+    double distance(int row, int column) const noexcept;
+    double& distance(int row, int column) noexcept;
+
+    // row() returns the distances in the given row, one per column, stored
+    // next to each other.
+    const double* row(int row) const noexcept;
+
+
+private:
+    int rowCount_;
+    int columnCount_;
+    std::vector<double> distances_;
+};
+
+
+
+// distanceTable() returns the shortest distances under the given metric
+// from each of the given source vertex numbers (the rows) to each of the
+// given target vertex numbers (the columns), using up to threadCount
+// threads.  If any of the vertices does not exist, a DigraphException is
+// thrown.
+DistanceTable distanceTable(
+    const CustomizedMetric& metric,
+    const std::vector<int>& sources, const std::vector<int>& targets,
+    int threadCount = defaultThreadCount());
+
+
+
+inline DistanceTable::DistanceTable(int rowCount, int columnCount)
+    : rowCount_{rowCount}, columnCount_{columnCount},
+      distances_(static_cast<std::size_t>(rowCount) * columnCount,
+          std::numeric_limits<double>::infinity())
+{
+}
+
+
+inline int DistanceTable::rowCount() const noexcept
+{
+    return rowCount_;
+}
+
+
+inline int DistanceTable::columnCount() const noexcept
+{
+    return columnCount_;
+}
+
+
+inline double DistanceTable::distance(int row, int column) const noexcept
+{
+    return distances_[static_cast<std::size_t>(row) * columnCount_ + column];
+}
+
+
+inline double& DistanceTable::distance(int row, int column) noexcept
+{
+    return distances_[static_cast<std::size_t>(row) * columnCount_ + column];
+}
+
+
+inline const double* DistanceTable::row(int row) const noexcept
+{
+    return distances_.data() + static_cast<std::size_t>(row) * columnCount_;
+}
+
+
+namespace DistanceTableDetails
+{
+    // upwardSearch() walks up the elimination tree from the given rank,
+    // relaxing upward edges with the metric's upward weights (or downward
+    // weights, for a backward search), and calls reached(rank, distance)
+    // for every rank reached.  dist must be all infinity, and is left
+    // that way.
+    template <typename Reached>
+    void upwardSearch(
+        const CustomizedMetric& metric, int startRank, bool backward,
+        std::vector<double>& dist, Reached reached)
+    {
+        const CustomizableContractionHierarchy& hierarchy = metric.hierarchy();
+        constexpr double infinity = std::numeric_limits<double>::infinity();
+
+        dist[startRank] = 0.0;
+
+        for (int r = startRank; r != -1; r = hierarchy.parent(r))
+        {
+            double d = dist[r];
+            dist[r] = infinity;
+
+            if (d == infinity)
+            {
+                continue;
+            }
+
+            reached(r, d);
+
+            for (int edge = hierarchy.upEdgeBegin(r); edge < hierarchy.upEdgeEnd(r); ++edge)
+            {
+                double weight = backward ? metric.downWeight(edge) : metric.upWeight(edge);
+                double& head = dist[hierarchy.edgeHead(edge)];
+                head = std::min(head, d + weight);
+            }
+        }
+    }
+}
+
+
+inline DistanceTable distanceTable(
+    const CustomizedMetric& metric,
+    const std::vector<int>& sources, const std::vector<int>& targets,
+    int threadCount)
+{
+    using namespace DistanceTableDetails;
+
+    const CustomizableContractionHierarchy& hierarchy = metric.hierarchy();
+    const CompactDigraph& graph = hierarchy.graph();
+    int n = hierarchy.vertexCount();
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    std::vector<int> sourceRanks;
+    std::vector<int> targetRanks;
+
+    for (int vertex : sources)
+    {
+        sourceRanks.push_back(hierarchy.rank(graph.index(vertex)));
+    }
+
+    for (int vertex : targets)
+    {
+        targetRanks.push_back(hierarchy.rank(graph.index(vertex)));
+    }
+
+    // The backward searches, one list of (rank, distance) pairs per target.
+    std::vector<std::vector<std::pair<int, double>>> reached(targets.size());
+
+    parallelForChunks(0, targets.size(), threadCount,
+        [&](int begin, int end, int)
+        {
+            std::vector<double> dist(n, infinity);
+
+            for (int column = begin; column < end; ++column)
+            {
+                upwardSearch(metric, targetRanks[column], true, dist,
+                    [&](int rank, double d) { reached[column].push_back({rank, d}); });
+            }
+        });
+
+    // The buckets, stored back to back by rank: the bucket of rank r is in
+    // positions firstEntry[r] up to, but not including, firstEntry[r + 1].
+    struct BucketEntry
+    {
+        int column;
+        double distance;
+    };
+
+    std::vector<int> firstEntry(n + 1, 0);
+
+    for (const auto& list : reached)
+    {
+        for (auto& [rank, d] : list)
+        {
+            firstEntry[rank + 1]++;
+        }
+    }
+
+    for (int r = 0; r < n; ++r)
+    {
+        firstEntry[r + 1] += firstEntry[r];
+    }
+
+    std::vector<BucketEntry> entries(firstEntry[n]);
+    std::vector<int> next(firstEntry.begin(), firstEntry.end() - 1);
+
+    for (std::size_t column = 0; column < reached.size(); ++column)
+    {
+        for (auto& [rank, d] : reached[column])
+        {
+            entries[next[rank]++] = {static_cast<int>(column), d};
+        }
+
+        std::vector<std::pair<int, double>>().swap(reached[column]);
+    }
+
+    // The forward searches, each scanning the buckets it reaches.
+    DistanceTable table(sources.size(), targets.size());
+
+    parallelForChunks(0, sources.size(), threadCount,
+        [&](int begin, int end, int)
+        {
+            std::vector<double> dist(n, infinity);
+
+            for (int row = begin; row < end; ++row)
+            {
+                upwardSearch(metric, sourceRanks[row], false, dist,
+                    [&](int rank, double d)
+                    {
+                        for (int i = firstEntry[rank]; i < firstEntry[rank + 1]; ++i)
+                        {
+                            double& best = table.distance(row, entries[i].column);
+                            best = std::min(best, d + entries[i].distance);
+                        }
+                    });
+            }
+        });
+
+    return table;
+}
+
+
+
+#endif
@@ -0,0 +1,274 @@
+// EdgeIndex.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class template called EdgeIndex, a hash table
+// that maps an edge's ("from" vertex, "to" vertex) pair to a Value, which a
+// Digraph uses to find an edge without scanning the list of edges leaving
+// its "from" vertex.
+//
+// The table uses open addressing with linear probing: every entry lives in
+// one flat array, and a lookup examines consecutive slots starting at the
+// one its key hashes to, which are usually in the same cache line.  The
+// table is kept at most half full, so lookups stay short, and removing an
+// entry shifts later entries of the same run back into its place instead of
+// leaving a "tombstone" behind, so removals never slow down lookups.
+
+#ifndef EDGEINDEX_HPP
+#define EDGEINDEX_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+
+template <typename Value, typename Allocator = std::allocator<char>>
+class EdgeIndex
+{
+public:
+    // This constructor initializes an empty EdgeIndex that gets its memory
+    // from the given allocator.
+    explicit EdgeIndex(const Allocator& allocator = Allocator{});
+
+    // size() returns the number of edges in the index.
+    std::size_t size() const noexcept;
+
+    // find() returns a pointer to the Value associated with the given edge,
+    // or nullptr if the edge isn't in the index.  The pointer is only good
+    // until the next call to insert() or erase().
+    Value* find(int fromVertex, int toVertex) noexcept;
+    const Value* find(int fromVertex, int toVertex) const noexcept;
+
+    // insert() associates the given Value with the given edge and returns
+    // true, unless the edge is already in the index, in which case it
+    // changes nothing and returns false.
+    bool insert(int fromVertex, int toVertex, const Value& value);
+
+    // erase() removes the given edge from the index, returning true if it
+    // was there and false if it wasn't.
+    bool erase(int fromVertex, int toVertex) noexcept;
+
+    // clear() removes every edge from the index.
+    void clear() noexcept;
+
+    // reserve() makes room for the given number of edges, so that adding
+    // that many won't need the table to grow.
+    void reserve(std::size_t count);
+
+
+private:
+    struct Slot
+    {
+        std::uint64_t key;
+        Value value;
+        bool occupied;
+    };
+
+    using SlotAllocator = typename std::allocator_traits<Allocator>::template rebind_alloc<Slot>;
+
+    std::vector<Slot, SlotAllocator> slots_;
+    std::size_t size_;
+    int shift_;
+
+    static std::uint64_t key(int fromVertex, int toVertex) noexcept;
+
+    // home() returns the slot where a search for the given key begins.
+    std::size_t home(std::uint64_t key) const noexcept;
+
+    // findSlot() returns the slot holding the given key, or the empty slot
+    // where it would go if it isn't there.  The table must not be empty.
+    std::size_t findSlot(std::uint64_t key) const noexcept;
+
+    // rehash() moves every entry into a table with the given number of
+    // slots, which must be a power of two.
+    void rehash(std::size_t slotCount);
+};
+
+
+
+template <typename Value, typename Allocator>
+EdgeIndex<Value, Allocator>::EdgeIndex(const Allocator& allocator)
+    : slots_(SlotAllocator{allocator}), size_{0}, shift_{64}
+{
+}
+
+
+template <typename Value, typename Allocator>
+std::size_t EdgeIndex<Value, Allocator>::size() const noexcept
+{
+    return size_;
+}
+
+
+template <typename Value, typename Allocator>
+Value* EdgeIndex<Value, Allocator>::find(int fromVertex, int toVertex) noexcept
+{
+    const EdgeIndex& self = *this;
+    return const_cast<Value*>(self.find(fromVertex, toVertex));
+}
+
+
+template <typename Value, typename Allocator>
+const Value* EdgeIndex<Value, Allocator>::find(int fromVertex, int toVertex) const noexcept
+{
+    if (size_ == 0)
+    {
+        return nullptr;
+    }
+
+    const Slot& slot = slots_[findSlot(key(fromVertex, toVertex))];
+    return slot.occupied ? &slot.value : nullptr;
+}
+
+
+template <typename Value, typename Allocator>
+bool EdgeIndex<Value, Allocator>::insert(int fromVertex, int toVertex, const Value& value)
+{
+    if (2 * (size_ + 1) > slots_.size())
+    {
+        rehash(slots_.empty() ? 16 : 2 * slots_.size());
+    }
+
+    std::uint64_t k = key(fromVertex, toVertex);
+    Slot& slot = slots_[findSlot(k)];
+
+    if (slot.occupied)
+    {
+        return false;
+    }
+
+    slot.key = k;
+    slot.value = value;
+    slot.occupied = true;
+    size_++;
+
+    return true;
+}
+
+
+template <typename Value, typename Allocator>
+bool EdgeIndex<Value, Allocator>::erase(int fromVertex, int toVertex) noexcept
+{
+    if (size_ == 0)
+    {
+        return false;
+    }
+
+    std::size_t mask = slots_.size() - 1;
+    std::size_t hole = findSlot(key(fromVertex, toVertex));
+
+    if (!slots_[hole].occupied)
+    {
+        return false;
+    }
+
+    // Move back any later entry of the same run that could have been
+    // placed in the hole, so that no search has to look past it.
+    for (std::size_t next = (hole + 1) & mask; slots_[next].occupied; next = (next + 1) & mask)
+    {
+        std::size_t wanted = home(slots_[next].key);
+
+        if (((next - wanted) & mask) >= ((next - hole) & mask))
+        {
+            slots_[hole] = std::move(slots_[next]);
+            hole = next;
+        }
+    }
+
+    slots_[hole].occupied = false;
+    size_--;
+
+    return true;
+}
+
+
+template <typename Value, typename Allocator>
+void EdgeIndex<Value, Allocator>::clear() noexcept
+{
+    for (Slot& slot : slots_)
+    {
+        slot.occupied = false;
+    }
+
+    size_ = 0;
+}
+
+
+template <typename Value, typename Allocator>
+void EdgeIndex<Value, Allocator>::reserve(std::size_t count)
+{
+    std::size_t slotCount = slots_.empty() ? 16 : slots_.size();
+
+    while (slotCount < 2 * count)
+    {
+        slotCount *= 2;
+    }
+
+    if (slotCount > slots_.size())
+    {
+        rehash(slotCount);
+    }
+}
+
+
+template <typename Value, typename Allocator>
+std::uint64_t EdgeIndex<Value, Allocator>::key(int fromVertex, int toVertex) noexcept
+{
+    return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(fromVertex)) << 32)
+        | static_cast<std::uint32_t>(toVertex);
+}
+
+
+template <typename Value, typename Allocator>
+std::size_t EdgeIndex<Value, Allocator>::home(std::uint64_t key) const noexcept
+{
+    // Fibonacci hashing: multiplying by 2^64 divided by the golden ratio
+    // mixes every bit of the key into the high bits that are kept.
+    return static_cast<std::size_t>((key * 0x9E3779B97F4A7C15ULL) >> shift_);
+}
+
+
+template <typename Value, typename Allocator>
+std::size_t EdgeIndex<Value, Allocator>::findSlot(std::uint64_t key) const noexcept
+{
+    std::size_t mask = slots_.size() - 1;
+    std::size_t i = home(key);
+
+    while (slots_[i].occupied && slots_[i].key != key)
+    {
+        i = (i + 1) & mask;
+    }
+
+    return i;
+}
+
+
+template <typename Value, typename Allocator>
+void EdgeIndex<Value, Allocator>::rehash(std::size_t slotCount)
+{
+    std::vector<Slot, SlotAllocator> old(slotCount, Slot{0, Value{}, false}, slots_.get_allocator());
+    std::swap(old, slots_);
+
+    shift_ = 64;
+
+    for (std::size_t n = slotCount; n > 1; n /= 2)
+    {
+        shift_--;
+    }
+
+    for (Slot& slot : old)
+    {
+        if (slot.occupied)
+        {
+            slots_[findSlot(slot.key)] = std::move(slot);
+        }
+    }
+}
+
+
+
+#endif
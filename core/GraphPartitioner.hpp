@@ -0,0 +1,428 @@
+// GraphPartitioner.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares partitionGraph(), which splits the vertices
+// of a CompactDigraph into cells of bounded size with few arcs running
+// between them, at several nested levels: every cell on one level lies
+// entirely inside one cell of the next level up.  Multi-level overlay
+// routing and locality-improving vertex orders are both built on it.
+//
+// Only the structure of the graph is used (arcs are treated as undirected
+// and no coordinates are needed).  Each level is found by size-constrained
+// label propagation: every vertex starts out in a cell of its own, and in
+// each round every vertex looks at the cells of its neighbors and moves
+// to the one it's most strongly connected to, as long as that cell has
+// room.  The resulting clusters are contracted into single weighted
+// vertices and clustered again, until they stop growing; those are the
+// cells of the level.  The next level starts from the contracted graph
+// of the one below it, which is what makes the levels nest.
+//
+// The decisions within a round are computed in parallel, then applied in
+// vertex order, so the result doesn't depend on the number of threads.
+
+#ifndef GRAPHPARTITIONER_HPP
+#define GRAPHPARTITIONER_HPP
+
+#include <algorithm>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "ParallelFor.hpp"
+
+
+
+// A GraphPartition stores which cell each vertex (by its CompactDigraph
+// index) belongs to on each level.  Level 0 has the smallest cells.
+class GraphPartition
+{
+public:
+    // This constructor takes the cell of every vertex on every level.
+    explicit GraphPartition(std::vector<std::vector<int>> cells);
+
+    // levelCount() returns the number of levels.
+    int levelCount() const noexcept;
+
+    // cellCount() returns the number of cells on the given level; cells
+    // are numbered consecutively from zero.
+    int cellCount(int level) const noexcept;
+
+    // cell() returns the cell the vertex with the given index belongs to
+    // on the given level.
+    int cell(int level, int index) const noexcept;
+
+    // cells() returns the cell of every vertex on the given level.
+    const std::vector<int>& cells(int level) const noexcept;
+
+
+private:
+    std::vector<std::vector<int>> cells_;
+    std::vector<int> cellCounts_;
+};
+
+
+
+// partitionGraph() partitions the given graph into nested levels of cells,
+// where the cells on level i have at most maxCellSizes[i] vertices.  The
+// sizes must be positive and increasing; otherwise, a DigraphException is
+// thrown.  Up to threadCount threads are used.
+GraphPartition partitionGraph(
+    const CompactDigraph& g, const std::vector<int>& maxCellSizes,
+    int threadCount = defaultThreadCount());
+
+
+// cutArcCount() returns the number of arcs of the given graph whose
+// endpoints are in different cells on the given level.
+int cutArcCount(const CompactDigraph& g, const GraphPartition& partition, int level);
+
+
+
+inline GraphPartition::GraphPartition(std::vector<std::vector<int>> cells)
+    : cells_{std::move(cells)}
+{
+    for (const std::vector<int>& level : cells_)
+    {
+        cellCounts_.push_back(
+            level.empty() ? 0 : *std::max_element(level.begin(), level.end()) + 1);
+    }
+}
+
+
+inline int GraphPartition::levelCount() const noexcept
+{
+    return cells_.size();
+}
+
+
+inline int GraphPartition::cellCount(int level) const noexcept
+{
+    return cellCounts_[level];
+}
+
+
+inline int GraphPartition::cell(int level, int index) const noexcept
+{
+    return cells_[level][index];
+}
+
+
+inline const std::vector<int>& GraphPartition::cells(int level) const noexcept
+{
+    return cells_[level];
+}
+
+
+namespace GraphPartitionerDetails
+{
+    // A WeightedGraph is the undirected graph label propagation runs on:
+    // on the first level it's the original graph, and on later levels each
+    // vertex stands for a whole cell of the level below.
+    struct WeightedGraph
+    {
+        std::vector<int> vertexWeights;
+        std::vector<int> firstEdge;
+        std::vector<int> neighbors;
+        std::vector<int> edgeWeights;
+    };
+
+
+    // A WeightedPair is one (from, to, weight) entry used while building
+    // a WeightedGraph.
+    struct WeightedPair
+    {
+        int from;
+        int to;
+        int weight;
+    };
+
+
+    // makeWeightedGraph() builds a WeightedGraph with the given vertex
+    // weights from a list of weighted pairs, combining duplicate pairs
+    // into one edge by adding up their weights.
+    inline WeightedGraph makeWeightedGraph(
+        std::vector<int> vertexWeights, std::vector<WeightedPair>& pairs)
+    {
+        std::sort(pairs.begin(), pairs.end(),
+            [](const WeightedPair& a, const WeightedPair& b)
+            {
+                return a.from < b.from || (a.from == b.from && a.to < b.to);
+            });
+
+        WeightedGraph graph;
+        graph.vertexWeights = std::move(vertexWeights);
+        graph.firstEdge.assign(graph.vertexWeights.size() + 1, 0);
+
+        for (std::size_t i = 0; i < pairs.size(); ++i)
+        {
+            if (i > 0 && pairs[i].from == pairs[i - 1].from && pairs[i].to == pairs[i - 1].to)
+            {
+                graph.edgeWeights.back() += pairs[i].weight;
+            }
+            else
+            {
+                graph.neighbors.push_back(pairs[i].to);
+                graph.edgeWeights.push_back(pairs[i].weight);
+                graph.firstEdge[pairs[i].from + 1]++;
+            }
+        }
+
+        for (std::size_t v = 0; v < graph.vertexWeights.size(); ++v)
+        {
+            graph.firstEdge[v + 1] += graph.firstEdge[v];
+        }
+
+        return graph;
+    }
+
+
+    // propagateLabels() clusters the vertices of the given graph so no
+    // cluster weighs more than maxWeight, returning a cluster number from
+    // zero for every vertex.
+    inline std::vector<int> propagateLabels(
+        const WeightedGraph& graph, int maxWeight, int threadCount, int rounds = 16)
+    {
+        int n = graph.vertexWeights.size();
+
+        std::vector<int> label(n);
+        std::vector<long long> clusterWeight(n);
+
+        for (int v = 0; v < n; ++v)
+        {
+            label[v] = v;
+            clusterWeight[v] = graph.vertexWeights[v];
+        }
+
+        std::vector<int> proposal(n);
+        std::vector<char> gained(n);
+        std::vector<char> lost(n);
+
+        for (int round = 0; round < rounds; ++round)
+        {
+            // Every vertex picks the neighboring cluster it has the most
+            // edge weight into, among those with room for it; it only
+            // leaves its own cluster for a strictly better one, and ties
+            // between others go to the smaller cluster number.
+            parallelForChunks(0, n, threadCount,
+                [&](int begin, int end, int)
+                {
+                    std::vector<std::pair<int, int>> weightTo;
+
+                    for (int v = begin; v < end; ++v)
+                    {
+                        weightTo.clear();
+
+                        for (int e = graph.firstEdge[v]; e < graph.firstEdge[v + 1]; ++e)
+                        {
+                            weightTo.push_back({label[graph.neighbors[e]], graph.edgeWeights[e]});
+                        }
+
+                        std::sort(weightTo.begin(), weightTo.end());
+
+                        int best = label[v];
+                        long long bestWeight = 0;
+
+                        for (std::size_t i = 0; i < weightTo.size(); )
+                        {
+                            int l = weightTo[i].first;
+                            long long total = 0;
+
+                            for (; i < weightTo.size() && weightTo[i].first == l; ++i)
+                            {
+                                total += weightTo[i].second;
+                            }
+
+                            if (l == label[v])
+                            {
+                                if (total >= bestWeight)
+                                {
+                                    best = l;
+                                    bestWeight = total;
+                                }
+                            }
+                            else if (total > bestWeight
+                                && clusterWeight[l] + graph.vertexWeights[v] <= maxWeight)
+                            {
+                                best = l;
+                                bestWeight = total;
+                            }
+                        }
+
+                        proposal[v] = best;
+                    }
+                });
+
+            // Moves are applied in vertex order, re-checking the size
+            // limit, since several vertices may have picked the same
+            // cluster at once.  A cluster that gained a vertex this round
+            // can't also lose one (and vice versa), which keeps neighbors
+            // from endlessly trading places.
+            std::fill(gained.begin(), gained.end(), 0);
+            std::fill(lost.begin(), lost.end(), 0);
+
+            int moves = 0;
+
+            for (int v = 0; v < n; ++v)
+            {
+                int from = label[v];
+                int to = proposal[v];
+
+                if (to != from && !gained[from] && !lost[to]
+                    && clusterWeight[to] + graph.vertexWeights[v] <= maxWeight)
+                {
+                    clusterWeight[from] -= graph.vertexWeights[v];
+                    clusterWeight[to] += graph.vertexWeights[v];
+                    label[v] = to;
+                    lost[from] = 1;
+                    gained[to] = 1;
+                    moves++;
+                }
+            }
+
+            if (moves == 0)
+            {
+                break;
+            }
+        }
+
+        // renumber the clusters consecutively
+        std::vector<int> number(n, -1);
+        int clusters = 0;
+
+        for (int v = 0; v < n; ++v)
+        {
+            if (number[label[v]] == -1)
+            {
+                number[label[v]] = clusters++;
+            }
+
+            label[v] = number[label[v]];
+        }
+
+        return label;
+    }
+
+
+    // contractClusters() returns the graph that results from merging each
+    // cluster of the given graph into a single vertex, whose weight is the
+    // total weight of the cluster.
+    inline WeightedGraph contractClusters(
+        const WeightedGraph& graph, const std::vector<int>& cluster, int clusters)
+    {
+        std::vector<int> weights(clusters, 0);
+
+        for (std::size_t v = 0; v < cluster.size(); ++v)
+        {
+            weights[cluster[v]] += graph.vertexWeights[v];
+        }
+
+        std::vector<WeightedPair> pairs;
+
+        for (std::size_t v = 0; v < cluster.size(); ++v)
+        {
+            for (int e = graph.firstEdge[v]; e < graph.firstEdge[v + 1]; ++e)
+            {
+                int from = cluster[v];
+                int to = cluster[graph.neighbors[e]];
+
+                if (from != to)
+                {
+                    pairs.push_back({from, to, graph.edgeWeights[e]});
+                }
+            }
+        }
+
+        return makeWeightedGraph(std::move(weights), pairs);
+    }
+}
+
+
+inline GraphPartition partitionGraph(
+    const CompactDigraph& g, const std::vector<int>& maxCellSizes, int threadCount)
+{
+    using namespace GraphPartitionerDetails;
+
+    for (std::size_t i = 0; i < maxCellSizes.size(); ++i)
+    {
+        if (maxCellSizes[i] < 1 || (i > 0 && maxCellSizes[i] <= maxCellSizes[i - 1]))
+        {
+            throw DigraphException{"partitionGraph(): cell sizes must be positive and increasing."};
+        }
+    }
+
+    int n = g.vertexCount();
+
+    std::vector<WeightedPair> pairs;
+    pairs.reserve(2 * g.arcCount());
+
+    for (int arc = 0; arc < g.arcCount(); ++arc)
+    {
+        if (g.arcTail(arc) != g.arcHead(arc))
+        {
+            pairs.push_back({g.arcTail(arc), g.arcHead(arc), 1});
+            pairs.push_back({g.arcHead(arc), g.arcTail(arc), 1});
+        }
+    }
+
+    WeightedGraph graph = makeWeightedGraph(std::vector<int>(n, 1), pairs);
+
+    // nodeOf[v] is the vertex of the current WeightedGraph that the
+    // original vertex v has been contracted into.
+    std::vector<int> nodeOf(n);
+
+    for (int v = 0; v < n; ++v)
+    {
+        nodeOf[v] = v;
+    }
+
+    std::vector<std::vector<int>> cells;
+
+    for (int maxCellSize : maxCellSizes)
+    {
+        // Label propagation alone stalls once clusters are a few vertices
+        // big, so it alternates with contraction: each pass clusters the
+        // clusters of the previous one, until nothing more fits together.
+        for (int pass = 0; pass < 32; ++pass)
+        {
+            std::vector<int> cluster = propagateLabels(graph, maxCellSize, threadCount);
+            int clusters = cluster.empty()
+                ? 0 : *std::max_element(cluster.begin(), cluster.end()) + 1;
+
+            if (clusters == static_cast<int>(cluster.size()))
+            {
+                break;
+            }
+
+            for (int v = 0; v < n; ++v)
+            {
+                nodeOf[v] = cluster[nodeOf[v]];
+            }
+
+            graph = contractClusters(graph, cluster, clusters);
+        }
+
+        cells.push_back(nodeOf);
+    }
+
+    return GraphPartition{std::move(cells)};
+}
+
+
+inline int cutArcCount(const CompactDigraph& g, const GraphPartition& partition, int level)
+{
+    int cut = 0;
+
+    for (int arc = 0; arc < g.arcCount(); ++arc)
+    {
+        if (partition.cell(level, g.arcTail(arc)) != partition.cell(level, g.arcHead(arc)))
+        {
+            cut++;
+        }
+    }
+
+    return cut;
+}
+
+
+
+#endif
@@ -0,0 +1,590 @@
+// HubLabels.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called HubLabels, a hub labeling of a
+// CompactDigraph for one set of arc weights.  Every vertex v gets two
+// labels: a forward label listing "hubs" h along with the distance from v
+// to h, and a backward label listing hubs along with the distance from
+// them to v.  The labels are built so that, for any two vertices s and t,
+// some hub on a shortest path from s to t is in both the forward label of
+// s and the backward label of t.  The distance from s to t is then just
+// the smallest total over the hubs the two labels have in common, which
+// is found by merging them, without searching the graph at all.
+//
+// The labels are computed with pruned landmark labeling: vertices are
+// visited from most to least important, and a Dijkstra search from each
+// one adds it as a hub to the labels of the vertices it reaches, except
+// where the labels built so far already give the right distance (which
+// is where the search is pruned).  A good importance order, such as the
+// ranks of a contraction hierarchy, keeps the labels small.
+//
+// Hubs are numbered by their position in the importance order, so each
+// label is sorted by hub number as it's built.  All of the labels are
+// stored back to back in flat arrays.  Each label entry also remembers
+// the neighboring vertex on the way to (or from) its hub, which is enough
+// to walk a path one arc at a time.
+//
+// HubLabels can be written to a stream in a binary form and read back,
+// so they don't have to be rebuilt every time a program starts.
+
+#ifndef HUBLABELS_HPP
+#define HUBLABELS_HPP
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <queue>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "CustomizableContractionHierarchy.hpp"
+#include "Digraph.hpp"
+
+
+
+class HubLabels
+{
+public:
+    // This constructor builds the labels for the given graph and arc
+    // weights (indexed by arc number), visiting hubs in the given order: a
+    // permutation of the graph's vertex indices, most important first.  If
+    // the number of weights is wrong or the order isn't a permutation, a
+    // DigraphException is thrown.
+    HubLabels(
+        const CompactDigraph& graph, const std::vector<double>& arcWeights,
+        const std::vector<int>& order);
+
+    // read() reads labels in the form written by write().  If the stream
+    // doesn't contain labels in that form, a DigraphException is thrown.
+    static HubLabels read(std::istream& in);
+
+    // write() writes the labels to the given binary stream.
+    void write(std::ostream& out) const;
+
+    // vertexCount() returns the number of vertices labeled.
+    int vertexCount() const noexcept;
+
+    // labelEntryCount() returns the total number of entries in all of the
+    // forward and backward labels.
+    long long labelEntryCount() const noexcept;
+
+    // distance() returns the length of the shortest path between the given
+    // vertex numbers, or infinity if there is none.  If either vertex does
+    // not exist, a DigraphException is thrown.
+    double distance(int startVertex, int endVertex) const;
+
+    // shortestPath() is like distance(), except that it also returns the
+    // sequence of vertex numbers along the path.
+    DigraphPath shortestPath(int startVertex, int endVertex) const;
+
+
+private:
+    HubLabels() = default;
+
+    std::vector<int> vertexNumbers_;
+    std::unordered_map<int, int> indices_;
+    std::vector<int> hubVertices_;
+
+    // The forward label of vertex v is in positions firstForward_[v] up to,
+    // but not including, firstForward_[v + 1]; forwardNext_ is the vertex
+    // after v on the way to the hub (or -1 at the hub itself).  The
+    // backward labels are the same, with backwardPrevious_ being the
+    // vertex before v on the way from the hub.
+    std::vector<int> firstForward_;
+    std::vector<int> forwardHubs_;
+    std::vector<double> forwardDistances_;
+    std::vector<int> forwardNext_;
+
+    std::vector<int> firstBackward_;
+    std::vector<int> backwardHubs_;
+    std::vector<double> backwardDistances_;
+    std::vector<int> backwardPrevious_;
+
+    int index(int vertexNumber, const char* operation) const;
+
+    // bestHub() merges the forward label of s with the backward label of t,
+    // returning the positions of the entries for the best common hub in
+    // each, or (-1, -1) if they have none in common.
+    std::pair<int, int> bestHub(int s, int t) const noexcept;
+
+    // findEntry() returns the position of the entry for the given hub in
+    // one vertex's label, which must have one.
+    static int findEntry(const std::vector<int>& hubs, int begin, int end, int hub) noexcept;
+};
+
+
+
+// hierarchyHubOrder() returns the vertex indices of the given hierarchy's
+// graph from highest rank to lowest, which is a good order to pick hubs in.
+inline std::vector<int> hierarchyHubOrder(const CustomizableContractionHierarchy& hierarchy)
+{
+    std::vector<int> order;
+
+    for (int rank = hierarchy.vertexCount() - 1; rank >= 0; --rank)
+    {
+        order.push_back(hierarchy.vertexAtRank(rank));
+    }
+
+    return order;
+}
+
+
+
+inline HubLabels::HubLabels(
+    const CompactDigraph& graph, const std::vector<double>& arcWeights,
+    const std::vector<int>& order)
+{
+    int n = graph.vertexCount();
+
+    if (static_cast<int>(arcWeights.size()) != graph.arcCount())
+    {
+        throw DigraphException{"HubLabels: there must be one weight per arc."};
+    }
+
+    std::vector<int> position(n, -1);
+
+    if (static_cast<int>(order.size()) != n)
+    {
+        throw DigraphException{"HubLabels: the order must contain every vertex once."};
+    }
+
+    for (int i = 0; i < n; ++i)
+    {
+        if (order[i] < 0 || order[i] >= n || position[order[i]] != -1)
+        {
+            throw DigraphException{"HubLabels: the order must contain every vertex once."};
+        }
+
+        position[order[i]] = i;
+    }
+
+    for (int v = 0; v < n; ++v)
+    {
+        vertexNumbers_.push_back(graph.vertexNumber(v));
+        indices_[graph.vertexNumber(v)] = v;
+    }
+
+    hubVertices_ = order;
+
+    struct Entry
+    {
+        int hub;
+        double distance;
+        int neighbor;
+    };
+
+    std::vector<std::vector<Entry>> forward(n);
+    std::vector<std::vector<Entry>> backward(n);
+
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    // hubDistance[h] holds the distances in the current hub's own label,
+    // so checking whether a vertex can be pruned is a single pass over
+    // that vertex's label.
+    std::vector<double> hubDistance(n, infinity);
+    std::vector<double> dist(n, infinity);
+    std::vector<int> neighbor(n, -1);
+    std::vector<int> touched;
+
+    using QueueEntry = std::pair<double, int>;
+
+    // search() runs one pruned Dijkstra search from the hub with the given
+    // position, forward (filling in backward labels) or backward (filling
+    // in forward labels).
+    auto search = [&](int hub, bool isForward)
+        {
+            int h = order[hub];
+            std::vector<std::vector<Entry>>& hubLabel = isForward ? forward : backward;
+            std::vector<std::vector<Entry>>& reached = isForward ? backward : forward;
+
+            for (const Entry& e : hubLabel[h])
+            {
+                hubDistance[e.hub] = e.distance;
+            }
+
+            std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+            dist[h] = 0.0;
+            touched.push_back(h);
+            pq.push({0.0, h});
+
+            while (!pq.empty())
+            {
+                auto [d, v] = pq.top();
+                pq.pop();
+
+                if (d > dist[v])
+                {
+                    continue;
+                }
+
+                bool covered = false;
+
+                for (const Entry& e : reached[v])
+                {
+                    if (hubDistance[e.hub] + e.distance <= d)
+                    {
+                        covered = true;
+                        break;
+                    }
+                }
+
+                if (covered)
+                {
+                    continue;
+                }
+
+                reached[v].push_back({hub, d, neighbor[v]});
+
+                int begin = isForward ? graph.arcBegin(v) : graph.reverseArcBegin(v);
+                int end = isForward ? graph.arcEnd(v) : graph.reverseArcEnd(v);
+
+                for (int i = begin; i < end; ++i)
+                {
+                    int arc = isForward ? i : graph.reverseArc(i);
+                    int w = isForward ? graph.arcHead(arc) : graph.arcTail(arc);
+                    double candidate = d + arcWeights[arc];
+
+                    if (position[w] > hub && candidate < dist[w])
+                    {
+                        if (dist[w] == infinity)
+                        {
+                            touched.push_back(w);
+                        }
+
+                        dist[w] = candidate;
+                        neighbor[w] = v;
+                        pq.push({candidate, w});
+                    }
+                }
+            }
+
+            for (int v : touched)
+            {
+                dist[v] = infinity;
+                neighbor[v] = -1;
+            }
+
+            touched.clear();
+
+            for (const Entry& e : hubLabel[h])
+            {
+                hubDistance[e.hub] = infinity;
+            }
+        };
+
+    // A search never needs to pass through a vertex that's already been a
+    // hub, since any path through it is covered by that hub's entries.
+    for (int hub = 0; hub < n; ++hub)
+    {
+        search(hub, true);
+        search(hub, false);
+    }
+
+    auto flatten = [n](const std::vector<std::vector<Entry>>& labels,
+        std::vector<int>& first, std::vector<int>& hubs,
+        std::vector<double>& distances, std::vector<int>& neighbors)
+        {
+            first.assign(1, 0);
+
+            for (int v = 0; v < n; ++v)
+            {
+                for (const Entry& e : labels[v])
+                {
+                    hubs.push_back(e.hub);
+                    distances.push_back(e.distance);
+                    neighbors.push_back(e.neighbor);
+                }
+
+                first.push_back(hubs.size());
+            }
+        };
+
+    flatten(forward, firstForward_, forwardHubs_, forwardDistances_, forwardNext_);
+    flatten(backward, firstBackward_, backwardHubs_, backwardDistances_, backwardPrevious_);
+}
+
+
+namespace HubLabelsDetails
+{
+    constexpr char magic[8] = {'H', 'U', 'B', 'L', 'B', 'L', 'S', '1'};
+
+
+    template <typename T>
+    void writeVector(std::ostream& out, const std::vector<T>& v)
+    {
+        std::uint64_t size = v.size();
+        out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+        out.write(reinterpret_cast<const char*>(v.data()), sizeof(T) * v.size());
+    }
+
+
+    template <typename T>
+    std::vector<T> readVector(std::istream& in, std::uint64_t maxSize)
+    {
+        std::uint64_t size = 0;
+        in.read(reinterpret_cast<char*>(&size), sizeof(size));
+
+        if (!in || size > maxSize)
+        {
+            throw DigraphException{"HubLabels read(): the labels are corrupt."};
+        }
+
+        std::vector<T> v(size);
+        in.read(reinterpret_cast<char*>(v.data()), sizeof(T) * size);
+
+        if (!in)
+        {
+            throw DigraphException{"HubLabels read(): the labels are corrupt."};
+        }
+
+        return v;
+    }
+
+
+    // validOffsets() returns true if the given label offsets start at 0
+    // and never decrease, so every label is a real range of entries.
+    inline bool validOffsets(const std::vector<int>& first)
+    {
+        return first.front() == 0 && std::is_sorted(first.begin(), first.end());
+    }
+
+
+    // validIndices() returns true if every one of the given values is a
+    // vertex index less than n, or (where allowed) the -1 that ends a path.
+    inline bool validIndices(const std::vector<int>& values, std::size_t n, bool allowNone)
+    {
+        return std::all_of(
+            values.begin(), values.end(),
+            [&](int v){ return (allowNone && v == -1) || (v >= 0 && static_cast<std::size_t>(v) < n); });
+    }
+}
+
+
+inline HubLabels HubLabels::read(std::istream& in)
+{
+    using namespace HubLabelsDetails;
+
+    char header[sizeof(magic)] = {};
+    in.read(header, sizeof(header));
+
+    if (!in || !std::equal(header, header + sizeof(header), magic))
+    {
+        throw DigraphException{"HubLabels read(): the stream doesn't contain hub labels."};
+    }
+
+    // No vector can be longer than this; it just keeps a corrupt size
+    // from causing an enormous allocation.
+    constexpr std::uint64_t maxSize = std::uint64_t{1} << 40;
+
+    HubLabels labels;
+    labels.vertexNumbers_ = readVector<int>(in, maxSize);
+    labels.hubVertices_ = readVector<int>(in, maxSize);
+    labels.firstForward_ = readVector<int>(in, maxSize);
+    labels.forwardHubs_ = readVector<int>(in, maxSize);
+    labels.forwardDistances_ = readVector<double>(in, maxSize);
+    labels.forwardNext_ = readVector<int>(in, maxSize);
+    labels.firstBackward_ = readVector<int>(in, maxSize);
+    labels.backwardHubs_ = readVector<int>(in, maxSize);
+    labels.backwardDistances_ = readVector<double>(in, maxSize);
+    labels.backwardPrevious_ = readVector<int>(in, maxSize);
+
+    std::size_t n = labels.vertexNumbers_.size();
+    std::size_t forwardSize = labels.forwardHubs_.size();
+    std::size_t backwardSize = labels.backwardHubs_.size();
+
+    if (labels.hubVertices_.size() != n
+        || labels.firstForward_.size() != n + 1 || labels.firstBackward_.size() != n + 1
+        || labels.firstForward_.back() != static_cast<int>(forwardSize)
+        || labels.firstBackward_.back() != static_cast<int>(backwardSize)
+        || labels.forwardDistances_.size() != forwardSize || labels.forwardNext_.size() != forwardSize
+        || labels.backwardDistances_.size() != backwardSize
+        || labels.backwardPrevious_.size() != backwardSize
+        || !validOffsets(labels.firstForward_) || !validOffsets(labels.firstBackward_)
+        || !validIndices(labels.hubVertices_, n, false)
+        || !validIndices(labels.forwardHubs_, n, false) || !validIndices(labels.backwardHubs_, n, false)
+        || !validIndices(labels.forwardNext_, n, true) || !validIndices(labels.backwardPrevious_, n, true))
+    {
+        throw DigraphException{"HubLabels read(): the labels are corrupt."};
+    }
+
+    for (std::size_t v = 0; v < n; ++v)
+    {
+        labels.indices_[labels.vertexNumbers_[v]] = v;
+    }
+
+    return labels;
+}
+
+
+inline void HubLabels::write(std::ostream& out) const
+{
+    using namespace HubLabelsDetails;
+
+    out.write(magic, sizeof(magic));
+    writeVector(out, vertexNumbers_);
+    writeVector(out, hubVertices_);
+    writeVector(out, firstForward_);
+    writeVector(out, forwardHubs_);
+    writeVector(out, forwardDistances_);
+    writeVector(out, forwardNext_);
+    writeVector(out, firstBackward_);
+    writeVector(out, backwardHubs_);
+    writeVector(out, backwardDistances_);
+    writeVector(out, backwardPrevious_);
+}
+
+
+inline int HubLabels::vertexCount() const noexcept
+{
+    return vertexNumbers_.size();
+}
+
+
+inline long long HubLabels::labelEntryCount() const noexcept
+{
+    return static_cast<long long>(forwardHubs_.size()) + backwardHubs_.size();
+}
+
+
+inline double HubLabels::distance(int startVertex, int endVertex) const
+{
+    int s = index(startVertex, "distance");
+    int t = index(endVertex, "distance");
+    auto [forward, backward] = bestHub(s, t);
+
+    return forward == -1
+        ? std::numeric_limits<double>::infinity()
+        : forwardDistances_[forward] + backwardDistances_[backward];
+}
+
+
+inline DigraphPath HubLabels::shortestPath(int startVertex, int endVertex) const
+{
+    int s = index(startVertex, "shortestPath");
+    int t = index(endVertex, "shortestPath");
+    auto [forward, backward] = bestHub(s, t);
+
+    DigraphPath path{std::numeric_limits<double>::infinity(), {}};
+
+    if (forward == -1)
+    {
+        return path;
+    }
+
+    path.length = forwardDistances_[forward] + backwardDistances_[backward];
+
+    // Every vertex on the way to (or from) a hub has that hub in its own
+    // label, so the path can be followed one entry at a time.  Only
+    // damaged labels could be missing an entry or send the path around
+    // in circles.
+    int hub = forwardHubs_[forward];
+    int n = vertexCount();
+
+    auto corrupt = [](){ return DigraphException{"HubLabels shortestPath(): the labels are corrupt."}; };
+
+    for (int v = s, entry = forward; v != -1; )
+    {
+        path.vertices.push_back(vertexNumbers_[v]);
+        v = forwardNext_[entry];
+
+        if (v != -1)
+        {
+            entry = findEntry(forwardHubs_, firstForward_[v], firstForward_[v + 1], hub);
+
+            if (entry == firstForward_[v + 1] || forwardHubs_[entry] != hub
+                || static_cast<int>(path.vertices.size()) > n)
+            {
+                throw corrupt();
+            }
+        }
+    }
+
+    std::vector<int> fromHub;
+
+    for (int v = t, entry = backward; backwardPrevious_[entry] != -1; )
+    {
+        fromHub.push_back(vertexNumbers_[v]);
+        v = backwardPrevious_[entry];
+        entry = findEntry(backwardHubs_, firstBackward_[v], firstBackward_[v + 1], hub);
+
+        if (entry == firstBackward_[v + 1] || backwardHubs_[entry] != hub
+            || static_cast<int>(fromHub.size()) > n)
+        {
+            throw corrupt();
+        }
+    }
+
+    path.vertices.insert(path.vertices.end(), fromHub.rbegin(), fromHub.rend());
+    return path;
+}
+
+
+inline int HubLabels::index(int vertexNumber, const char* operation) const
+{
+    auto found = indices_.find(vertexNumber);
+
+    if (found == indices_.end())
+    {
+        throw DigraphException{
+            std::string{"HubLabels "} + operation + "(): vertex number "
+            + std::to_string(vertexNumber) + " does not exist."};
+    }
+
+    return found->second;
+}
+
+
+inline std::pair<int, int> HubLabels::bestHub(int s, int t) const noexcept
+{
+    double best = std::numeric_limits<double>::infinity();
+    std::pair<int, int> result{-1, -1};
+
+    int i = firstForward_[s];
+    int iEnd = firstForward_[s + 1];
+    int j = firstBackward_[t];
+    int jEnd = firstBackward_[t + 1];
+
+    while (i < iEnd && j < jEnd)
+    {
+        if (forwardHubs_[i] < backwardHubs_[j])
+        {
+            ++i;
+        }
+        else if (forwardHubs_[i] > backwardHubs_[j])
+        {
+            ++j;
+        }
+        else
+        {
+            double total = forwardDistances_[i] + backwardDistances_[j];
+
+            if (total < best)
+            {
+                best = total;
+                result = {i, j};
+            }
+
+            ++i;
+            ++j;
+        }
+    }
+
+    return result;
+}
+
+
+inline int HubLabels::findEntry(const std::vector<int>& hubs, int begin, int end, int hub) noexcept
+{
+    return std::lower_bound(hubs.begin() + begin, hubs.begin() + end, hub) - hubs.begin();
+}
+
+
+
+#endif
@@ -0,0 +1,287 @@
+// InterleavedSearch.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares interleavedShortestPaths(), which answers a
+// batch of point-to-point shortest path queries on one thread by running
+// several Dijkstra searches at once, taking turns.
+//
+// On a large graph, a single search spends most of its time waiting for
+// memory: every vertex it settles leads it to that vertex's arcs, and from
+// there to the distances of the arcs' heads, both of which are usually
+// somewhere the cache has never seen.  The CPU can fetch many things from
+// memory at once, though, if it's told about them early enough.  So each
+// search is broken into small steps -- settle a vertex, then look at its
+// arcs, then relax them -- and after each step it asks for the data its
+// next step will need with a prefetch, then steps aside for the next
+// search.  By the time its turn comes around again, that data has usually
+// arrived.  (This is sometimes called "asynchronous memory access
+// chaining".)  The searches are independent, so each finds exactly the
+// path a lone Dijkstra search would.
+//
+// Each search keeps its own distance for every vertex, though, so running
+// too many at once crowds them all out of the cache.  A handful is usually
+// best; beyond that, adding searches makes things slower, not faster.
+
+#ifndef INTERLEAVEDSEARCH_HPP
+#define INTERLEAVEDSEARCH_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "ArcRelaxation.hpp"
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+
+
+
+// interleavedShortestPaths() finds a shortest path in the given graph, with
+// the given arc weights (indexed by arc number), for each of the given
+// (start index, end index) queries, running up to "width" searches at a
+// time.  Each search stops as soon as it reaches its end vertex.  Paths
+// are returned in the same order as the queries, listing vertex numbers;
+// a path whose end can't be reached has no vertices and infinite length.
+// If the number of weights is wrong, or a query names a vertex index that
+// doesn't exist, a DigraphException is thrown.
+std::vector<DigraphPath> interleavedShortestPaths(
+    const CompactDigraph& graph, const std::vector<double>& arcWeights,
+    const std::vector<std::pair<int, int>>& queries, int width = 4);
+
+
+
+namespace InterleavedSearchDetails
+{
+    // The steps a search takes for each vertex it settles.  Each one ends
+    // by prefetching what the one after it needs.
+    enum class Step
+    {
+        Settle,
+        FindHeads,
+        Relax
+    };
+
+
+    // A Search holds everything one of the interleaved searches needs.  Its
+    // distances and predecessors are kept between queries, and only the
+    // entries it touched are reset, so starting a new query is cheap.
+    struct Search
+    {
+        int query = -1;
+        int end = -1;
+        Step step = Step::Settle;
+
+        std::vector<double> dist;
+        std::vector<int> pred;
+        std::vector<int> touched;
+        std::vector<std::pair<double, int>> heap;
+
+        int vertex = -1;
+        double vertexDist = 0.0;
+        int firstArc = 0;
+        int lastArc = 0;
+    };
+
+
+    inline void prefetchRange(const void* first, const void* last)
+    {
+        for (const char* p = static_cast<const char*>(first); p < last; p += 64)
+        {
+            __builtin_prefetch(p);
+        }
+    }
+
+
+    inline void startQuery(Search& search, int query, int start, int end)
+    {
+        for (int v : search.touched)
+        {
+            search.dist[v] = std::numeric_limits<double>::infinity();
+            search.pred[v] = -1;
+        }
+
+        search.touched.clear();
+        search.heap.clear();
+
+        search.query = query;
+        search.end = end;
+        search.step = Step::Settle;
+
+        search.dist[start] = 0.0;
+        search.touched.push_back(start);
+        search.heap.push_back({0.0, start});
+    }
+
+
+    // step() takes the search's next step, returning true once its query is
+    // finished: its end vertex has been settled, or it has run out of
+    // vertices to settle.
+    inline bool step(Search& search, const CompactDigraph& graph, const std::vector<double>& arcWeights)
+    {
+        using Entry = std::pair<double, int>;
+        std::vector<Entry>& heap = search.heap;
+
+        switch (search.step)
+        {
+        case Step::Settle:
+            while (!heap.empty())
+            {
+                std::pop_heap(heap.begin(), heap.end(), std::greater<Entry>{});
+                auto [d, v] = heap.back();
+                heap.pop_back();
+
+                if (d > search.dist[v])
+                {
+                    continue;
+                }
+
+                if (v == search.end)
+                {
+                    return true;
+                }
+
+                search.vertex = v;
+                search.vertexDist = d;
+                search.firstArc = graph.arcBegin(v);
+                search.lastArc = graph.arcEnd(v);
+
+                prefetchRange(graph.arcHeads() + search.firstArc, graph.arcHeads() + search.lastArc);
+                prefetchRange(arcWeights.data() + search.firstArc, arcWeights.data() + search.lastArc);
+
+                search.step = Step::FindHeads;
+                return false;
+            }
+
+            return true;
+
+        case Step::FindHeads:
+            for (int arc = search.firstArc; arc < search.lastArc; ++arc)
+            {
+                __builtin_prefetch(&search.dist[graph.arcHead(arc)]);
+            }
+
+            search.step = Step::Relax;
+            return false;
+
+        case Step::Relax:
+            relaxArcs(
+                graph.arcHeads() + search.firstArc, arcWeights.data() + search.firstArc,
+                search.lastArc - search.firstArc, search.vertexDist, search.dist.data(),
+                [&](int i, double candidate)
+                {
+                    int w = graph.arcHead(search.firstArc + i);
+
+                    if (search.pred[w] == -1)
+                    {
+                        search.touched.push_back(w);
+                    }
+
+                    search.pred[w] = search.vertex;
+                    heap.push_back({candidate, w});
+                    std::push_heap(heap.begin(), heap.end(), std::greater<Entry>{});
+                });
+
+            search.step = Step::Settle;
+            return false;
+        }
+
+        return false;
+    }
+
+
+    inline DigraphPath finishedPath(const Search& search, const CompactDigraph& graph, int start)
+    {
+        DigraphPath path{search.dist[search.end], {}};
+
+        if (path.length == std::numeric_limits<double>::infinity())
+        {
+            return path;
+        }
+
+        for (int v = search.end; v != -1; v = v == start ? -1 : search.pred[v])
+        {
+            path.vertices.push_back(graph.vertexNumber(v));
+        }
+
+        std::reverse(path.vertices.begin(), path.vertices.end());
+        return path;
+    }
+}
+
+
+
+inline std::vector<DigraphPath> interleavedShortestPaths(
+    const CompactDigraph& graph, const std::vector<double>& arcWeights,
+    const std::vector<std::pair<int, int>>& queries, int width)
+{
+    using namespace InterleavedSearchDetails;
+
+    int n = graph.vertexCount();
+
+    if (static_cast<int>(arcWeights.size()) != graph.arcCount())
+    {
+        throw DigraphException{"interleavedShortestPaths(): there must be one weight per arc."};
+    }
+
+    for (auto [start, end] : queries)
+    {
+        if (start < 0 || start >= n || end < 0 || end >= n)
+        {
+            throw DigraphException{"interleavedShortestPaths(): a query's vertex is not valid."};
+        }
+    }
+
+    int queryCount = queries.size();
+    std::vector<DigraphPath> paths(queryCount);
+    std::vector<Search> searches(std::max(1, std::min(width, queryCount)));
+
+    int nextQuery = 0;
+    int active = 0;
+
+    for (Search& search : searches)
+    {
+        search.dist.assign(n, std::numeric_limits<double>::infinity());
+        search.pred.assign(n, -1);
+
+        if (nextQuery < queryCount)
+        {
+            startQuery(search, nextQuery, queries[nextQuery].first, queries[nextQuery].second);
+            nextQuery++;
+            active++;
+        }
+    }
+
+    // Round-robin: each search takes one step per turn, and a search that
+    // finishes picks up the next query that hasn't been started yet.
+    while (active > 0)
+    {
+        for (Search& search : searches)
+        {
+            if (search.query == -1 || !step(search, graph, arcWeights))
+            {
+                continue;
+            }
+
+            paths[search.query] = finishedPath(search, graph, queries[search.query].first);
+
+            if (nextQuery < queryCount)
+            {
+                startQuery(search, nextQuery, queries[nextQuery].first, queries[nextQuery].second);
+                nextQuery++;
+            }
+            else
+            {
+                search.query = -1;
+                active--;
+            }
+        }
+    }
+
+    return paths;
+}
+
+
+
+#endif
@@ -0,0 +1,141 @@
+// Isochrones.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares reachableWithin(), which finds every vertex of
+// a Digraph that can be reached from a start vertex at a cost no greater
+// than a given budget -- "everything within 15 minutes", say, which is
+// what a coverage map (or "isochrone") shows.
+//
+// It's a Dijkstra search that never looks past the budget: a vertex whose
+// tentative cost would exceed the budget is never even recorded, so the
+// search stops as soon as there's nothing left within the budget.  Every
+// vertex it records turns out to be within the budget, so its memory use
+// is proportional to the size of the answer rather than the size of the
+// graph.  A second version computes the answers for many start vertices
+// at once, using several threads.
+
+#ifndef ISOCHRONES_HPP
+#define ISOCHRONES_HPP
+
+#include <cmath>
+#include <functional>
+#include <map>
+#include <queue>
+#include <utility>
+#include <vector>
+#include "Digraph.hpp"
+#include "ParallelFor.hpp"
+
+
+
+// reachableWithin() returns the vertices that can be reached from the
+// given start vertex at a cost no greater than the given budget, with edge
+// costs determined by the given function.  The result maps each such
+// vertex's number to the cost of reaching it, including the start vertex
+// at a cost of zero (unless the budget is negative, in which case nothing
+// is reachable).  If the start vertex does not exist or the budget is NaN,
+// a DigraphException is thrown.
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::map<int, double> reachableWithin(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& d, int startVertex, double budget,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc);
+
+
+// This overload of reachableWithin() does the same for each of the given
+// start vertices, using up to threadCount threads, and returns the results
+// in the same order as the start vertices.  The Digraph must not change
+// while it runs, and the function must be safe to call from several
+// threads at once.
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::vector<std::map<int, double>> reachableWithin(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& d,
+    const std::vector<int>& startVertices, double budget,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    int threadCount = defaultThreadCount());
+
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::map<int, double> reachableWithin(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& d, int startVertex, double budget,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc)
+{
+    if (std::isnan(budget))
+    {
+        throw DigraphException{"reachableWithin(): the budget is not a number."};
+    }
+
+    if (!d.hasVertex(startVertex))
+    {
+        throw DigraphException{"reachableWithin(): the startVertex is not valid."};
+    }
+
+    std::map<int, double> cost;
+
+    if (budget < 0.0)
+    {
+        return cost;
+    }
+
+    using Entry = std::pair<double, int>;
+    std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>> pq;
+
+    cost[startVertex] = 0.0;
+    pq.push({0.0, startVertex});
+
+    while (!pq.empty())
+    {
+        auto [c, vNum] = pq.top();
+        pq.pop();
+
+        if (c > cost.at(vNum))
+        {
+            continue;
+        }
+
+        for (const auto& edge : d.edgeRange(vNum))
+        {
+            double candidate = c + edgeWeightFunc(edge.einfo);
+
+            if (candidate > budget)
+            {
+                continue;
+            }
+
+            auto found = cost.find(edge.toVertex);
+
+            if (found == cost.end() || candidate < found->second)
+            {
+                cost[edge.toVertex] = candidate;
+                pq.push({candidate, edge.toVertex});
+            }
+        }
+    }
+
+    return cost;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::vector<std::map<int, double>> reachableWithin(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& d,
+    const std::vector<int>& startVertices, double budget,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc,
+    int threadCount)
+{
+    std::vector<std::map<int, double>> result(startVertices.size());
+
+    parallelFor(0, startVertices.size(), threadCount,
+        [&](int i)
+        {
+            result[i] = reachableWithin(d, startVertices[i], budget, edgeWeightFunc);
+        });
+
+    return result;
+}
+
+
+
+#endif
@@ -0,0 +1,757 @@
+// MultiLevelOverlay.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares the classes that make up a multi-level
+// overlay graph, the structure behind Customizable Route Planning
+// ("CRP").  Like a customizable contraction hierarchy, it separates
+// preprocessing that depends only on the road network from preprocessing
+// that depends on the metric:
+//
+// * OverlayGraph is built from a CompactDigraph and a nested GraphPartition.
+//   On each level, a vertex is a "boundary vertex" if it has an arc to or
+//   from a different cell on that level.  Each cell gets a clique: a
+//   table of the shortest distances, through the cell, from each of its
+//   boundary vertices to each of the others.
+//
+// * OverlayMetric fills in those cliques for one set of arc weights, from
+//   the bottom level up: cliques on level 0 come from searching the cell's
+//   own arcs, and cliques on higher levels come from searching the cliques
+//   of the cells one level down.  Since every cell is independent of the
+//   others on its level, cells are customized in parallel.  When a few
+//   arc weights change, only the cells that contain those arcs (and the
+//   cells containing those, going up) are customized again.
+//
+// * OverlayQuery answers shortest path queries with a Dijkstra search
+//   that uses the original arcs only near the start and end vertices and
+//   jumps across everything else using the cliques of the highest level
+//   that doesn't contain either of them.  Clique edges along the resulting
+//   path are unpacked into original arcs with a search inside their cell.
+
+#ifndef MULTILEVELOVERLAY_HPP
+#define MULTILEVELOVERLAY_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <queue>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "ArcRelaxation.hpp"
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "GraphPartitioner.hpp"
+#include "ParallelFor.hpp"
+
+
+
+// An OverlayLevel describes the cells of one level of an OverlayGraph.
+// Lists that are grouped by cell are stored back to back, with the list
+// for cell c starting at position first...[c] and ending just before
+// first...[c + 1].
+struct OverlayLevel
+{
+    // boundaryIndex[v] is the position of vertex v in its cell's list of
+    // boundary vertices, or -1 if it isn't a boundary vertex.
+    std::vector<int> boundaryIndex;
+    std::vector<int> firstBoundary;
+    std::vector<int> boundaryVertices;
+
+    // The vertices searched when computing a cell's clique: all of the
+    // cell's vertices on level 0, or the boundary vertices of the cells
+    // inside it from the level below.  nodeIndex[v] is the position of v
+    // in its cell's list, or -1.
+    std::vector<int> nodeIndex;
+    std::vector<int> firstNode;
+    std::vector<int> nodeVertices;
+
+    // The clique of cell c, a square table with one row and column per
+    // boundary vertex, starts at position firstCliqueEntry[c].
+    std::vector<long long> firstCliqueEntry;
+};
+
+
+
+class OverlayGraph
+{
+public:
+    // This constructor builds the overlay for the given graph and its
+    // partition, which must have been computed for that graph.
+    OverlayGraph(const CompactDigraph& graph, const GraphPartition& partition);
+
+    // graph() and partition() return what the overlay was built from.
+    const CompactDigraph& graph() const noexcept;
+    const GraphPartition& partition() const noexcept;
+
+    // levelCount() returns the number of levels in the overlay.
+    int levelCount() const noexcept;
+
+    // level() returns the description of the given level.
+    const OverlayLevel& level(int level) const noexcept;
+
+    // cliqueEntryCount() returns the total size of the cliques on all
+    // levels, which is the number of weights a metric has to store.
+    long long cliqueEntryCount() const noexcept;
+
+
+private:
+    CompactDigraph graph_;
+    GraphPartition partition_;
+    std::vector<OverlayLevel> levels_;
+};
+
+
+
+class OverlayMetric
+{
+public:
+    // This constructor customizes the given overlay for the given arc
+    // weights, indexed by arc number, using up to threadCount threads.
+    // The overlay must outlive the OverlayMetric.  If the number of
+    // weights is wrong, a DigraphException is thrown.
+    OverlayMetric(
+        const OverlayGraph& overlay, std::vector<double> arcWeights,
+        int threadCount = defaultThreadCount());
+
+    // overlay() returns the overlay this metric was customized from.
+    const OverlayGraph& overlay() const noexcept;
+
+    // arcWeight() returns the current weight of the given arc.
+    double arcWeight(int arc) const noexcept;
+
+    // cliqueWeight() returns the shortest distance through the given cell
+    // on the given level from its i-th boundary vertex to its j-th.
+    double cliqueWeight(int level, int cell, int i, int j) const noexcept;
+
+    // updateArcWeights() changes the weights of the given arcs, given as
+    // (arc number, new weight) pairs, then customizes again only the cells
+    // whose cliques could be affected.  It returns the number of cells
+    // that were customized again.  If any of the arcs does not exist, a
+    // DigraphException is thrown and no weights are changed.
+    int updateArcWeights(
+        const std::vector<std::pair<int, double>>& changes,
+        int threadCount = defaultThreadCount());
+
+
+private:
+    const OverlayGraph* overlay_;
+    std::vector<double> arcWeights_;
+    std::vector<std::vector<double>> cliques_;
+
+    // customizeCells() recomputes the cliques of the given cells on the
+    // given level.
+    void customizeCells(int level, const std::vector<int>& cells, int threadCount);
+};
+
+
+
+class OverlayQuery
+{
+public:
+    // This constructor prepares to answer queries against the given
+    // metric, which must outlive the OverlayQuery.  Each thread answering
+    // queries should have its own OverlayQuery.
+    explicit OverlayQuery(const OverlayMetric& metric);
+
+    // distance() returns the length of the shortest path between the
+    // given vertex numbers, or infinity if there is none.  If either
+    // vertex does not exist, a DigraphException is thrown.
+    double distance(int startVertex, int endVertex);
+
+    // shortestPath() is like distance(), except that it also returns the
+    // sequence of vertex numbers along the path, using original arcs only.
+    DigraphPath shortestPath(int startVertex, int endVertex);
+
+
+private:
+    const OverlayMetric* metric_;
+    std::vector<double> dist_;
+    std::vector<int> parent_;
+    std::vector<int> parentVia_;
+    std::vector<int> touched_;
+
+    // search() runs the query between two vertex indices, leaving the
+    // search tree in dist_, parent_, and parentVia_.  A parentVia_ of zero
+    // or more is an arc number; -(l + 2) means a clique edge on level l.
+    void search(int start, int end);
+
+    // unpackClique() appends the vertices of the shortest path through
+    // the given vertex's cell on the given level, from "from" to "to",
+    // excluding "from".
+    void unpackClique(int level, int from, int to, std::vector<int>& path) const;
+
+    void clear();
+};
+
+
+
+inline OverlayGraph::OverlayGraph(const CompactDigraph& graph, const GraphPartition& partition)
+    : graph_{graph}, partition_{partition}
+{
+    int n = graph_.vertexCount();
+
+    for (int l = 0; l < partition_.levelCount(); ++l)
+    {
+        OverlayLevel level;
+        int cells = partition_.cellCount(l);
+
+        // Boundary vertices have an arc crossing a cell border on this level.
+        std::vector<char> isBoundary(n, 0);
+
+        for (int arc = 0; arc < graph_.arcCount(); ++arc)
+        {
+            int tail = graph_.arcTail(arc);
+            int head = graph_.arcHead(arc);
+
+            if (partition_.cell(l, tail) != partition_.cell(l, head))
+            {
+                isBoundary[tail] = 1;
+                isBoundary[head] = 1;
+            }
+        }
+
+        // Groups the vertices satisfying "include" by cell, filling in the
+        // given first/vertices/index vectors.
+        auto groupByCell = [&](auto include,
+            std::vector<int>& first, std::vector<int>& vertices, std::vector<int>& index)
+            {
+                first.assign(cells + 1, 0);
+                index.assign(n, -1);
+
+                for (int v = 0; v < n; ++v)
+                {
+                    if (include(v))
+                    {
+                        first[partition_.cell(l, v) + 1]++;
+                    }
+                }
+
+                for (int c = 0; c < cells; ++c)
+                {
+                    first[c + 1] += first[c];
+                }
+
+                vertices.resize(first[cells]);
+                std::vector<int> next(first.begin(), first.end() - 1);
+
+                for (int v = 0; v < n; ++v)
+                {
+                    if (include(v))
+                    {
+                        int c = partition_.cell(l, v);
+                        index[v] = next[c] - first[c];
+                        vertices[next[c]++] = v;
+                    }
+                }
+            };
+
+        groupByCell([&](int v) { return isBoundary[v] != 0; },
+            level.firstBoundary, level.boundaryVertices, level.boundaryIndex);
+
+        const OverlayLevel* below = l == 0 ? nullptr : &levels_.back();
+
+        groupByCell([&](int v) { return below == nullptr || below->boundaryIndex[v] != -1; },
+            level.firstNode, level.nodeVertices, level.nodeIndex);
+
+        level.firstCliqueEntry.assign(cells + 1, 0);
+
+        for (int c = 0; c < cells; ++c)
+        {
+            long long size = level.firstBoundary[c + 1] - level.firstBoundary[c];
+            level.firstCliqueEntry[c + 1] = level.firstCliqueEntry[c] + size * size;
+        }
+
+        levels_.push_back(std::move(level));
+    }
+}
+
+
+inline const CompactDigraph& OverlayGraph::graph() const noexcept
+{
+    return graph_;
+}
+
+
+inline const GraphPartition& OverlayGraph::partition() const noexcept
+{
+    return partition_;
+}
+
+
+inline int OverlayGraph::levelCount() const noexcept
+{
+    return levels_.size();
+}
+
+
+inline const OverlayLevel& OverlayGraph::level(int level) const noexcept
+{
+    return levels_[level];
+}
+
+
+inline long long OverlayGraph::cliqueEntryCount() const noexcept
+{
+    long long total = 0;
+
+    for (const OverlayLevel& level : levels_)
+    {
+        total += level.firstCliqueEntry.back();
+    }
+
+    return total;
+}
+
+
+
+inline OverlayMetric::OverlayMetric(
+    const OverlayGraph& overlay, std::vector<double> arcWeights, int threadCount)
+    : overlay_{&overlay}, arcWeights_{std::move(arcWeights)}
+{
+    if (static_cast<int>(arcWeights_.size()) != overlay.graph().arcCount())
+    {
+        throw DigraphException{"OverlayMetric: there must be one weight per arc."};
+    }
+
+    for (int l = 0; l < overlay.levelCount(); ++l)
+    {
+        cliques_.push_back(std::vector<double>(
+            overlay.level(l).firstCliqueEntry.back(),
+            std::numeric_limits<double>::infinity()));
+
+        std::vector<int> cells(overlay.partition().cellCount(l));
+
+        for (int c = 0; c < static_cast<int>(cells.size()); ++c)
+        {
+            cells[c] = c;
+        }
+
+        customizeCells(l, cells, threadCount);
+    }
+}
+
+
+inline const OverlayGraph& OverlayMetric::overlay() const noexcept
+{
+    return *overlay_;
+}
+
+
+inline double OverlayMetric::arcWeight(int arc) const noexcept
+{
+    return arcWeights_[arc];
+}
+
+
+inline double OverlayMetric::cliqueWeight(int level, int cell, int i, int j) const noexcept
+{
+    const OverlayLevel& l = overlay_->level(level);
+    long long size = l.firstBoundary[cell + 1] - l.firstBoundary[cell];
+    return cliques_[level][l.firstCliqueEntry[cell] + i * size + j];
+}
+
+
+inline int OverlayMetric::updateArcWeights(
+    const std::vector<std::pair<int, double>>& changes, int threadCount)
+{
+    const CompactDigraph& graph = overlay_->graph();
+    const GraphPartition& partition = overlay_->partition();
+
+    for (auto& [arc, weight] : changes)
+    {
+        if (arc < 0 || arc >= graph.arcCount())
+        {
+            throw DigraphException{"OverlayMetric updateArcWeights(): the arc does not exist."};
+        }
+    }
+
+    for (auto& [arc, weight] : changes)
+    {
+        arcWeights_[arc] = weight;
+    }
+
+    // An arc only matters to the cliques of cells containing both of its
+    // endpoints; an arc crossing a cell border on some level is used
+    // directly by queries on that level instead.
+    int customized = 0;
+
+    for (int l = 0; l < overlay_->levelCount(); ++l)
+    {
+        std::vector<int> dirty;
+
+        for (auto& [arc, weight] : changes)
+        {
+            int tailCell = partition.cell(l, graph.arcTail(arc));
+
+            if (tailCell == partition.cell(l, graph.arcHead(arc)))
+            {
+                dirty.push_back(tailCell);
+            }
+        }
+
+        std::sort(dirty.begin(), dirty.end());
+        dirty.erase(std::unique(dirty.begin(), dirty.end()), dirty.end());
+
+        customizeCells(l, dirty, threadCount);
+        customized += dirty.size();
+    }
+
+    return customized;
+}
+
+
+inline void OverlayMetric::customizeCells(int l, const std::vector<int>& cells, int threadCount)
+{
+    const CompactDigraph& graph = overlay_->graph();
+    const GraphPartition& partition = overlay_->partition();
+    const OverlayLevel& level = overlay_->level(l);
+    const OverlayLevel* below = l == 0 ? nullptr : &overlay_->level(l - 1);
+
+    using QueueEntry = std::pair<double, int>;
+
+    parallelFor(0, cells.size(), threadCount,
+        [&](int i)
+        {
+            int c = cells[i];
+            int firstNode = level.firstNode[c];
+            int nodeCount = level.firstNode[c + 1] - firstNode;
+            int firstBoundary = level.firstBoundary[c];
+            int boundaryCount = level.firstBoundary[c + 1] - firstBoundary;
+
+            // The graph searched inside the cell is gathered up front, with
+            // its edges numbered by position in the cell's list of nodes,
+            // since every boundary vertex searches the same one.
+            std::vector<int> firstEdge(nodeCount + 1, 0);
+            std::vector<int> heads;
+            std::vector<double> weights;
+
+            for (int node = 0; node < nodeCount; ++node)
+            {
+                int v = level.nodeVertices[firstNode + node];
+
+                if (below != nullptr)
+                {
+                    // the clique of the subcell v is in
+                    int subcell = partition.cell(l - 1, v);
+                    int subFirst = below->firstBoundary[subcell];
+                    int subCount = below->firstBoundary[subcell + 1] - subFirst;
+                    int from = below->boundaryIndex[v];
+
+                    for (int to = 0; to < subCount; ++to)
+                    {
+                        heads.push_back(level.nodeIndex[below->boundaryVertices[subFirst + to]]);
+                        weights.push_back(cliqueWeight(l - 1, subcell, from, to));
+                    }
+                }
+
+                // arcs within the cell (between subcells, above level 0)
+                for (int arc = graph.arcBegin(v); arc < graph.arcEnd(v); ++arc)
+                {
+                    int head = graph.arcHead(arc);
+
+                    if (partition.cell(l, head) == c
+                        && (below == nullptr || partition.cell(l - 1, head) != partition.cell(l - 1, v)))
+                    {
+                        heads.push_back(level.nodeIndex[head]);
+                        weights.push_back(arcWeights_[arc]);
+                    }
+                }
+
+                firstEdge[node + 1] = heads.size();
+            }
+
+            std::vector<double> dist(nodeCount);
+
+            for (int source = 0; source < boundaryCount; ++source)
+            {
+                std::fill(dist.begin(), dist.end(), std::numeric_limits<double>::infinity());
+
+                std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+                int start = level.nodeIndex[level.boundaryVertices[firstBoundary + source]];
+                dist[start] = 0.0;
+                pq.push({0.0, start});
+
+                while (!pq.empty())
+                {
+                    auto [d, node] = pq.top();
+                    pq.pop();
+
+                    if (d > dist[node])
+                    {
+                        continue;
+                    }
+
+                    int first = firstEdge[node];
+
+                    relaxArcs(
+                        heads.data() + first, weights.data() + first, firstEdge[node + 1] - first, d,
+                        dist.data(),
+                        [&](int i, double candidate) { pq.push({candidate, heads[first + i]}); });
+                }
+
+                double* row = &cliques_[l][level.firstCliqueEntry[c] + source * boundaryCount];
+
+                for (int target = 0; target < boundaryCount; ++target)
+                {
+                    row[target] = dist[level.nodeIndex[level.boundaryVertices[firstBoundary + target]]];
+                }
+            }
+        });
+}
+
+
+
+inline OverlayQuery::OverlayQuery(const OverlayMetric& metric)
+    : metric_{&metric},
+      dist_(metric.overlay().graph().vertexCount(), std::numeric_limits<double>::infinity()),
+      parent_(metric.overlay().graph().vertexCount(), -1),
+      parentVia_(metric.overlay().graph().vertexCount(), -1)
+{
+}
+
+
+inline double OverlayQuery::distance(int startVertex, int endVertex)
+{
+    const CompactDigraph& graph = metric_->overlay().graph();
+    int end = graph.index(endVertex);
+
+    search(graph.index(startVertex), end);
+
+    double result = dist_[end];
+    clear();
+    return result;
+}
+
+
+inline DigraphPath OverlayQuery::shortestPath(int startVertex, int endVertex)
+{
+    const CompactDigraph& graph = metric_->overlay().graph();
+    int start = graph.index(startVertex);
+    int end = graph.index(endVertex);
+
+    search(start, end);
+
+    DigraphPath path{dist_[end], {}};
+
+    if (dist_[end] == std::numeric_limits<double>::infinity())
+    {
+        clear();
+        return path;
+    }
+
+    // Walk back from the end, then unpack each step front to back.
+    std::vector<int> steps;
+
+    for (int v = end; v != start; v = parent_[v])
+    {
+        steps.push_back(v);
+    }
+
+    std::vector<int> indices{start};
+
+    for (auto step = steps.rbegin(); step != steps.rend(); ++step)
+    {
+        int v = *step;
+
+        if (parentVia_[v] >= 0)
+        {
+            indices.push_back(v);
+        }
+        else
+        {
+            unpackClique(-parentVia_[v] - 2, parent_[v], v, indices);
+        }
+    }
+
+    for (int index : indices)
+    {
+        path.vertices.push_back(graph.vertexNumber(index));
+    }
+
+    clear();
+    return path;
+}
+
+
+inline void OverlayQuery::search(int start, int end)
+{
+    const OverlayGraph& overlay = metric_->overlay();
+    const CompactDigraph& graph = overlay.graph();
+    const GraphPartition& partition = overlay.partition();
+
+    // queryLevel() returns the highest level on which the given vertex's
+    // cell contains neither the start nor the end vertex (cells nest, so
+    // that's also true on every level below), or -1 if there isn't one.
+    auto queryLevel = [&](int v)
+        {
+            int level = -1;
+
+            while (level + 1 < overlay.levelCount()
+                && partition.cell(level + 1, v) != partition.cell(level + 1, start)
+                && partition.cell(level + 1, v) != partition.cell(level + 1, end))
+            {
+                level++;
+            }
+
+            return level;
+        };
+
+    using QueueEntry = std::pair<double, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+
+    auto relax = [&](int from, int to, double candidate, int via)
+        {
+            if (candidate < dist_[to])
+            {
+                if (dist_[to] == std::numeric_limits<double>::infinity())
+                {
+                    touched_.push_back(to);
+                }
+
+                dist_[to] = candidate;
+                parent_[to] = from;
+                parentVia_[to] = via;
+                pq.push({candidate, to});
+            }
+        };
+
+    dist_[start] = 0.0;
+    touched_.push_back(start);
+    pq.push({0.0, start});
+
+    while (!pq.empty())
+    {
+        auto [d, v] = pq.top();
+        pq.pop();
+
+        if (d > dist_[v])
+        {
+            continue;
+        }
+
+        if (v == end)
+        {
+            break;
+        }
+
+        int level = queryLevel(v);
+
+        if (level == -1)
+        {
+            for (int arc = graph.arcBegin(v); arc < graph.arcEnd(v); ++arc)
+            {
+                relax(v, graph.arcHead(arc), d + metric_->arcWeight(arc), arc);
+            }
+
+            continue;
+        }
+
+        // Away from both ends, cross v's cell on this level in one step,
+        // and leave it only by arcs that cross its border.  Any vertex
+        // reached this way is a boundary vertex of its cell.
+        const OverlayLevel& l = overlay.level(level);
+        int cell = partition.cell(level, v);
+        int from = l.boundaryIndex[v];
+
+        if (from != -1)
+        {
+            int first = l.firstBoundary[cell];
+            int count = l.firstBoundary[cell + 1] - first;
+
+            for (int to = 0; to < count; ++to)
+            {
+                relax(v, l.boundaryVertices[first + to],
+                    d + metric_->cliqueWeight(level, cell, from, to), -(level + 2));
+            }
+        }
+
+        for (int arc = graph.arcBegin(v); arc < graph.arcEnd(v); ++arc)
+        {
+            int head = graph.arcHead(arc);
+
+            if (partition.cell(level, head) != cell)
+            {
+                relax(v, head, d + metric_->arcWeight(arc), arc);
+            }
+        }
+    }
+}
+
+
+inline void OverlayQuery::unpackClique(int level, int from, int to, std::vector<int>& path) const
+{
+    const CompactDigraph& graph = metric_->overlay().graph();
+    const GraphPartition& partition = metric_->overlay().partition();
+    int cell = partition.cell(level, from);
+
+    std::unordered_map<int, double> dist{{from, 0.0}};
+    std::unordered_map<int, int> parent;
+
+    using QueueEntry = std::pair<double, int>;
+    std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> pq;
+    pq.push({0.0, from});
+
+    while (!pq.empty())
+    {
+        auto [d, v] = pq.top();
+        pq.pop();
+
+        if (d > dist[v])
+        {
+            continue;
+        }
+
+        if (v == to)
+        {
+            break;
+        }
+
+        for (int arc = graph.arcBegin(v); arc < graph.arcEnd(v); ++arc)
+        {
+            int head = graph.arcHead(arc);
+
+            if (partition.cell(level, head) != cell)
+            {
+                continue;
+            }
+
+            double candidate = d + metric_->arcWeight(arc);
+            auto found = dist.find(head);
+
+            if (found == dist.end() || candidate < found->second)
+            {
+                dist[head] = candidate;
+                parent[head] = v;
+                pq.push({candidate, head});
+            }
+        }
+    }
+
+    std::vector<int> reversed;
+
+    for (int v = to; v != from; v = parent.at(v))
+    {
+        reversed.push_back(v);
+    }
+
+    path.insert(path.end(), reversed.rbegin(), reversed.rend());
+}
+
+
+inline void OverlayQuery::clear()
+{
+    for (int v : touched_)
+    {
+        dist_[v] = std::numeric_limits<double>::infinity();
+        parent_[v] = -1;
+        parentVia_[v] = -1;
+    }
+
+    touched_.clear();
+}
+
+
+
+#endif
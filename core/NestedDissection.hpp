@@ -0,0 +1,208 @@
+// NestedDissection.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares nestedDissectionOrder(), which computes a
+// contraction order for the vertices of a CompactDigraph by recursive
+// bisection.  The order depends only on the structure of the graph (it
+// ignores the direction of arcs and never looks at weights), which is
+// what allows a hierarchy built from it to be reused for any metric.
+//
+// Each piece of the graph is split in two by growing a breadth-first
+// search from a pseudo-peripheral vertex and cutting its visiting order
+// in half.  The vertices on the far side of the cut that touch the near
+// side form a separator.  Both halves are ordered first (recursively) and
+// the separator is ordered last, so separators end up at the top of the
+// hierarchy.  Pieces that fall apart into several components are split
+// along a component boundary instead, without a separator.
+
+#ifndef NESTEDDISSECTION_HPP
+#define NESTEDDISSECTION_HPP
+
+#include <algorithm>
+#include <vector>
+#include "CompactDigraph.hpp"
+
+
+
+// undirectedNeighbors() returns, for every vertex of the given graph, the
+// sorted indices of the vertices adjacent to it in either direction,
+// excluding itself.
+inline std::vector<std::vector<int>> undirectedNeighbors(const CompactDigraph& g)
+{
+    std::vector<std::vector<int>> neighbors(g.vertexCount());
+
+    for (int arc = 0; arc < g.arcCount(); ++arc)
+    {
+        int tail = g.arcTail(arc);
+        int head = g.arcHead(arc);
+
+        if (tail != head)
+        {
+            neighbors[tail].push_back(head);
+            neighbors[head].push_back(tail);
+        }
+    }
+
+    for (std::vector<int>& list : neighbors)
+    {
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+    }
+
+    return neighbors;
+}
+
+
+// nestedDissectionOrder() returns the indices of all vertices of the given
+// graph in contraction order: the first vertex returned is the least
+// important one.  Pieces with at most leafSize vertices are not split.
+inline std::vector<int> nestedDissectionOrder(const CompactDigraph& g, int leafSize = 16)
+{
+    int n = g.vertexCount();
+    std::vector<std::vector<int>> neighbors = undirectedNeighbors(g);
+
+    struct Piece
+    {
+        std::vector<int> vertices;
+        int firstPosition;
+    };
+
+    std::vector<int> order(n);
+    std::vector<int> owner(n, 0);
+    std::vector<int> seen(n, -1);
+    int nextOwner = 1;
+
+    std::vector<Piece> pieces;
+    pieces.push_back({std::vector<int>(n), 0});
+
+    for (int v = 0; v < n; ++v)
+    {
+        pieces.back().vertices[v] = v;
+    }
+
+    int searchNumber = 0;
+
+    // breadthFirst() visits the part of the given piece reachable from
+    // start and returns the vertices in visiting order.
+    auto breadthFirst = [&](int pieceOwner, int start)
+        {
+            searchNumber++;
+            std::vector<int> visited{start};
+            seen[start] = searchNumber;
+
+            for (std::size_t i = 0; i < visited.size(); ++i)
+            {
+                for (int w : neighbors[visited[i]])
+                {
+                    if (owner[w] == pieceOwner && seen[w] != searchNumber)
+                    {
+                        seen[w] = searchNumber;
+                        visited.push_back(w);
+                    }
+                }
+            }
+
+            return visited;
+        };
+
+    while (!pieces.empty())
+    {
+        Piece piece = std::move(pieces.back());
+        pieces.pop_back();
+
+        int size = piece.vertices.size();
+
+        if (size <= std::max(leafSize, 1))
+        {
+            std::copy(piece.vertices.begin(), piece.vertices.end(),
+                order.begin() + piece.firstPosition);
+            continue;
+        }
+
+        int pieceOwner = owner[piece.vertices.front()];
+
+        // Two sweeps find a vertex near the periphery of the piece.
+        std::vector<int> visited = breadthFirst(pieceOwner, piece.vertices.front());
+        visited = breadthFirst(pieceOwner, visited.back());
+
+        std::vector<int> near;
+        std::vector<int> far;
+        std::vector<int> separator;
+
+        if (static_cast<int>(visited.size()) < size)
+        {
+            // The piece is disconnected; split off the component we found.
+            near = visited;
+
+            for (int v : piece.vertices)
+            {
+                if (seen[v] != searchNumber)
+                {
+                    far.push_back(v);
+                }
+            }
+        }
+        else
+        {
+            int half = size / 2;
+            int cutOwner = nextOwner++;
+
+            for (int i = 0; i < half; ++i)
+            {
+                owner[visited[i]] = cutOwner;
+                near.push_back(visited[i]);
+            }
+
+            for (int i = half; i < size; ++i)
+            {
+                int v = visited[i];
+                bool touchesNear = std::any_of(
+                    neighbors[v].begin(), neighbors[v].end(),
+                    [&](int w) { return owner[w] == cutOwner; });
+
+                if (touchesNear)
+                {
+                    separator.push_back(v);
+                }
+                else
+                {
+                    far.push_back(v);
+                }
+            }
+        }
+
+        int nearOwner = nextOwner++;
+        int farOwner = nextOwner++;
+        int separatorOwner = nextOwner++;
+
+        for (int v : near)
+        {
+            owner[v] = nearOwner;
+        }
+
+        for (int v : far)
+        {
+            owner[v] = farOwner;
+        }
+
+        for (int v : separator)
+        {
+            owner[v] = separatorOwner;
+        }
+
+        int separatorPosition = piece.firstPosition + near.size() + far.size();
+        std::copy(separator.begin(), separator.end(), order.begin() + separatorPosition);
+
+        int farPosition = piece.firstPosition + near.size();
+        pieces.push_back({std::move(far), farPosition});
+        pieces.push_back({std::move(near), piece.firstPosition});
+    }
+
+    return order;
+}
+
+
+
+#endif
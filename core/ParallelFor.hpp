@@ -0,0 +1,120 @@
+// ParallelFor.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a couple of small helpers for splitting a
+// range of integers (typically vertex or arc numbers) across threads.
+// They're used by the preprocessing and batch query code, which all
+// share the same shape: a loop whose iterations are independent.
+//
+// Work is split into contiguous chunks, one per thread, and the calling
+// thread runs the first chunk itself.  If any iteration throws, the
+// first exception is rethrown on the calling thread after every thread
+// has finished.
+
+#ifndef PARALLELFOR_HPP
+#define PARALLELFOR_HPP
+
+#include <algorithm>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+
+// defaultThreadCount() returns the number of threads the hardware can
+// run at once, or 1 if that can't be determined.
+inline int defaultThreadCount()
+{
+    unsigned int count = std::thread::hardware_concurrency();
+    return count == 0 ? 1 : static_cast<int>(count);
+}
+
+
+// parallelForChunks() splits [begin, end) into at most threadCount
+// contiguous chunks and calls f(chunkBegin, chunkEnd, chunkNumber) once
+// per chunk, each on its own thread.  Chunk numbers run from zero, so
+// they can be used to index per-thread scratch space.
+template <typename Function>
+void parallelForChunks(int begin, int end, int threadCount, Function f)
+{
+    int size = end - begin;
+
+    if (size <= 0)
+    {
+        return;
+    }
+
+    int chunks = std::max(1, std::min(threadCount, size));
+
+    if (chunks == 1)
+    {
+        f(begin, end, 0);
+        return;
+    }
+
+    std::exception_ptr failure;
+    std::mutex failureMutex;
+
+    auto runChunk = [&](int chunk)
+        {
+            int chunkBegin = begin + static_cast<int>(
+                static_cast<long long>(size) * chunk / chunks);
+            int chunkEnd = begin + static_cast<int>(
+                static_cast<long long>(size) * (chunk + 1) / chunks);
+
+            try
+            {
+                f(chunkBegin, chunkEnd, chunk);
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock{failureMutex};
+                if (!failure)
+                {
+                    failure = std::current_exception();
+                }
+            }
+        };
+
+    std::vector<std::thread> threads;
+
+    for (int chunk = 1; chunk < chunks; ++chunk)
+    {
+        threads.emplace_back(runChunk, chunk);
+    }
+
+    runChunk(0);
+
+    for (std::thread& t : threads)
+    {
+        t.join();
+    }
+
+    if (failure)
+    {
+        std::rethrow_exception(failure);
+    }
+}
+
+
+// parallelFor() calls f(i) for every i in [begin, end), spread across at
+// most threadCount threads.
+template <typename Function>
+void parallelFor(int begin, int end, int threadCount, Function f)
+{
+    parallelForChunks(begin, end, threadCount,
+        [&](int chunkBegin, int chunkEnd, int)
+        {
+            for (int i = chunkBegin; i < chunkEnd; ++i)
+            {
+                f(i);
+            }
+        });
+}
+
+
+
+#endif
@@ -0,0 +1,301 @@
+// Phast.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called PhastQuery, which computes
+// shortest paths from one vertex to all others ("one-to-all trees") using
+// a customized contraction hierarchy, following the PHAST algorithm.
+//
+// Every shortest path in a hierarchy goes up from the start vertex and
+// then down.  So a one-to-all search has two phases:
+//
+// * an upward search from the start vertex, which in a customizable
+//   hierarchy just visits the start vertex's ancestors in the elimination
+//   tree, a tiny part of the graph; and
+//
+// * a downward sweep over every vertex from the highest rank to the
+//   lowest, in which each vertex takes the best distance offered by its
+//   higher-ranked neighbors, whose distances are already final by then.
+//
+// The sweep doesn't need a priority queue at all, and it visits vertices
+// and edges in a fixed order, so PhastQuery copies the downward edges into
+// arrays laid out in exactly that order and the sweep reads them straight
+// through.  Distances are stored "lane-interleaved": several start vertices
+// are swept at once, with the distances of one vertex from all of them side
+// by side, so the innermost loop works on a short fixed-size array that the
+// compiler turns into SIMD instructions.
+
+#ifndef PHAST_HPP
+#define PHAST_HPP
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "CustomizableContractionHierarchy.hpp"
+#include "Digraph.hpp"
+#include "ParallelFor.hpp"
+
+
+
+class PhastQuery
+{
+public:
+    // lanes is the number of start vertices swept at once.
+    static constexpr int lanes = 8;
+
+    // This constructor prepares to sweep the given metric, which must
+    // outlive the PhastQuery.
+    explicit PhastQuery(const CustomizedMetric& metric);
+
+    // distances() returns the shortest distances from each of the given
+    // vertex numbers to every vertex, indexed by vertex index in the
+    // hierarchy's graph, using up to threadCount threads.  If any of the
+    // vertices does not exist, a DigraphException is thrown.
+    std::vector<std::vector<double>> distances(
+        const std::vector<int>& startVertices, int threadCount = defaultThreadCount()) const;
+
+    // shortestPaths() is like distances(), except that it also determines
+    // the predecessor of every vertex on a shortest path from each start
+    // vertex: the vertex with an arc into it that gives it the smallest
+    // distance, among those strictly closer to the start vertex.
+    std::vector<SingleSourcePaths> shortestPaths(
+        const std::vector<int>& startVertices, int threadCount = defaultThreadCount()) const;
+
+
+private:
+    const CustomizedMetric* metric_;
+
+    // The edges pulled from during the sweep: the vertex at position i of
+    // the sweep (which has rank n - 1 - i) pulls along the edges in
+    // positions firstEdge_[i] up to, but not including, firstEdge_[i + 1],
+    // from the vertices at the sweep positions in edgeSource_.
+    std::vector<int> firstEdge_;
+    std::vector<int> edgeSource_;
+    std::vector<double> edgeWeight_;
+
+    // startRanks() returns the rank of each of the given vertex numbers.
+    std::vector<int> startRanks(const std::vector<int>& startVertices) const;
+
+    // sweep() computes distances for up to "lanes" start ranks at once, into
+    // dist, which is laid out by sweep position and then lane.
+    void sweep(const std::vector<int>& startRanks, std::vector<double>& dist) const;
+};
+
+
+
+inline PhastQuery::PhastQuery(const CustomizedMetric& metric)
+    : metric_{&metric}
+{
+    const CustomizableContractionHierarchy& hierarchy = metric.hierarchy();
+    int n = hierarchy.vertexCount();
+
+    firstEdge_.reserve(n + 1);
+    firstEdge_.push_back(0);
+
+    for (int position = 0; position < n; ++position)
+    {
+        int rank = n - 1 - position;
+
+        for (int edge = hierarchy.upEdgeBegin(rank); edge < hierarchy.upEdgeEnd(rank); ++edge)
+        {
+            if (metric.downWeight(edge) != std::numeric_limits<double>::infinity())
+            {
+                edgeSource_.push_back(n - 1 - hierarchy.edgeHead(edge));
+                edgeWeight_.push_back(metric.downWeight(edge));
+            }
+        }
+
+        firstEdge_.push_back(edgeSource_.size());
+    }
+}
+
+
+inline std::vector<std::vector<double>> PhastQuery::distances(
+    const std::vector<int>& startVertices, int threadCount) const
+{
+    std::vector<std::vector<double>> result(startVertices.size());
+
+    const CustomizableContractionHierarchy& hierarchy = metric_->hierarchy();
+    int n = hierarchy.vertexCount();
+
+    std::vector<int> ranks = startRanks(startVertices);
+    int batches = (ranks.size() + lanes - 1) / lanes;
+
+    parallelForChunks(0, batches, threadCount,
+        [&](int begin, int end, int)
+        {
+            std::vector<double> dist;
+
+            for (int batch = begin; batch < end; ++batch)
+            {
+                auto first = ranks.begin() + batch * lanes;
+                auto last = ranks.begin() + std::min<int>((batch + 1) * lanes, ranks.size());
+
+                sweep(std::vector<int>(first, last), dist);
+
+                for (int lane = 0; lane < last - first; ++lane)
+                {
+                    std::vector<double>& distances = result[batch * lanes + lane];
+                    distances.resize(n);
+
+                    for (int v = 0; v < n; ++v)
+                    {
+                        distances[v] = dist[(n - 1 - hierarchy.rank(v)) * lanes + lane];
+                    }
+                }
+            }
+        });
+
+    return result;
+}
+
+
+inline std::vector<SingleSourcePaths> PhastQuery::shortestPaths(
+    const std::vector<int>& startVertices, int threadCount) const
+{
+    std::vector<SingleSourcePaths> result(startVertices.size());
+
+    const CustomizableContractionHierarchy& hierarchy = metric_->hierarchy();
+    const CompactDigraph& graph = hierarchy.graph();
+    int n = graph.vertexCount();
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    std::vector<int> ranks = startRanks(startVertices);
+    int batches = (ranks.size() + lanes - 1) / lanes;
+
+    parallelForChunks(0, batches, threadCount,
+        [&](int begin, int end, int)
+        {
+            std::vector<double> dist;
+
+            for (int batch = begin; batch < end; ++batch)
+            {
+                auto first = ranks.begin() + batch * lanes;
+                auto last = ranks.begin() + std::min<int>((batch + 1) * lanes, ranks.size());
+                int count = last - first;
+
+                sweep(std::vector<int>(first, last), dist);
+
+                for (int lane = 0; lane < count; ++lane)
+                {
+                    result[batch * lanes + lane].distances.resize(n);
+                    result[batch * lanes + lane].predecessors.resize(n);
+                }
+
+                // Predecessors are found while the distances are still
+                // lane-interleaved, so each arc into a vertex is examined
+                // once for the whole batch.  Requiring predecessors to be
+                // strictly closer keeps them from forming cycles through
+                // arcs of weight zero.
+                for (int v = 0; v < n; ++v)
+                {
+                    const double* vDist = &dist[(n - 1 - hierarchy.rank(v)) * lanes];
+                    double best[lanes];
+                    int pred[lanes];
+
+                    std::fill(best, best + lanes, infinity);
+                    std::fill(pred, pred + lanes, -1);
+
+                    for (int j = graph.reverseArcBegin(v); j < graph.reverseArcEnd(v); ++j)
+                    {
+                        int arc = graph.reverseArc(j);
+                        int tail = graph.arcTail(arc);
+                        const double* tailDist = &dist[(n - 1 - hierarchy.rank(tail)) * lanes];
+                        double weight = metric_->arcWeight(arc);
+
+                        for (int lane = 0; lane < lanes; ++lane)
+                        {
+                            double candidate = tailDist[lane] + weight;
+                            bool better = tailDist[lane] < vDist[lane] && candidate < best[lane];
+
+                            best[lane] = better ? candidate : best[lane];
+                            pred[lane] = better ? tail : pred[lane];
+                        }
+                    }
+
+                    for (int lane = 0; lane < count; ++lane)
+                    {
+                        result[batch * lanes + lane].distances[v] = vDist[lane];
+                        result[batch * lanes + lane].predecessors[v] = pred[lane];
+                    }
+                }
+            }
+        });
+
+    return result;
+}
+
+
+inline std::vector<int> PhastQuery::startRanks(const std::vector<int>& startVertices) const
+{
+    const CustomizableContractionHierarchy& hierarchy = metric_->hierarchy();
+    std::vector<int> ranks;
+
+    for (int vertex : startVertices)
+    {
+        ranks.push_back(hierarchy.rank(hierarchy.graph().index(vertex)));
+    }
+
+    return ranks;
+}
+
+
+inline void PhastQuery::sweep(const std::vector<int>& startRanks, std::vector<double>& dist) const
+{
+    const CustomizableContractionHierarchy& hierarchy = metric_->hierarchy();
+    int n = hierarchy.vertexCount();
+    constexpr double infinity = std::numeric_limits<double>::infinity();
+
+    dist.assign(static_cast<std::size_t>(n) * lanes, infinity);
+
+    // The upward search: a vertex's upward neighbors are all its ancestors
+    // in the elimination tree, so walking up the tree visits each of them
+    // after everything that can reach it from below.
+    for (int lane = 0; lane < static_cast<int>(startRanks.size()); ++lane)
+    {
+        dist[(n - 1 - startRanks[lane]) * lanes + lane] = 0.0;
+
+        for (int rank = startRanks[lane]; rank != -1; rank = hierarchy.parent(rank))
+        {
+            double d = dist[(n - 1 - rank) * lanes + lane];
+
+            if (d == infinity)
+            {
+                continue;
+            }
+
+            for (int edge = hierarchy.upEdgeBegin(rank); edge < hierarchy.upEdgeEnd(rank); ++edge)
+            {
+                double& head = dist[(n - 1 - hierarchy.edgeHead(edge)) * lanes + lane];
+                head = std::min(head, d + metric_->upWeight(edge));
+            }
+        }
+    }
+
+    // The downward sweep, with one fixed-size lane loop per edge.
+    double* d = dist.data();
+
+    for (int position = 0; position < n; ++position)
+    {
+        double* target = d + static_cast<std::size_t>(position) * lanes;
+
+        for (int e = firstEdge_[position]; e < firstEdge_[position + 1]; ++e)
+        {
+            const double* source = d + static_cast<std::size_t>(edgeSource_[e]) * lanes;
+            double weight = edgeWeight_[e];
+
+            for (int lane = 0; lane < lanes; ++lane)
+            {
+                double candidate = source[lane] + weight;
+                target[lane] = candidate < target[lane] ? candidate : target[lane];
+            }
+        }
+    }
+}
+
+
+
+#endif
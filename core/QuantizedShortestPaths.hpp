@@ -0,0 +1,182 @@
+// QuantizedShortestPaths.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares quantizedShortestPaths(), which computes the
+// shortest paths from one vertex to all others when arc weights are
+// nonnegative integers, and findShortestPathsQuantized(), which does the
+// same for a Digraph and returns its result in the same form as
+// findShortestPaths().
+//
+// With integer weights, Dijkstra's algorithm can use a RadixHeap instead of
+// a binary heap, so that each of its queue operations takes constant
+// amortized time instead of logarithmic.  Weights that aren't integers can
+// be "quantized" first with quantizedWeight(), which rounds them to a whole
+// number of small fixed-size units; as long as the units are much smaller
+// than the differences between path lengths that matter, the paths found
+// are the same.
+
+#ifndef QUANTIZEDSHORTESTPATHS_HPP
+#define QUANTIZEDSHORTESTPATHS_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <vector>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "RadixHeap.hpp"
+
+
+
+// A QuantizedPaths is like a SingleSourcePaths, except with integer
+// distances; unreachable vertices have distance unreachable.
+struct QuantizedPaths
+{
+    static constexpr std::uint64_t unreachable = std::numeric_limits<std::uint64_t>::max();
+
+    std::vector<std::uint64_t> distances;
+    std::vector<int> predecessors;
+};
+
+
+
+// quantizedShortestPaths() finds the shortest paths in the given graph from
+// the vertex with the given index, with the given integer arc weights
+// (indexed by arc number).  Path lengths must fit in 64 bits.  If the number
+// of weights is wrong, or there is no vertex with the start index, a
+// DigraphException is thrown.
+QuantizedPaths quantizedShortestPaths(
+    const CompactDigraph& graph, const std::vector<std::uint64_t>& arcWeights, int startIndex);
+
+
+// findShortestPathsQuantized() is a drop-in replacement for the Digraph's
+// findShortestPaths() for integer edge weights, computed with
+// quantizedShortestPaths().
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::map<int, int> findShortestPathsQuantized(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& d, int startVertex,
+    std::function<std::uint64_t(const EdgeInfo&)> edgeWeightFunc);
+
+
+// quantizedWeight() returns a function giving the weight determined by the
+// given function in units of 1 / unitsPerWeight, rounded to the nearest
+// integer.  The function it returns throws a DigraphException if a weight
+// is negative, NaN, or too large to fit.
+template <typename EdgeInfo>
+std::function<std::uint64_t(const EdgeInfo&)> quantizedWeight(
+    std::function<double(const EdgeInfo&)> edgeWeightFunc, double unitsPerWeight);
+
+
+
+inline QuantizedPaths quantizedShortestPaths(
+    const CompactDigraph& graph, const std::vector<std::uint64_t>& arcWeights, int startIndex)
+{
+    int n = graph.vertexCount();
+
+    if (static_cast<int>(arcWeights.size()) != graph.arcCount())
+    {
+        throw DigraphException{"quantizedShortestPaths(): there must be one weight per arc."};
+    }
+
+    if (startIndex < 0 || startIndex >= n)
+    {
+        throw DigraphException{"quantizedShortestPaths(): the start vertex is not valid."};
+    }
+
+    QuantizedPaths paths;
+    paths.distances.assign(n, QuantizedPaths::unreachable);
+    paths.predecessors.assign(n, -1);
+
+    std::vector<std::uint64_t>& dist = paths.distances;
+    RadixHeap<int> queue;
+
+    dist[startIndex] = 0;
+    queue.push(0, startIndex);
+
+    while (!queue.empty())
+    {
+        auto [d, v] = queue.pop();
+
+        if (d > dist[v])
+        {
+            continue;
+        }
+
+        for (int arc = graph.arcBegin(v); arc < graph.arcEnd(v); ++arc)
+        {
+            int w = graph.arcHead(arc);
+            std::uint64_t candidate = d + arcWeights[arc];
+
+            if (candidate < dist[w])
+            {
+                dist[w] = candidate;
+                paths.predecessors[w] = v;
+                queue.push(candidate, w);
+            }
+        }
+    }
+
+    return paths;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo, typename Allocator>
+std::map<int, int> findShortestPathsQuantized(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& d, int startVertex,
+    std::function<std::uint64_t(const EdgeInfo&)> edgeWeightFunc)
+{
+    if (!d.hasVertex(startVertex))
+    {
+        throw DigraphException{"findShortestPathsQuantized(): the startVertex is not valid."};
+    }
+
+    CompactDigraph graph{d};
+    int start = graph.index(startVertex);
+
+    std::vector<std::uint64_t> weights;
+    weights.reserve(graph.arcCount());
+
+    for (const EdgeInfo& einfo : graph.arcInfos(d))
+    {
+        weights.push_back(edgeWeightFunc(einfo));
+    }
+
+    QuantizedPaths paths = quantizedShortestPaths(graph, weights, start);
+    std::map<int, int> result;
+
+    for (int v = 0; v < graph.vertexCount(); ++v)
+    {
+        int predecessor = paths.predecessors[v] == -1 ? v : paths.predecessors[v];
+        result.emplace_hint(result.end(), graph.vertexNumber(v), graph.vertexNumber(predecessor));
+    }
+
+    return result;
+}
+
+
+template <typename EdgeInfo>
+std::function<std::uint64_t(const EdgeInfo&)> quantizedWeight(
+    std::function<double(const EdgeInfo&)> edgeWeightFunc, double unitsPerWeight)
+{
+    return [edgeWeightFunc, unitsPerWeight](const EdgeInfo& einfo)
+        {
+            double units = std::round(edgeWeightFunc(einfo) * unitsPerWeight);
+
+            // Keeping weights below 2^48 leaves room for paths of 65,536
+            // of the heaviest possible arcs without overflowing.
+            if (!(units >= 0.0 && units < 281474976710656.0))
+            {
+                throw DigraphException{"quantizedWeight(): the weight can't be quantized."};
+            }
+
+            return static_cast<std::uint64_t>(units);
+        };
+}
+
+
+
+#endif
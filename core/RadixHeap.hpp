@@ -0,0 +1,159 @@
+// RadixHeap.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class template called RadixHeap, a priority
+// queue of values with unsigned 64-bit integer keys that is "monotone": a
+// key can never be smaller than the last key removed.  Dijkstra's algorithm
+// only ever adds keys at least as large as the distance it just removed, so
+// it can use a RadixHeap in place of a binary heap.
+//
+// Entries are kept in 65 buckets by the position of the highest bit in which
+// their key differs from the last key removed, so bucket 0 holds keys equal
+// to it, and bucket b (for b > 0) keys that agree with it above bit b - 1.
+// Removing the smallest key takes it straight from bucket 0 when there is
+// one; otherwise the lowest nonempty bucket is emptied into lower buckets
+// around its smallest key.  An entry only moves to strictly lower buckets,
+// at most 64 times, so every operation takes constant amortized time.
+
+#ifndef RADIXHEAP_HPP
+#define RADIXHEAP_HPP
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "Digraph.hpp"
+
+
+
+template <typename Value>
+class RadixHeap
+{
+public:
+    // This constructor initializes an empty heap whose last key removed is
+    // considered to be 0.
+    RadixHeap();
+
+    // empty() returns true if there are no entries, false otherwise.
+    bool empty() const noexcept;
+
+    // size() returns the number of entries.
+    std::size_t size() const noexcept;
+
+    // push() adds an entry.  If its key is smaller than the last key
+    // removed, a DigraphException is thrown.
+    void push(std::uint64_t key, const Value& value);
+
+    // pop() removes and returns an entry with the smallest key.  The heap
+    // must not be empty.
+    std::pair<std::uint64_t, Value> pop();
+
+    // clear() removes every entry, and starts counting keys from 0 again.
+    void clear() noexcept;
+
+
+private:
+    std::array<std::vector<std::pair<std::uint64_t, Value>>, 65> buckets_;
+    std::uint64_t last_;
+    std::size_t size_;
+
+    static int bucket(std::uint64_t key, std::uint64_t last) noexcept;
+};
+
+
+
+template <typename Value>
+RadixHeap<Value>::RadixHeap()
+    : last_{0}, size_{0}
+{
+}
+
+
+template <typename Value>
+bool RadixHeap<Value>::empty() const noexcept
+{
+    return size_ == 0;
+}
+
+
+template <typename Value>
+std::size_t RadixHeap<Value>::size() const noexcept
+{
+    return size_;
+}
+
+
+template <typename Value>
+void RadixHeap<Value>::push(std::uint64_t key, const Value& value)
+{
+    if (key < last_)
+    {
+        throw DigraphException{"RadixHeap push(): keys can't be smaller than the last key removed."};
+    }
+
+    buckets_[bucket(key, last_)].emplace_back(key, value);
+    size_++;
+}
+
+
+template <typename Value>
+std::pair<std::uint64_t, Value> RadixHeap<Value>::pop()
+{
+    if (buckets_[0].empty())
+    {
+        int b = 1;
+
+        while (buckets_[b].empty())
+        {
+            ++b;
+        }
+
+        std::uint64_t smallest = buckets_[b].front().first;
+
+        for (auto& entry : buckets_[b])
+        {
+            smallest = entry.first < smallest ? entry.first : smallest;
+        }
+
+        last_ = smallest;
+
+        for (auto& entry : buckets_[b])
+        {
+            buckets_[bucket(entry.first, last_)].push_back(std::move(entry));
+        }
+
+        buckets_[b].clear();
+    }
+
+    std::pair<std::uint64_t, Value> result = std::move(buckets_[0].back());
+    buckets_[0].pop_back();
+    size_--;
+
+    return result;
+}
+
+
+template <typename Value>
+void RadixHeap<Value>::clear() noexcept
+{
+    for (auto& entries : buckets_)
+    {
+        entries.clear();
+    }
+
+    last_ = 0;
+    size_ = 0;
+}
+
+
+template <typename Value>
+int RadixHeap<Value>::bucket(std::uint64_t key, std::uint64_t last) noexcept
+{
+    return key == last ? 0 : 64 - __builtin_clzll(key ^ last);
+}
+
+
+
+#endif
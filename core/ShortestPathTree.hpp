@@ -0,0 +1,342 @@
+// ShortestPathTree.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class template called ShortestPathTree,
+// which stores the result of running Dijkstra's Shortest Path Algorithm
+// from one start vertex of a Digraph (the distance to, and predecessor
+// of, every vertex) and keeps it correct as the weights of individual
+// edges change.
+//
+// Rather than recomputing the whole tree after each change, the tree is
+// repaired incrementally in the style of Ramalingam and Reps:
+//
+// * When an edge gets cheaper, only the vertices whose distance actually
+//   improves are touched, by resuming Dijkstra from the edge's "to" vertex.
+// * When an edge gets more expensive, nothing happens unless the edge is
+//   part of the tree.  If it is, only the subtree hanging below it is
+//   invalidated and then rebuilt from its unaffected neighbors, which are
+//   found through each affected vertex's own incoming edges, so the cost
+//   depends on the size of the subtree rather than the whole graph.
+
+#ifndef SHORTESTPATHTREE_HPP
+#define SHORTESTPATHTREE_HPP
+
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <map>
+#include <queue>
+#include <set>
+#include <utility>
+#include <vector>
+#include "Digraph.hpp"
+
+
+
+template <typename VertexInfo, typename EdgeInfo>
+class ShortestPathTree
+{
+public:
+    // This constructor runs Dijkstra's Shortest Path Algorithm on the
+    // given graph from the given start vertex, using the given function
+    // to determine edge weights.  If the start vertex does not exist, a
+    // DigraphException is thrown.
+    template <typename Allocator>
+    ShortestPathTree(
+        const Digraph<VertexInfo, EdgeInfo, Allocator>& graph, int startVertex,
+        std::function<double(const EdgeInfo&)> edgeWeightFunc);
+
+    // startVertex() returns the vertex number the tree is rooted at.
+    int startVertex() const noexcept;
+
+    // distance() returns the length of the shortest path from the start
+    // vertex to the given vertex, or infinity if it cannot be reached.
+    // If the vertex was not in the graph, a DigraphException is thrown.
+    double distance(int vertex) const;
+
+    // predecessor() returns the vertex before the given one on its
+    // shortest path, or the vertex itself if it has no predecessor.
+    // If the vertex was not in the graph, a DigraphException is thrown.
+    int predecessor(int vertex) const;
+
+    // predecessors() returns the whole tree, in the same form as
+    // Digraph::findShortestPaths() does.
+    const std::map<int, int>& predecessors() const noexcept;
+
+    // edgeUpdated() repairs the tree after the EdgeInfo of the edge from
+    // "fromVertex" to "toVertex" has been changed in the given graph (for
+    // example, with Digraph::updateEdgeInfo()); oldInfo is the EdgeInfo
+    // that the edge had before the change.  It returns the number of
+    // vertices whose distance changed, which is zero whenever the change
+    // cannot affect the tree.
+    template <typename Allocator>
+    int edgeUpdated(
+        const Digraph<VertexInfo, EdgeInfo, Allocator>& graph,
+        int fromVertex, int toVertex, const EdgeInfo& oldInfo);
+
+
+private:
+    using QueueEntry = std::pair<double, int>;
+    using Queue = std::priority_queue<
+        QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>>;
+
+    int startVertex_;
+    std::function<double(const EdgeInfo&)> edgeWeightFunc_;
+    std::map<int, double> dist_;
+    std::map<int, int> pred_;
+    std::map<int, std::set<int>> children_;
+
+    // setPredecessor() moves a vertex under a new parent in the tree.
+    void setPredecessor(int vertex, int pred);
+
+    // propagate() continues Dijkstra's algorithm from whatever is in the
+    // queue, recording every vertex whose distance improves in "changed".
+    template <typename Allocator>
+    void propagate(
+        const Digraph<VertexInfo, EdgeInfo, Allocator>& graph, Queue& pq,
+        std::set<int>& changed);
+};
+
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename Allocator>
+ShortestPathTree<VertexInfo, EdgeInfo>::ShortestPathTree(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& graph, int startVertex,
+    std::function<double(const EdgeInfo&)> edgeWeightFunc)
+    : startVertex_{startVertex}, edgeWeightFunc_{std::move(edgeWeightFunc)}
+{
+    std::vector<int> vertices = graph.vertices();
+
+    if (!std::binary_search(vertices.begin(), vertices.end(), startVertex))
+    {
+        throw DigraphException{"ShortestPathTree: the startVertex is not valid."};
+    }
+
+    for (int vertex : vertices)
+    {
+        dist_[vertex] = std::numeric_limits<double>::infinity();
+        pred_[vertex] = vertex;
+        children_[vertex];
+    }
+
+    dist_[startVertex] = 0.0;
+
+    Queue pq;
+    pq.push({0.0, startVertex});
+
+    std::set<int> changed;
+    propagate(graph, pq, changed);
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int ShortestPathTree<VertexInfo, EdgeInfo>::startVertex() const noexcept
+{
+    return startVertex_;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+double ShortestPathTree<VertexInfo, EdgeInfo>::distance(int vertex) const
+{
+    auto found = dist_.find(vertex);
+
+    if (found == dist_.end())
+    {
+        throw DigraphException{"ShortestPathTree distance(): the vertex does not exist."};
+    }
+
+    return found->second;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+int ShortestPathTree<VertexInfo, EdgeInfo>::predecessor(int vertex) const
+{
+    auto found = pred_.find(vertex);
+
+    if (found == pred_.end())
+    {
+        throw DigraphException{"ShortestPathTree predecessor(): the vertex does not exist."};
+    }
+
+    return found->second;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+const std::map<int, int>& ShortestPathTree<VertexInfo, EdgeInfo>::predecessors() const noexcept
+{
+    return pred_;
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename Allocator>
+int ShortestPathTree<VertexInfo, EdgeInfo>::edgeUpdated(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& graph,
+    int fromVertex, int toVertex, const EdgeInfo& oldInfo)
+{
+    if (dist_.find(fromVertex) == dist_.end() || dist_.find(toVertex) == dist_.end())
+    {
+        throw DigraphException{"ShortestPathTree edgeUpdated(): either of vertices does not exist."};
+    }
+
+    double oldWeight = edgeWeightFunc_(oldInfo);
+    double newWeight = edgeWeightFunc_(graph.edgeInfo(fromVertex, toVertex));
+
+    std::set<int> changed;
+
+    if (newWeight < oldWeight)
+    {
+        // A cheaper edge can only matter if it now improves its "to"
+        // vertex; if it does, everything that improves is reachable
+        // from there.
+        if (dist_[fromVertex] + newWeight < dist_[toVertex])
+        {
+            dist_[toVertex] = dist_[fromVertex] + newWeight;
+            setPredecessor(toVertex, fromVertex);
+            changed.insert(toVertex);
+
+            Queue pq;
+            pq.push({dist_[toVertex], toVertex});
+            propagate(graph, pq, changed);
+        }
+    }
+    else if (newWeight > oldWeight)
+    {
+        // A more expensive edge that isn't in the tree changes nothing.
+        if (toVertex == startVertex_ || pred_[toVertex] != fromVertex)
+        {
+            return 0;
+        }
+
+        // Otherwise, every vertex whose shortest path ran through the
+        // edge (i.e., the subtree rooted at its "to" vertex) has to be
+        // reconsidered; nothing outside that subtree can change.
+        std::map<int, double> oldDist;
+        std::vector<int> stack{toVertex};
+
+        while (!stack.empty())
+        {
+            int vertex = stack.back();
+            stack.pop_back();
+
+            oldDist[vertex] = dist_[vertex];
+
+            for (int child : children_[vertex])
+            {
+                stack.push_back(child);
+            }
+        }
+
+        for (auto& [vertex, d] : oldDist)
+        {
+            setPredecessor(vertex, vertex);
+            dist_[vertex] = std::numeric_limits<double>::infinity();
+        }
+
+        // Each affected vertex starts from its best incoming edge whose
+        // tail lies outside the affected subtree.  Only the affected
+        // vertices' own incoming edges are examined.
+        Queue pq;
+
+        for (auto& [to, d] : oldDist)
+        {
+            for (int from : graph.incomingRange(to))
+            {
+                if (oldDist.count(from) != 0)
+                {
+                    continue;
+                }
+
+                double candidate = dist_[from] + edgeWeightFunc_(graph.edgeInfoRef(from, to));
+
+                if (candidate < dist_[to])
+                {
+                    dist_[to] = candidate;
+                    setPredecessor(to, from);
+                }
+            }
+
+            if (dist_[to] != std::numeric_limits<double>::infinity())
+            {
+                pq.push({dist_[to], to});
+            }
+        }
+
+        propagate(graph, pq, changed);
+
+        changed.clear();
+
+        for (auto& [vertex, d] : oldDist)
+        {
+            if (dist_[vertex] != d)
+            {
+                changed.insert(vertex);
+            }
+        }
+    }
+
+    return changed.size();
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+void ShortestPathTree<VertexInfo, EdgeInfo>::setPredecessor(int vertex, int pred)
+{
+    int oldPred = pred_[vertex];
+
+    if (oldPred != vertex)
+    {
+        children_[oldPred].erase(vertex);
+    }
+
+    pred_[vertex] = pred;
+
+    if (pred != vertex)
+    {
+        children_[pred].insert(vertex);
+    }
+}
+
+
+template <typename VertexInfo, typename EdgeInfo>
+template <typename Allocator>
+void ShortestPathTree<VertexInfo, EdgeInfo>::propagate(
+    const Digraph<VertexInfo, EdgeInfo, Allocator>& graph, Queue& pq,
+    std::set<int>& changed)
+{
+    while (!pq.empty())
+    {
+        auto [d, vNum] = pq.top();
+        pq.pop();
+
+        // stale queue entries are skipped rather than removed
+        if (d > dist_[vNum])
+        {
+            continue;
+        }
+
+        for (const auto& edge : graph.edgeRange(vNum))
+        {
+            int to = edge.toVertex;
+            double candidate = d + edgeWeightFunc_(edge.einfo);
+
+            if (candidate < dist_[to])
+            {
+                dist_[to] = candidate;
+                setPredecessor(to, vNum);
+                changed.insert(to);
+                pq.push({candidate, to});
+            }
+        }
+    }
+}
+
+
+
+#endif
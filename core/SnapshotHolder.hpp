@@ -0,0 +1,120 @@
+// SnapshotHolder.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class template called SnapshotHolder, which
+// publishes immutable versions ("snapshots") of an object to any number of
+// concurrent readers, in the style of read-copy-update.
+//
+// A reader calls current() and keeps the returned std::shared_ptr for as
+// long as it needs a consistent view; a writer builds a complete new
+// version off to the side and calls publish().  Readers that started
+// before the publish keep using the old version, readers that start after
+// it see the new one, and the old version is destroyed automatically when
+// the last reader holding it lets go.
+//
+// The snapshot type T is typically a bundle of a graph together with
+// whatever was precomputed from it, so that a graph and its preprocessing
+// are always swapped together.
+
+#ifndef SNAPSHOTHOLDER_HPP
+#define SNAPSHOTHOLDER_HPP
+
+#include <atomic>
+#include <memory>
+#include <utility>
+
+
+
+template <typename T>
+class SnapshotHolder
+{
+public:
+    // The default constructor initializes a SnapshotHolder that holds no
+    // snapshot yet; current() returns nullptr until something is published.
+    SnapshotHolder();
+
+    // This constructor initializes a SnapshotHolder whose first published
+    // snapshot is the given one.
+    explicit SnapshotHolder(std::shared_ptr<const T> initial);
+
+    // SnapshotHolders are shared between threads by reference, so they
+    // cannot be copied or moved.
+    SnapshotHolder(const SnapshotHolder&) = delete;
+    SnapshotHolder& operator=(const SnapshotHolder&) = delete;
+
+    // current() returns the most recently published snapshot.  The caller
+    // should hold on to the returned pointer for the duration of one
+    // query, rather than calling current() repeatedly, so that the whole
+    // query sees the same version.
+    std::shared_ptr<const T> current() const;
+
+    // publish() atomically replaces the current snapshot with the given
+    // one.  Readers already holding the previous snapshot are unaffected.
+    void publish(std::shared_ptr<const T> next);
+
+    // exchange() is like publish(), but it also returns the snapshot that
+    // was replaced.
+    std::shared_ptr<const T> exchange(std::shared_ptr<const T> next);
+
+    // version() returns the number of snapshots published so far.
+    unsigned long version() const noexcept;
+
+
+private:
+    std::shared_ptr<const T> current_;
+    std::atomic<unsigned long> version_;
+};
+
+
+
+template <typename T>
+SnapshotHolder<T>::SnapshotHolder()
+    : current_{}, version_{0}
+{
+}
+
+
+template <typename T>
+SnapshotHolder<T>::SnapshotHolder(std::shared_ptr<const T> initial)
+    : current_{std::move(initial)}, version_{1}
+{
+}
+
+
+template <typename T>
+std::shared_ptr<const T> SnapshotHolder<T>::current() const
+{
+    return std::atomic_load(&current_);
+}
+
+
+template <typename T>
+void SnapshotHolder<T>::publish(std::shared_ptr<const T> next)
+{
+    exchange(std::move(next));
+}
+
+
+template <typename T>
+std::shared_ptr<const T> SnapshotHolder<T>::exchange(std::shared_ptr<const T> next)
+{
+    std::shared_ptr<const T> previous = std::atomic_exchange(&current_, std::move(next));
+    version_++;
+
+    // Only our reference to the previous snapshot is released here; if any
+    // reader still holds it, it is destroyed when that reader is done.
+    return previous;
+}
+
+
+template <typename T>
+unsigned long SnapshotHolder<T>::version() const noexcept
+{
+    return version_.load();
+}
+
+
+
+#endif
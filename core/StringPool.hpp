@@ -0,0 +1,124 @@
+// StringPool.hpp
+//
+// ICS 46 Winter 2022
+// Project #5: Rock and Roll Stops the Traffic
+//
+// This header file declares a class called StringPool, which "interns"
+// strings: it keeps one copy of each distinct string it's given, packed
+// end to end in large blocks of memory, and hands back std::string_views
+// of those copies.  Interning the same string twice returns the same view,
+// and a view stays valid for as long as the StringPool it came from exists,
+// no matter how many more strings are interned afterward.
+//
+// A graph whose vertices are named with string_views into a StringPool
+// stores each name once, with one allocation per block of names instead of
+// one per name, and can hand its names out without copying them.
+
+#ifndef STRINGPOOL_HPP
+#define STRINGPOOL_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+
+
+class StringPool
+{
+public:
+    // This constructor initializes an empty StringPool that gets memory in
+    // blocks of (at least) the given number of bytes.
+    explicit StringPool(std::size_t blockSize = 64 * 1024);
+
+    StringPool(const StringPool&) = delete;
+    StringPool& operator=(const StringPool&) = delete;
+
+    // intern() returns a view of the pool's copy of the given string,
+    // making that copy first if there isn't one already.
+    std::string_view intern(std::string_view s);
+
+    // contains() returns true if the given view points into the pool's own
+    // copy of a string (as returned by intern()), false otherwise.
+    bool contains(std::string_view s) const noexcept;
+
+    // size() returns the number of distinct strings in the pool.
+    std::size_t size() const noexcept;
+
+    // bytesUsed() returns the total length of the distinct strings in the
+    // pool.
+    std::size_t bytesUsed() const noexcept;
+
+
+private:
+    std::size_t blockSize_;
+    std::vector<std::unique_ptr<char[]>> blocks_;
+    char* next_;
+    std::size_t remaining_;
+    std::size_t bytesUsed_;
+    std::unordered_set<std::string_view> strings_;
+};
+
+
+
+inline StringPool::StringPool(std::size_t blockSize)
+    : blockSize_{blockSize}, next_{nullptr}, remaining_{0}, bytesUsed_{0}
+{
+}
+
+
+inline std::string_view StringPool::intern(std::string_view s)
+{
+    auto found = strings_.find(s);
+
+    if (found != strings_.end())
+    {
+        return *found;
+    }
+
+    if (next_ == nullptr || s.size() > remaining_)
+    {
+        // A string too long for a normal block gets a block of its own;
+        // otherwise, whatever was left of the last block is abandoned.
+        std::size_t size = std::max(blockSize_, s.size());
+        blocks_.emplace_back(new char[size]);
+        next_ = blocks_.back().get();
+        remaining_ = size;
+    }
+
+    std::memcpy(next_, s.data(), s.size());
+    std::string_view copy{next_, s.size()};
+
+    next_ += s.size();
+    remaining_ -= s.size();
+    bytesUsed_ += s.size();
+
+    strings_.insert(copy);
+    return copy;
+}
+
+
+inline bool StringPool::contains(std::string_view s) const noexcept
+{
+    auto found = strings_.find(s);
+    return found != strings_.end() && found->data() == s.data();
+}
+
+
+inline std::size_t StringPool::size() const noexcept
+{
+    return strings_.size();
+}
+
+
+inline std::size_t StringPool::bytesUsed() const noexcept
+{
+    return bytesUsed_;
+}
+
+
+
+#endif
@@ -0,0 +1,131 @@
+#include <cmath>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "AllPairs.hpp"
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+namespace
+{
+    AllPairsMatrix makeMatrix(const Digraph<std::string, double>& d, AllPairsMethod method, int threads)
+    {
+        CompactDigraph g{d};
+        return AllPairsMatrix{g, g.arcWeights<std::string, double>(d, identity), method, threads};
+    }
+
+
+    // The tables store distances as floats, so they only agree with
+    // Dijkstra's algorithm to about seven significant digits.
+    void expectMatchesDijkstra(const Digraph<std::string, double>& d, const AllPairsMatrix& matrix)
+    {
+        for (int from : d.vertices())
+        {
+            ShortestPathTree<std::string, double> tree{d, from, identity};
+
+            for (int to : d.vertices())
+            {
+                double expected = tree.distance(to);
+                DigraphPath path = matrix.shortestPath(from, to);
+
+                if (expected == std::numeric_limits<double>::infinity())
+                {
+                    EXPECT_EQ(expected, matrix.distance(from, to));
+                    EXPECT_TRUE(path.vertices.empty());
+                }
+                else
+                {
+                    EXPECT_NEAR(expected, matrix.distance(from, to), 1e-5 * (1.0 + expected));
+                    ASSERT_FALSE(path.vertices.empty());
+                    EXPECT_EQ(from, path.vertices.front());
+                    EXPECT_EQ(to, path.vertices.back());
+                    EXPECT_NEAR(expected, pathLength(d, path.vertices), 1e-5 * (1.0 + expected));
+                }
+            }
+        }
+    }
+}
+
+
+TEST(AllPairsTests, floydWarshallMatchesDijkstra)
+{
+    Digraph<std::string, double> d = makeRandomGrid(12, 31, 0.3);
+    AllPairsMatrix matrix = makeMatrix(d, AllPairsMethod::FloydWarshall, 3);
+
+    EXPECT_EQ(144, matrix.vertexCount());
+    expectMatchesDijkstra(d, matrix);
+}
+
+
+TEST(AllPairsTests, parallelSearchesMatchDijkstra)
+{
+    Digraph<std::string, double> d = makeRandomGrid(12, 32, 0.3);
+    AllPairsMatrix matrix = makeMatrix(d, AllPairsMethod::Dijkstra, 3);
+
+    EXPECT_EQ(144, matrix.vertexCount());
+    expectMatchesDijkstra(d, matrix);
+}
+
+
+TEST(AllPairsTests, denserGraphsPreferFloydWarshall)
+{
+    EXPECT_EQ(AllPairsMethod::FloydWarshall, chooseAllPairsMethod(100, 10000));
+    EXPECT_EQ(AllPairsMethod::Dijkstra, chooseAllPairsMethod(20000, 50000));
+}
+
+
+TEST(AllPairsTests, badInputThrows)
+{
+    Digraph<std::string, double> d = makeRandomGrid(2, 1);
+    CompactDigraph g{d};
+    std::vector<double> weights = g.arcWeights<std::string, double>(d, identity);
+
+    EXPECT_THROW((AllPairsMatrix{g, {1.0}}), DigraphException);
+
+    weights[0] = -1.0;
+    EXPECT_THROW((AllPairsMatrix{g, weights}), DigraphException);
+
+    AllPairsMatrix matrix = makeMatrix(d, AllPairsMethod::Automatic, 1);
+    EXPECT_THROW(matrix.distance(0, 5), DigraphException);
+    EXPECT_THROW(matrix.shortestPath(5, 0), DigraphException);
+}
+
+
+TEST(AllPairsTests, matricesSurviveSavingAndMapping)
+{
+    Digraph<std::string, double> d = makeRandomGrid(9, 33, 0.3);
+    std::string path = ::testing::TempDir() + "AllPairsTests.matrix";
+
+    makeMatrix(d, AllPairsMethod::Automatic, 2).save(path, 42);
+
+    {
+        AllPairsMatrix mapped = AllPairsMatrix::map(path, 42);
+        EXPECT_EQ(81, mapped.vertexCount());
+        expectMatchesDijkstra(d, mapped);
+    }
+
+    EXPECT_THROW(AllPairsMatrix::map(path, 43), DigraphException);
+    std::remove(path.c_str());
+}
+
+
+TEST(AllPairsTests, mappingSomethingElseThrows)
+{
+    std::string path = ::testing::TempDir() + "AllPairsTests.garbage";
+
+    {
+        std::ofstream out{path, std::ios::binary};
+        out << "not an all-pairs matrix at all";
+    }
+
+    EXPECT_THROW(AllPairsMatrix::map(path), DigraphException);
+    std::remove(path.c_str());
+
+    EXPECT_THROW(AllPairsMatrix::map(path), DigraphException);
+}
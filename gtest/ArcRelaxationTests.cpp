@@ -0,0 +1,103 @@
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ArcRelaxation.hpp"
+
+
+namespace
+{
+    // relaxOneAtATime() is the plain loop that relaxArcs() has to agree
+    // with, whether or not it's using vector instructions.
+    std::vector<std::pair<int, double>> relaxOneAtATime(
+        const std::vector<int>& heads, const std::vector<double>& weights, double base,
+        std::vector<double>& distances)
+    {
+        std::vector<std::pair<int, double>> improvements;
+
+        for (std::size_t i = 0; i < heads.size(); ++i)
+        {
+            double candidate = base + weights[i];
+
+            if (candidate < distances[heads[i]])
+            {
+                distances[heads[i]] = candidate;
+                improvements.push_back({i, candidate});
+            }
+        }
+
+        return improvements;
+    }
+}
+
+
+TEST(ArcRelaxationTests, onlyImprovingArcsAreReported)
+{
+    std::vector<int> heads{0, 1, 2, 3, 4};
+    std::vector<double> weights{1.0, 5.0, 2.0, 9.0, 0.5};
+    std::vector<double> distances{0.0, 20.0, 12.0, std::numeric_limits<double>::infinity(), 10.5};
+    std::vector<std::pair<int, double>> improvements;
+
+    relaxArcs(heads.data(), weights.data(), 5, 10.0, distances.data(),
+        [&](int i, double candidate) { improvements.push_back({i, candidate}); });
+
+    std::vector<std::pair<int, double>> expected{{1, 15.0}, {3, 19.0}};
+    EXPECT_EQ(expected, improvements);
+    EXPECT_EQ(15.0, distances[1]);
+    EXPECT_EQ(12.0, distances[2]);
+    EXPECT_EQ(19.0, distances[3]);
+    EXPECT_EQ(10.5, distances[4]);
+}
+
+
+TEST(ArcRelaxationTests, repeatedHeadsKeepTheBestCandidate)
+{
+    std::vector<int> heads{2, 2, 2, 2, 2, 2};
+    std::vector<double> weights{9.0, 7.0, 8.0, 3.0, 3.0, 1.0};
+    std::vector<double> distances(3, std::numeric_limits<double>::infinity());
+    std::vector<int> improved;
+
+    relaxArcs(heads.data(), weights.data(), 6, 0.0, distances.data(),
+        [&](int i, double) { improved.push_back(i); });
+
+    std::vector<int> expected{0, 1, 3, 5};
+    EXPECT_EQ(expected, improved);
+    EXPECT_EQ(1.0, distances[2]);
+}
+
+
+TEST(ArcRelaxationTests, agreesWithRelaxingOneAtATime)
+{
+    std::mt19937 random{44};
+    std::uniform_int_distribution<int> head{0, 99};
+    std::uniform_real_distribution<double> weight{0.0, 10.0};
+
+    for (int count = 0; count < 40; ++count)
+    {
+        std::vector<int> heads(count);
+        std::vector<double> weights(count);
+        std::vector<double> distances(100);
+
+        for (int i = 0; i < count; ++i)
+        {
+            heads[i] = head(random);
+            weights[i] = weight(random);
+        }
+
+        for (double& d : distances)
+        {
+            d = random() % 4 == 0 ? std::numeric_limits<double>::infinity() : weight(random) + 3.0;
+        }
+
+        std::vector<double> expectedDistances = distances;
+        auto expected = relaxOneAtATime(heads, weights, 3.0, expectedDistances);
+
+        std::vector<std::pair<int, double>> improvements;
+        relaxArcs(heads.data(), weights.data(), count, 3.0, distances.data(),
+            [&](int i, double candidate) { improvements.push_back({i, candidate}); });
+
+        EXPECT_EQ(expected, improvements);
+        EXPECT_EQ(expectedDistances, distances);
+    }
+}
@@ -0,0 +1,132 @@
+#include <cstdint>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "ArenaAllocator.hpp"
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+namespace
+{
+    using ArenaDigraph = Digraph<std::string, double, ArenaAllocator<char>>;
+
+
+    void copyInto(const Digraph<std::string, double>& from, ArenaDigraph& to)
+    {
+        for (int v : from.vertices())
+        {
+            to.addVertex(v, from.vertexInfo(v));
+        }
+
+        for (auto [a, b] : from.edges())
+        {
+            to.addEdge(a, b, from.edgeInfo(a, b));
+        }
+    }
+}
+
+
+TEST(ArenaAllocatorTests, allocationsAreAlignedAndCounted)
+{
+    Arena arena{256};
+
+    void* a = arena.allocate(3, 1);
+    void* b = arena.allocate(8, 8);
+    void* c = arena.allocate(1000, 64);
+
+    EXPECT_NE(a, b);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(b) % 8);
+    EXPECT_EQ(0u, reinterpret_cast<std::uintptr_t>(c) % 64);
+    EXPECT_EQ(1011u, arena.bytesAllocated());
+
+    arena.release();
+    EXPECT_EQ(0u, arena.bytesAllocated());
+
+    EXPECT_THROW(arena.allocate(8, 3), DigraphException);
+}
+
+
+TEST(ArenaAllocatorTests, allocatorsShareTheirArena)
+{
+    Arena arena;
+    ArenaAllocator<int> ints{arena};
+    ArenaAllocator<double> doubles{ints};
+
+    EXPECT_EQ(&arena, doubles.arena());
+    EXPECT_TRUE(ints == doubles);
+    EXPECT_TRUE(ints != ArenaAllocator<int>{});
+
+    std::vector<int, ArenaAllocator<int>> v{ints};
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        v.push_back(i);
+    }
+
+    EXPECT_EQ(999, v.back());
+    EXPECT_GE(arena.bytesAllocated(), 1000 * sizeof(int));
+}
+
+
+TEST(ArenaAllocatorTests, arenaDigraphsBehaveLikeOrdinaryOnes)
+{
+    Arena arena;
+    ArenaDigraph d{arena};
+
+    d.addVertex(1, "one");
+    d.addVertex(2, "two");
+    d.addVertex(3, "three");
+    d.addEdge(1, 2, 12.0);
+    d.addEdge(2, 3, 23.0);
+    d.addEdge(3, 1, 31.0);
+
+    EXPECT_GT(arena.bytesAllocated(), 0u);
+    EXPECT_TRUE(d.isStronglyConnected());
+
+    ArenaDigraph copy{d};
+    copy.removeVertex(2);
+    EXPECT_EQ(3, d.vertexCount());
+    EXPECT_EQ(2, copy.vertexCount());
+    EXPECT_EQ(1, copy.edgeCount());
+
+    ArenaDigraph moved{std::move(copy)};
+    EXPECT_EQ(2, moved.vertexCount());
+    EXPECT_EQ(31.0, moved.edgeInfo(3, 1));
+
+    d.removeEdge(3, 1);
+    EXPECT_FALSE(d.isStronglyConnected());
+
+    std::map<int, int> paths = d.findShortestPaths(1, identity);
+    EXPECT_EQ(2, paths.at(3));
+}
+
+
+TEST(ArenaAllocatorTests, arenaDigraphsFindTheSamePaths)
+{
+    Digraph<std::string, double> ordinary = makeRandomGrid(15, 41, 0.3);
+
+    Arena arena;
+    ArenaDigraph d{arena};
+    copyInto(ordinary, d);
+
+    CompactDigraph ordinaryGraph{ordinary};
+    CompactDigraph arenaGraph{d};
+    EXPECT_EQ(ordinaryGraph.arcCount(), arenaGraph.arcCount());
+
+    for (int start : {0, 1120, 2240})
+    {
+        ShortestPathTree<std::string, double> tree{d, start, identity};
+
+        for (int v : ordinary.vertices())
+        {
+            EXPECT_TRUE(sameDistance(dijkstraDistance(ordinary, start, v), tree.distance(v)));
+        }
+
+        EXPECT_EQ(ordinary.findShortestPaths(start, identity), d.findShortestPaths(start, identity));
+    }
+}
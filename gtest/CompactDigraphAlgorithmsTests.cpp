@@ -0,0 +1,117 @@
+#include <limits>
+#include <set>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "CompactDigraphAlgorithms.hpp"
+#include "Digraph.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+TEST(CompactDigraphAlgorithmsTests, dijkstraMatchesShortestPathTree)
+{
+    Digraph<std::string, double> d = makeRandomGrid(15, 41, 0.3);
+
+    for (VertexOrder order : {VertexOrder::VertexNumber, VertexOrder::CuthillMcKee})
+    {
+        CompactDigraph g{d, order};
+        std::vector<double> weights = g.arcWeights<std::string, double>(d, identity);
+
+        for (int start : {0, 1120, 2240})
+        {
+            ShortestPathTree<std::string, double> tree{d, start, identity};
+            SingleSourcePaths paths = dijkstraShortestPaths(g, weights, g.index(start));
+
+            for (int v = 0; v < g.vertexCount(); ++v)
+            {
+                EXPECT_TRUE(sameDistance(tree.distance(g.vertexNumber(v)), paths.distances[v]));
+
+                if (paths.predecessors[v] != -1)
+                {
+                    int arc = g.findArc(paths.predecessors[v], v);
+                    ASSERT_NE(-1, arc);
+                    EXPECT_EQ(paths.distances[v], paths.distances[paths.predecessors[v]] + weights[arc]);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(CompactDigraphAlgorithmsTests, dijkstraBadInputThrows)
+{
+    Digraph<std::string, double> d = makeRandomGrid(2, 1);
+    CompactDigraph g{d};
+
+    EXPECT_THROW(dijkstraShortestPaths(g, {1.0}, 0), DigraphException);
+    EXPECT_THROW(dijkstraShortestPaths(g, std::vector<double>(g.arcCount(), 1.0), 4), DigraphException);
+}
+
+
+TEST(CompactDigraphAlgorithmsTests, componentsOfASmallGraph)
+{
+    // 1 <-> 2 -> 3 <-> 4, and 5 by itself
+    Digraph<std::string, double> d;
+
+    for (int v = 1; v <= 5; ++v)
+    {
+        d.addVertex(v, std::to_string(v));
+    }
+
+    d.addEdge(1, 2, 1.0);
+    d.addEdge(2, 1, 1.0);
+    d.addEdge(2, 3, 1.0);
+    d.addEdge(3, 4, 1.0);
+    d.addEdge(4, 3, 1.0);
+
+    CompactDigraph g{d};
+    std::vector<int> component = stronglyConnectedComponents(g);
+
+    EXPECT_EQ(component[g.index(1)], component[g.index(2)]);
+    EXPECT_EQ(component[g.index(3)], component[g.index(4)]);
+    EXPECT_NE(component[g.index(1)], component[g.index(3)]);
+    EXPECT_NE(component[g.index(5)], component[g.index(1)]);
+    EXPECT_NE(component[g.index(5)], component[g.index(3)]);
+    EXPECT_EQ(3, std::set<int>(component.begin(), component.end()).size());
+    EXPECT_FALSE(isStronglyConnected(g));
+
+    d.addEdge(3, 2, 1.0);
+    d.addEdge(5, 1, 1.0);
+    d.addEdge(4, 5, 1.0);
+    EXPECT_TRUE(isStronglyConnected(CompactDigraph{d}));
+}
+
+
+TEST(CompactDigraphAlgorithmsTests, agreesWithDigraphOnRandomGrids)
+{
+    for (unsigned int seed = 1; seed <= 10; ++seed)
+    {
+        Digraph<std::string, double> d = makeRandomGrid(6, seed, 0.3);
+
+        EXPECT_EQ(d.isStronglyConnected(), isStronglyConnected(CompactDigraph{d}));
+        EXPECT_EQ(d.isStronglyConnected(), isStronglyConnected(CompactDigraph{d, VertexOrder::CuthillMcKee}));
+    }
+
+    EXPECT_TRUE(isStronglyConnected(CompactDigraph{}));
+}
+
+
+TEST(CompactDigraphAlgorithmsTests, longPathsDontOverflowTheStack)
+{
+    Digraph<std::string, double> d;
+    int n = 200000;
+
+    for (int v = 0; v < n; ++v)
+    {
+        d.addVertex(v, "");
+    }
+
+    for (int v = 0; v < n; ++v)
+    {
+        d.addEdge(v, (v + 1) % n, 1.0);
+    }
+
+    EXPECT_TRUE(isStronglyConnected(CompactDigraph{d}));
+}
@@ -0,0 +1,213 @@
+#include <algorithm>
+#include <cstdlib>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "ParallelFor.hpp"
+#include "RandomGraphs.hpp"
+
+
+namespace
+{
+    Digraph<std::string, double> makeSmallGraph()
+    {
+        Digraph<std::string, double> d;
+        d.addVertex(7, "a");
+        d.addVertex(3, "b");
+        d.addVertex(11, "c");
+        d.addEdge(7, 3, 1.0);
+        d.addEdge(7, 11, 2.0);
+        d.addEdge(11, 3, 3.0);
+        d.addEdge(3, 7, 4.0);
+        return d;
+    }
+
+
+    // shuffledGrid() returns a random grid whose vertex numbers are in no
+    // particular order, like those in an input file.
+    Digraph<std::string, double> shuffledGrid(int size, unsigned int seed)
+    {
+        Digraph<std::string, double> grid = makeRandomGrid(size, seed, 0.2);
+        std::vector<int> numbers(size * size);
+        std::iota(numbers.begin(), numbers.end(), 0);
+        std::shuffle(numbers.begin(), numbers.end(), std::mt19937{seed});
+
+        Digraph<std::string, double> d;
+
+        for (int v : grid.vertices())
+        {
+            d.addVertex(numbers[v / 10], grid.vertexInfo(v));
+        }
+
+        for (auto& [from, to] : grid.edges())
+        {
+            d.addEdge(numbers[from / 10], numbers[to / 10], grid.edgeInfo(from, to));
+        }
+
+        return d;
+    }
+
+
+    int bandwidth(const CompactDigraph& g)
+    {
+        int result = 0;
+
+        for (int arc = 0; arc < g.arcCount(); ++arc)
+        {
+            result = std::max(result, std::abs(g.arcHead(arc) - g.arcTail(arc)));
+        }
+
+        return result;
+    }
+}
+
+
+TEST(CompactDigraphTests, emptyCompactDigraph)
+{
+    CompactDigraph g;
+    EXPECT_EQ(0, g.vertexCount());
+    EXPECT_EQ(0, g.arcCount());
+    EXPECT_THROW(g.index(0), DigraphException);
+}
+
+
+TEST(CompactDigraphTests, indicesFollowVertexNumbers)
+{
+    CompactDigraph g{makeSmallGraph()};
+
+    EXPECT_EQ(3, g.vertexCount());
+    EXPECT_EQ(4, g.arcCount());
+    EXPECT_EQ(0, g.index(3));
+    EXPECT_EQ(1, g.index(7));
+    EXPECT_EQ(2, g.index(11));
+    EXPECT_EQ(11, g.vertexNumber(2));
+    EXPECT_THROW(g.index(4), DigraphException);
+}
+
+
+TEST(CompactDigraphTests, predecessorPathsWalkBackToTheStart)
+{
+    CompactDigraph g{makeSmallGraph()};
+
+    // From 7 (index 1), 11 (index 2) is reached directly, 3 (index 0)
+    // by way of 11.
+    std::vector<int> predecessors{2, -1, 1};
+
+    EXPECT_EQ((std::vector<int>{7, 11, 3}), predecessorPath(g, predecessors, 7, 3));
+    EXPECT_EQ((std::vector<int>{7}), predecessorPath(g, predecessors, 7, 7));
+
+    std::vector<int> unreached{-1, -1, 1};
+    EXPECT_TRUE(predecessorPath(g, unreached, 7, 3).empty());
+}
+
+
+TEST(CompactDigraphTests, arcsAndReverseArcs)
+{
+    Digraph<std::string, double> d = makeSmallGraph();
+    CompactDigraph g{d};
+    std::vector<double> weights = g.arcWeights<std::string, double>(
+        d, [](const double& e){ return e * 10; });
+
+    int seven = g.index(7);
+    ASSERT_EQ(2, g.arcEnd(seven) - g.arcBegin(seven));
+
+    for (int arc = 0; arc < g.arcCount(); ++arc)
+    {
+        int from = g.vertexNumber(g.arcTail(arc));
+        int to = g.vertexNumber(g.arcHead(arc));
+        EXPECT_EQ(d.edgeInfo(from, to) * 10, weights[arc]);
+    }
+
+    int three = g.index(3);
+    std::vector<int> into;
+
+    for (int position = g.reverseArcBegin(three); position < g.reverseArcEnd(three); ++position)
+    {
+        int arc = g.reverseArc(position);
+        EXPECT_EQ(three, g.arcHead(arc));
+        into.push_back(g.vertexNumber(g.arcTail(arc)));
+    }
+
+    std::sort(into.begin(), into.end());
+    EXPECT_EQ((std::vector<int>{7, 11}), into);
+}
+
+
+TEST(CompactDigraphTests, cuthillMcKeeOrderKeepsTheSameGraph)
+{
+    Digraph<std::string, double> d = shuffledGrid(10, 37);
+    CompactDigraph g{d, VertexOrder::CuthillMcKee};
+
+    ASSERT_EQ(d.vertexCount(), g.vertexCount());
+    ASSERT_EQ(d.edgeCount(), g.arcCount());
+
+    std::vector<double> weights = g.arcWeights<std::string, double>(
+        d, [](const double& e){ return e; });
+
+    for (int v = 0; v < g.vertexCount(); ++v)
+    {
+        EXPECT_EQ(v, g.index(g.vertexNumber(v)));
+        EXPECT_EQ(d.edgeCount(g.vertexNumber(v)), g.arcEnd(v) - g.arcBegin(v));
+
+        for (int arc = g.arcBegin(v); arc < g.arcEnd(v); ++arc)
+        {
+            EXPECT_EQ(v, g.arcTail(arc));
+            EXPECT_EQ(d.edgeInfo(g.vertexNumber(v), g.vertexNumber(g.arcHead(arc))), weights[arc]);
+        }
+
+        for (int i = g.reverseArcBegin(v); i < g.reverseArcEnd(v); ++i)
+        {
+            EXPECT_EQ(v, g.arcHead(g.reverseArc(i)));
+        }
+    }
+}
+
+
+TEST(CompactDigraphTests, cuthillMcKeeOrderKeepsNeighborsClose)
+{
+    Digraph<std::string, double> d = shuffledGrid(20, 38);
+
+    // In a grid, breadth-first levels are diagonals of at most 20 vertices.
+    EXPECT_LE(bandwidth(CompactDigraph{d, VertexOrder::CuthillMcKee}), 40);
+    EXPECT_GT(bandwidth(CompactDigraph{d}), 200);
+}
+
+
+TEST(CompactDigraphTests, cuthillMcKeeOrderCoversEveryComponent)
+{
+    Digraph<std::string, double> d = makeSmallGraph();
+    d.addVertex(20, "d");
+    d.addVertex(21, "e");
+    d.addEdge(21, 20, 1.0);
+
+    CompactDigraph g{d, VertexOrder::CuthillMcKee};
+    std::vector<int> numbers;
+
+    for (int v = 0; v < g.vertexCount(); ++v)
+    {
+        numbers.push_back(g.vertexNumber(v));
+    }
+
+    std::sort(numbers.begin(), numbers.end());
+    EXPECT_EQ(d.vertices(), numbers);
+}
+
+
+TEST(CompactDigraphTests, parallelForVisitsEveryIndexOnce)
+{
+    std::vector<int> visits(1000, 0);
+    parallelFor(0, 1000, 4, [&](int i) { visits[i]++; });
+
+    for (int v : visits)
+    {
+        EXPECT_EQ(1, v);
+    }
+
+    EXPECT_THROW(
+        parallelFor(0, 10, 3, [](int i) { if (i == 7) throw DigraphException{"x"}; }),
+        DigraphException);
+}
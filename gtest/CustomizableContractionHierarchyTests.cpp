@@ -0,0 +1,112 @@
+#include <algorithm>
+#include <limits>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "CustomizableContractionHierarchy.hpp"
+#include "Digraph.hpp"
+#include "NestedDissection.hpp"
+#include "RandomGraphs.hpp"
+
+
+TEST(CustomizableContractionHierarchyTests, nestedDissectionOrderIsAPermutation)
+{
+    CompactDigraph g{makeRandomGrid(12, 3)};
+    std::vector<int> order = nestedDissectionOrder(g, 4);
+
+    std::sort(order.begin(), order.end());
+    for (int i = 0; i < g.vertexCount(); ++i)
+    {
+        EXPECT_EQ(i, order[i]);
+    }
+}
+
+
+TEST(CustomizableContractionHierarchyTests, badOrderThrows)
+{
+    CompactDigraph g{makeRandomGrid(2, 3)};
+    EXPECT_THROW((CustomizableContractionHierarchy{g, {0, 1, 1, 2}}), DigraphException);
+    EXPECT_THROW((CustomizableContractionHierarchy{g, {0, 1}}), DigraphException);
+}
+
+
+TEST(CustomizableContractionHierarchyTests, distancesMatchDijkstra)
+{
+    Digraph<std::string, double> d = makeRandomGrid(10, 7, 0.3);
+    CompactDigraph g{d};
+    CustomizableContractionHierarchy cch{g};
+    CustomizedMetric metric{cch, g.arcWeights<std::string, double>(d, identity)};
+    HierarchyQuery query{metric};
+
+    for (int from : {0, 170, 550, 990})
+    {
+        ShortestPathTree<std::string, double> tree{d, from, identity};
+
+        for (int to : d.vertices())
+        {
+            DigraphPath path = query.shortestPath(from, to);
+            EXPECT_TRUE(sameDistance(tree.distance(to), query.distance(from, to)));
+
+            if (tree.distance(to) == std::numeric_limits<double>::infinity())
+            {
+                EXPECT_TRUE(path.vertices.empty());
+            }
+            else
+            {
+                ASSERT_FALSE(path.vertices.empty());
+                EXPECT_EQ(from, path.vertices.front());
+                EXPECT_EQ(to, path.vertices.back());
+                EXPECT_NEAR(tree.distance(to), path.length, 1e-9);
+                EXPECT_NEAR(tree.distance(to), pathLength(d, path.vertices), 1e-9);
+            }
+        }
+    }
+}
+
+
+TEST(CustomizableContractionHierarchyTests, recustomizingForANewMetric)
+{
+    Digraph<std::string, double> d = makeRandomGrid(8, 11);
+    CompactDigraph g{d};
+    CustomizableContractionHierarchy cch{g};
+
+    auto squared = [](const double& e) { return e * e; };
+    CustomizedMetric metric{cch, g.arcWeights<std::string, double>(d, squared), 1};
+    CustomizedMetric parallel{cch, g.arcWeights<std::string, double>(d, squared), 4};
+    HierarchyQuery query{metric};
+
+    ShortestPathTree<std::string, double> tree{d, 90, squared};
+
+    for (int to : d.vertices())
+    {
+        EXPECT_TRUE(sameDistance(tree.distance(to), query.distance(90, to)));
+    }
+
+    for (int edge = 0; edge < cch.edgeCount(); ++edge)
+    {
+        EXPECT_EQ(metric.upWeight(edge), parallel.upWeight(edge));
+        EXPECT_EQ(metric.downWeight(edge), parallel.downWeight(edge));
+    }
+}
+
+
+TEST(CustomizableContractionHierarchyTests, disconnectedVerticesAreUnreachable)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addVertex(2, "c");
+    d.addEdge(0, 1, 1.0);
+
+    CompactDigraph g{d};
+    CustomizableContractionHierarchy cch{g};
+    CustomizedMetric metric{cch, g.arcWeights<std::string, double>(d, identity)};
+    HierarchyQuery query{metric};
+
+    EXPECT_EQ(1.0, query.distance(0, 1));
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), query.distance(1, 0));
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), query.distance(0, 2));
+    EXPECT_EQ(0.0, query.distance(2, 2));
+    EXPECT_THROW(query.distance(0, 3), DigraphException);
+}
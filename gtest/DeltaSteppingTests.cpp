@@ -0,0 +1,115 @@
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "DeltaStepping.hpp"
+#include "Digraph.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+namespace
+{
+    void expectShortestPathTree(
+        const CompactDigraph& g, const std::vector<double>& weights, int start,
+        const SingleSourcePaths& paths)
+    {
+        for (int v = 0; v < g.vertexCount(); ++v)
+        {
+            int p = paths.predecessors[v];
+
+            if (v == start || paths.distances[v] == std::numeric_limits<double>::infinity())
+            {
+                EXPECT_EQ(-1, p);
+            }
+            else
+            {
+                ASSERT_NE(-1, p);
+                int arc = g.findArc(p, v);
+                ASSERT_NE(-1, arc);
+                EXPECT_EQ(paths.distances[v], paths.distances[p] + weights[arc]);
+            }
+        }
+    }
+}
+
+
+TEST(DeltaSteppingTests, distancesAreIdenticalToDijkstra)
+{
+    Digraph<std::string, double> d = makeRandomGrid(30, 17, 0.3);
+    CompactDigraph g{d};
+    std::vector<double> weights = g.arcWeights<std::string, double>(d, identity);
+
+    for (int threads : {1, 4})
+    {
+        for (double delta : {0.0, 0.5, 3.0, 100.0})
+        {
+            SingleSourcePaths paths = deltaSteppingShortestPaths(g, weights, g.index(4650), threads, delta);
+            ShortestPathTree<std::string, double> tree{d, 4650, identity};
+
+            for (int v = 0; v < g.vertexCount(); ++v)
+            {
+                EXPECT_EQ(tree.distance(g.vertexNumber(v)), paths.distances[v]);
+            }
+
+            expectShortestPathTree(g, weights, g.index(4650), paths);
+        }
+    }
+}
+
+
+TEST(DeltaSteppingTests, matchesFindShortestPathsWhenPathsAreUnique)
+{
+    Digraph<std::string, double> d = makeRandomGrid(20, 5, 0.2);
+
+    auto parallel = [&](int start, int threads)
+        {
+            return findShortestPathsInParallel<std::string, double>(d, start, identity, threads);
+        };
+
+    EXPECT_EQ(d.findShortestPaths(0, identity), parallel(0, 3));
+    EXPECT_EQ(d.findShortestPaths(1230, identity), parallel(1230, 1));
+    EXPECT_THROW(parallel(7, 2), DigraphException);
+}
+
+
+TEST(DeltaSteppingTests, zeroWeightsGiveATree)
+{
+    Digraph<std::string, double> d;
+
+    for (int v = 0; v < 5; ++v)
+    {
+        d.addVertex(v, "");
+    }
+
+    d.addEdge(0, 1, 2.0);
+    d.addEdge(1, 2, 0.0);
+    d.addEdge(2, 1, 0.0);
+    d.addEdge(2, 3, 0.0);
+    d.addEdge(3, 2, 0.0);
+
+    CompactDigraph g{d};
+    std::vector<double> weights = g.arcWeights<std::string, double>(d, identity);
+    SingleSourcePaths paths = deltaSteppingShortestPaths(g, weights, 0, 2);
+
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), paths.distances[4]);
+    EXPECT_EQ(0, paths.predecessors[1]);
+    EXPECT_EQ(1, paths.predecessors[2]);
+    EXPECT_EQ(2, paths.predecessors[3]);
+    expectShortestPathTree(g, weights, 0, paths);
+}
+
+
+TEST(DeltaSteppingTests, badInputThrows)
+{
+    CompactDigraph g{makeRandomGrid(2, 1)};
+    std::vector<double> weights(g.arcCount(), 1.0);
+
+    EXPECT_THROW(deltaSteppingShortestPaths(g, weights, 4), DigraphException);
+    EXPECT_THROW(deltaSteppingShortestPaths(g, {1.0}, 0), DigraphException);
+
+    weights[2] = -1.0;
+    EXPECT_THROW(deltaSteppingShortestPaths(g, weights, 0), DigraphException);
+}
@@ -133,6 +133,62 @@ TEST(DigraphTests, edgesReturnVectorOfAllEdgesAtGivenVertexNumber)
 }
 
 
+TEST(DigraphTests, vertexRangeVisitsTheSameVerticesAsVertices)
+{
+    Digraph<std::string, int> d;
+    EXPECT_TRUE(d.vertexRange().empty());
+
+    d.addVertex(3, "a");
+    d.addVertex(-1, "b");
+    d.addVertex(7, "c");
+
+    std::vector<int> v;
+    for (int vertex : d.vertexRange())
+    {
+        v.push_back(vertex);
+    }
+
+    EXPECT_EQ(d.vertices(), v);
+}
+
+
+TEST(DigraphTests, edgeRangeVisitsTheSameEdgesAsEdges)
+{
+    Digraph<std::string, int> d;
+
+    for (int i = 0; i < 6; i++)
+    {
+        d.addVertex(i, "v");
+    }
+
+    EXPECT_TRUE(d.edgeRange().empty());
+
+    d.addEdge(1, 4, 14);
+    d.addEdge(1, 2, 12);
+    d.addEdge(4, 0, 40);
+    d.addEdge(5, 1, 51);
+
+    std::vector<std::pair<int, int>> e;
+    for (const DigraphEdge<int>& edge : d.edgeRange())
+    {
+        e.push_back({edge.fromVertex, edge.toVertex});
+        EXPECT_EQ(d.edgeInfo(edge.fromVertex, edge.toVertex), edge.einfo);
+    }
+
+    EXPECT_EQ(d.edges(), e);
+
+    std::vector<std::pair<int, int>> e1;
+    for (const DigraphEdge<int>& edge : d.edgeRange(1))
+    {
+        e1.push_back({edge.fromVertex, edge.toVertex});
+    }
+
+    EXPECT_EQ(d.edges(1), e1);
+    EXPECT_TRUE(d.edgeRange(3).empty());
+    EXPECT_THROW(d.edgeRange(6), DigraphException);
+}
+
+
 TEST(DigraphTests, vertexInfo)
 {
     Digraph<std::string, int> d;
@@ -151,6 +207,53 @@ TEST(DigraphTests, vertexInfo)
 }
 
 
+TEST(DigraphTests, vertexInfoRef)
+{
+    Digraph<std::string, int> d;
+
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+
+    const std::string& a = d.vertexInfoRef(0);
+    d.addVertex(2, "c");
+    d.removeVertex(1);
+
+    EXPECT_THROW(d.vertexInfoRef(1), DigraphException);
+    EXPECT_EQ("a", a);
+    EXPECT_EQ(&a, &d.vertexInfoRef(0));
+    EXPECT_EQ("c", d.vertexInfoRef(2));
+}
+
+
+TEST(DigraphTests, incomingRangeAndEdgeInfoRef)
+{
+    Digraph<std::string, int> d;
+
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addVertex(2, "c");
+    d.addEdge(0, 2, 5);
+    d.addEdge(1, 2, 7);
+    d.addEdge(2, 0, 9);
+    d.removeEdge(0, 2);
+
+    std::vector<int> incoming;
+
+    for (int from : d.incomingRange(2))
+    {
+        incoming.push_back(from);
+    }
+
+    EXPECT_EQ(std::vector<int>{1}, incoming);
+    EXPECT_TRUE(d.incomingRange(1).empty());
+    EXPECT_EQ(7, d.edgeInfoRef(1, 2));
+    EXPECT_EQ(9, d.edgeInfoRef(2, 0));
+
+    EXPECT_THROW(d.incomingRange(3), DigraphException);
+    EXPECT_THROW(d.edgeInfoRef(0, 2), DigraphException);
+}
+
+
 TEST(DigraphTests, edgeInfo)
 {
     Digraph<std::string, int> d;
@@ -198,6 +301,42 @@ TEST(DigraphTests, removeVertex)
 }
 
 
+TEST(DigraphTests, removeVertexOnlyRemovesItsOwnEdges)
+{
+    Digraph<std::string, int> d;
+
+    for (int i = 0; i < 5; i++)
+    {
+        d.addVertex(i, "v");
+    }
+
+    d.addEdge(0, 2, 2);
+    d.addEdge(1, 2, 12);
+    d.addEdge(2, 2, 22);
+    d.addEdge(2, 3, 23);
+    d.addEdge(3, 2, 32);
+    d.addEdge(3, 4, 34);
+    d.addEdge(4, 0, 40);
+    d.removeEdge(0, 2);
+    d.addEdge(0, 2, 2);
+
+    d.removeVertex(2);
+
+    std::vector<std::pair<int, int>> e{{3, 4}, {4, 0}};
+    EXPECT_EQ(e, d.edges());
+    EXPECT_EQ(2, d.edgeCount());
+
+    d.addVertex(2, "again");
+    d.addEdge(2, 3, 23);
+    d.addEdge(3, 2, 32);
+    d.removeVertex(3);
+
+    EXPECT_EQ(0, d.edgeCount(2));
+    std::vector<std::pair<int, int>> e2{{4, 0}};
+    EXPECT_EQ(e2, d.edges());
+}
+
+
 TEST(DigraphTests, removeEdge)
 {
     Digraph<std::string, int> d;
@@ -345,6 +484,47 @@ TEST(DigraphTests, moveAssignmentOperator)
 }
 
 
+TEST(DigraphTests, edgesCanStillBeFoundInCopiesAndMoves)
+{
+    Digraph<std::string, int> d;
+
+    for (int i = 0; i < 50; i++)
+    {
+        d.addVertex(i, "v");
+    }
+
+    for (int i = 0; i < 50; i++)
+    {
+        d.addEdge(i, (i + 1) % 50, i);
+        d.addEdge(i, (i + 7) % 50, 100 + i);
+    }
+
+    Digraph<std::string, int> copy{d};
+    d.removeVertex(3);
+    d.updateEdgeInfo(4, 5, -4);
+
+    EXPECT_EQ(3, copy.edgeInfo(3, 4));
+    EXPECT_EQ(4, copy.edgeInfo(4, 5));
+    copy.removeEdge(2, 3);
+    EXPECT_THROW(copy.edgeInfo(2, 3), DigraphException);
+
+    Digraph<std::string, int> moved{std::move(copy)};
+    EXPECT_EQ(103, moved.edgeInfo(3, 10));
+    moved.updateEdgeInfo(3, 10, 7);
+    EXPECT_EQ(7, moved.edgeInfo(3, 10));
+
+    Digraph<std::string, int> assigned;
+    assigned = moved;
+    moved.removeEdge(3, 10);
+    EXPECT_EQ(7, assigned.edgeInfo(3, 10));
+    EXPECT_EQ(99, assigned.edgeCount());
+
+    EXPECT_THROW(d.edgeInfo(2, 3), DigraphException);
+    EXPECT_EQ(-4, d.edgeInfo(4, 5));
+    EXPECT_EQ(96, d.edgeCount());
+}
+
+
 TEST(DigraphTests, isStronglyConnected)
 {
     Digraph<std::string, int> d;
@@ -420,9 +600,177 @@ TEST(DigraphTests, findShortestPathsInDG)
 }
 
 
+TEST(DigraphTests, findShortestPathsToOnlyTheTargets)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addVertex(2, "c");
+    d.addVertex(3, "d");
+    d.addVertex(4, "e");
+    d.addVertex(5, "f");
+
+    d.addEdge(0, 1, 1);
+    d.addEdge(1, 3, 4);
+    d.addEdge(3, 2, 5);
+    d.addEdge(2, 0, 7);
+    d.addEdge(3, 4, 10.0);
+    d.addEdge(2, 4, 9.0);
+    d.addEdge(4, 2, 12.0);
+    d.addEdge(5, 0, 1.0);
+
+    std::map<int, DigraphPath> paths =
+        d.findShortestPathsTo(0, {2, 4, 5, 0, 2}, [](const double& e){ return e;});
+
+    EXPECT_EQ(4, paths.size());
+    EXPECT_EQ(10.0, paths.at(2).length);
+    EXPECT_EQ((std::vector<int>{0, 1, 3, 2}), paths.at(2).vertices);
+    EXPECT_EQ(15.0, paths.at(4).length);
+    EXPECT_EQ((std::vector<int>{0, 1, 3, 4}), paths.at(4).vertices);
+    EXPECT_EQ(0.0, paths.at(0).length);
+    EXPECT_EQ(std::vector<int>{0}, paths.at(0).vertices);
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), paths.at(5).length);
+    EXPECT_TRUE(paths.at(5).vertices.empty());
+
+    EXPECT_TRUE(d.findShortestPathsTo(3, {}, [](const double& e){ return e;}).empty());
+    EXPECT_THROW(d.findShortestPathsTo(6, {0}, [](const double& e){ return e;}), DigraphException);
+    EXPECT_THROW(d.findShortestPathsTo(0, {6}, [](const double& e){ return e;}), DigraphException);
+}
+
+
+TEST(DigraphTests, findShortestPathsFromTheSources)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addVertex(2, "c");
+    d.addVertex(3, "d");
+    d.addVertex(4, "e");
+    d.addVertex(5, "f");
+
+    d.addEdge(0, 1, 1);
+    d.addEdge(1, 3, 4);
+    d.addEdge(3, 2, 5);
+    d.addEdge(2, 0, 7);
+    d.addEdge(3, 4, 10.0);
+    d.addEdge(2, 4, 9.0);
+    d.addEdge(4, 2, 12.0);
+    d.addEdge(0, 5, 1.0);
+
+    std::map<int, DigraphPath> paths =
+        d.findShortestPathsFrom({0, 2, 4, 5}, 4, [](const double& e){ return e;});
+
+    EXPECT_EQ(4, paths.size());
+    EXPECT_EQ(15.0, paths.at(0).length);
+    EXPECT_EQ((std::vector<int>{0, 1, 3, 4}), paths.at(0).vertices);
+    EXPECT_EQ(9.0, paths.at(2).length);
+    EXPECT_EQ((std::vector<int>{2, 4}), paths.at(2).vertices);
+    EXPECT_EQ(0.0, paths.at(4).length);
+    EXPECT_EQ(std::vector<int>{4}, paths.at(4).vertices);
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), paths.at(5).length);
+    EXPECT_TRUE(paths.at(5).vertices.empty());
+
+    for (int source : {0, 1, 2, 3})
+    {
+        std::map<int, DigraphPath> forward =
+            d.findShortestPathsTo(source, {2}, [](const double& e){ return e;});
+        std::map<int, DigraphPath> backward =
+            d.findShortestPathsFrom({source}, 2, [](const double& e){ return e;});
+
+        EXPECT_EQ(forward.at(2).length, backward.at(source).length);
+    }
+
+    EXPECT_THROW(d.findShortestPathsFrom({0}, 6, [](const double& e){ return e;}), DigraphException);
+    EXPECT_THROW(d.findShortestPathsFrom({6}, 0, [](const double& e){ return e;}), DigraphException);
+}
+
+
+TEST(DigraphTests, findNearestCandidates)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addVertex(2, "c");
+    d.addVertex(3, "d");
+    d.addVertex(4, "e");
+    d.addVertex(5, "f");
+
+    d.addEdge(0, 1, 1);
+    d.addEdge(1, 3, 4);
+    d.addEdge(3, 2, 5);
+    d.addEdge(2, 0, 7);
+    d.addEdge(3, 4, 10.0);
+    d.addEdge(2, 4, 9.0);
+    d.addEdge(4, 2, 12.0);
+    d.addEdge(5, 0, 1.0);
+
+    auto weight = [](const double& e){ return e; };
+
+    std::vector<DigraphPath> nearest = d.findNearest(0, {4, 2, 5, 3}, 2, weight);
+    ASSERT_EQ(2, nearest.size());
+    EXPECT_EQ(5.0, nearest[0].length);
+    EXPECT_EQ((std::vector<int>{0, 1, 3}), nearest[0].vertices);
+    EXPECT_EQ(10.0, nearest[1].length);
+    EXPECT_EQ((std::vector<int>{0, 1, 3, 2}), nearest[1].vertices);
+
+    // Unreachable candidates are left out, even when k asks for more.
+    nearest = d.findNearest(0, {4, 5}, 5, weight);
+    ASSERT_EQ(1, nearest.size());
+    EXPECT_EQ(4, nearest[0].vertices.back());
+
+    std::vector<DigraphPath> nearestTo = d.findNearestTo({5, 1, 4, 2}, 0, 3, weight);
+    ASSERT_EQ(3, nearestTo.size());
+    EXPECT_EQ((std::vector<int>{5, 0}), nearestTo[0].vertices);
+    EXPECT_EQ(1.0, nearestTo[0].length);
+    EXPECT_EQ((std::vector<int>{2, 0}), nearestTo[1].vertices);
+    EXPECT_EQ(7.0, nearestTo[1].length);
+    EXPECT_EQ((std::vector<int>{1, 3, 2, 0}), nearestTo[2].vertices);
+    EXPECT_EQ(16.0, nearestTo[2].length);
+
+    EXPECT_TRUE(d.findNearest(0, {1}, 0, weight).empty());
+    EXPECT_TRUE(d.findNearestTo({}, 0, 3, weight).empty());
+    EXPECT_THROW(d.findNearest(6, {0}, 1, weight), DigraphException);
+    EXPECT_THROW(d.findNearestTo({6}, 0, 1, weight), DigraphException);
+}
+
+
 TEST(DigraphTests, singleVertex)
 {
     Digraph<std::string, int> d;
     d.addVertex(0, "a");
     EXPECT_TRUE(d.isStronglyConnected());
 }
+
+
+TEST(DigraphTests, updateEdgeInfo)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addEdge(0, 1, 8.0);
+
+    d.updateEdgeInfo(0, 1, 3.0);
+    EXPECT_EQ(3.0, d.edgeInfo(0, 1));
+    EXPECT_EQ(1, d.edgeCount());
+
+    EXPECT_THROW(d.updateEdgeInfo(1, 0, 1.0), DigraphException);
+    EXPECT_THROW(d.updateEdgeInfo(0, 2, 1.0), DigraphException);
+}
+
+
+TEST(DigraphTests, hasVertexFollowsAddsAndRemoves)
+{
+    Digraph<std::string, int> d;
+
+    EXPECT_FALSE(d.hasVertex(0));
+
+    d.addVertex(0, "a");
+    d.addVertex(4, "b");
+
+    EXPECT_TRUE(d.hasVertex(0));
+    EXPECT_TRUE(d.hasVertex(4));
+    EXPECT_FALSE(d.hasVertex(2));
+
+    d.removeVertex(4);
+    EXPECT_FALSE(d.hasVertex(4));
+}
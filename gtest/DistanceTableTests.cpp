@@ -0,0 +1,63 @@
+#include <limits>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "CustomizableContractionHierarchy.hpp"
+#include "Digraph.hpp"
+#include "DistanceTable.hpp"
+#include "RandomGraphs.hpp"
+
+
+TEST(DistanceTableTests, newTablesAreInfinite)
+{
+    DistanceTable table{2, 3};
+
+    EXPECT_EQ(2, table.rowCount());
+    EXPECT_EQ(3, table.columnCount());
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), table.distance(1, 2));
+
+    table.distance(1, 2) = 4.5;
+    EXPECT_EQ(4.5, table.row(1)[2]);
+}
+
+
+TEST(DistanceTableTests, distancesMatchDijkstra)
+{
+    Digraph<std::string, double> d = makeRandomGrid(12, 37, 0.3);
+    CompactDigraph g{d};
+    CustomizableContractionHierarchy cch{g};
+    CustomizedMetric metric{cch, g.arcWeights<std::string, double>(d, identity)};
+
+    std::vector<int> sources{0, 250, 1430, 700, 250};
+    std::vector<int> targets{1430, 10, 990, 0, 600, 1200, 80};
+
+    for (int threads : {1, 3})
+    {
+        DistanceTable table = distanceTable(metric, sources, targets, threads);
+        ASSERT_EQ(5, table.rowCount());
+        ASSERT_EQ(7, table.columnCount());
+
+        for (std::size_t row = 0; row < sources.size(); ++row)
+        {
+            for (std::size_t column = 0; column < targets.size(); ++column)
+            {
+                EXPECT_TRUE(sameDistance(
+                    dijkstraDistance(d, sources[row], targets[column]),
+                    table.distance(row, column)));
+            }
+        }
+    }
+}
+
+
+TEST(DistanceTableTests, unknownVerticesThrow)
+{
+    CompactDigraph g{makeRandomGrid(3, 1)};
+    CustomizableContractionHierarchy cch{g};
+    CustomizedMetric metric{cch, std::vector<double>(g.arcCount(), 1.0)};
+
+    EXPECT_THROW(distanceTable(metric, {0}, {5}), DigraphException);
+    EXPECT_THROW(distanceTable(metric, {5}, {0}), DigraphException);
+    EXPECT_EQ(0, distanceTable(metric, {}, {0, 10}).rowCount());
+}
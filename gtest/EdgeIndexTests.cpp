@@ -0,0 +1,89 @@
+#include <map>
+#include <random>
+#include <utility>
+#include <gtest/gtest.h>
+#include "EdgeIndex.hpp"
+
+
+TEST(EdgeIndexTests, findsWhatWasInserted)
+{
+    EdgeIndex<int> index;
+    EXPECT_EQ(nullptr, index.find(1, 2));
+
+    EXPECT_TRUE(index.insert(1, 2, 12));
+    EXPECT_TRUE(index.insert(2, 1, 21));
+    EXPECT_TRUE(index.insert(-1, -1, 99));
+    EXPECT_FALSE(index.insert(1, 2, 0));
+
+    EXPECT_EQ(3u, index.size());
+    ASSERT_NE(nullptr, index.find(1, 2));
+    EXPECT_EQ(12, *index.find(1, 2));
+    EXPECT_EQ(21, *index.find(2, 1));
+    EXPECT_EQ(99, *index.find(-1, -1));
+    EXPECT_EQ(nullptr, index.find(1, 1));
+
+    *index.find(2, 1) = 7;
+    EXPECT_EQ(7, *index.find(2, 1));
+}
+
+
+TEST(EdgeIndexTests, erasedEdgesAreGone)
+{
+    EdgeIndex<int> index;
+    index.insert(1, 2, 12);
+
+    EXPECT_FALSE(index.erase(2, 1));
+    EXPECT_TRUE(index.erase(1, 2));
+    EXPECT_FALSE(index.erase(1, 2));
+    EXPECT_EQ(nullptr, index.find(1, 2));
+    EXPECT_EQ(0u, index.size());
+}
+
+
+TEST(EdgeIndexTests, agreesWithAMapThroughRandomChanges)
+{
+    EdgeIndex<int> index;
+    std::map<std::pair<int, int>, int> expected;
+    std::mt19937 random{42};
+    std::uniform_int_distribution<int> vertex{-50, 50};
+
+    for (int i = 0; i < 20000; ++i)
+    {
+        int from = vertex(random);
+        int to = vertex(random);
+
+        if (random() % 3 == 0)
+        {
+            EXPECT_EQ(expected.erase({from, to}) == 1, index.erase(from, to));
+        }
+        else
+        {
+            EXPECT_EQ(expected.emplace(std::make_pair(from, to), i).second, index.insert(from, to, i));
+        }
+    }
+
+    EXPECT_EQ(expected.size(), index.size());
+
+    for (int from = -50; from <= 50; ++from)
+    {
+        for (int to = -50; to <= 50; ++to)
+        {
+            auto found = expected.find({from, to});
+            const int* value = index.find(from, to);
+
+            if (found == expected.end())
+            {
+                EXPECT_EQ(nullptr, value);
+            }
+            else
+            {
+                ASSERT_NE(nullptr, value);
+                EXPECT_EQ(found->second, *value);
+            }
+        }
+    }
+
+    index.clear();
+    EXPECT_EQ(0u, index.size());
+    EXPECT_EQ(nullptr, index.find(0, 0));
+}
@@ -0,0 +1,79 @@
+#include <map>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "GraphPartitioner.hpp"
+#include "RandomGraphs.hpp"
+
+
+TEST(GraphPartitionerTests, cellSizesMustIncrease)
+{
+    CompactDigraph g{makeRandomGrid(4, 1)};
+    EXPECT_THROW(partitionGraph(g, {8, 8}), DigraphException);
+    EXPECT_THROW(partitionGraph(g, {0}), DigraphException);
+}
+
+
+TEST(GraphPartitionerTests, cellsRespectSizeLimitsAndNest)
+{
+    CompactDigraph g{makeRandomGrid(30, 5, 0.2)};
+    std::vector<int> sizes{16, 64, 256};
+    GraphPartition partition = partitionGraph(g, sizes, 4);
+
+    ASSERT_EQ(3, partition.levelCount());
+
+    for (int level = 0; level < partition.levelCount(); ++level)
+    {
+        std::vector<int> cellSize(partition.cellCount(level), 0);
+
+        for (int v = 0; v < g.vertexCount(); ++v)
+        {
+            cellSize[partition.cell(level, v)]++;
+        }
+
+        for (int size : cellSize)
+        {
+            EXPECT_GT(size, 0);
+            EXPECT_LE(size, sizes[level]);
+        }
+
+        if (level > 0)
+        {
+            std::map<int, int> parentCell;
+
+            for (int v = 0; v < g.vertexCount(); ++v)
+            {
+                auto [found, inserted] = parentCell.insert(
+                    {partition.cell(level - 1, v), partition.cell(level, v)});
+                EXPECT_EQ(found->second, partition.cell(level, v));
+            }
+        }
+    }
+}
+
+
+TEST(GraphPartitionerTests, cutsAreSmall)
+{
+    CompactDigraph g{makeRandomGrid(40, 9)};
+    GraphPartition partition = partitionGraph(g, {32, 256});
+
+    // A 40x40 grid cut into cells of at most 32 vertices; a random
+    // assignment would cut almost every arc.
+    EXPECT_LT(cutArcCount(g, partition, 0), g.arcCount() / 3);
+    EXPECT_LT(cutArcCount(g, partition, 1), cutArcCount(g, partition, 0));
+    EXPECT_LE(partition.cellCount(0), 1600 / 8);
+}
+
+
+TEST(GraphPartitionerTests, resultDoesNotDependOnThreadCount)
+{
+    CompactDigraph g{makeRandomGrid(20, 13, 0.1)};
+    GraphPartition one = partitionGraph(g, {10, 50}, 1);
+    GraphPartition many = partitionGraph(g, {10, 50}, 5);
+
+    for (int level = 0; level < 2; ++level)
+    {
+        EXPECT_EQ(one.cells(level), many.cells(level));
+    }
+}
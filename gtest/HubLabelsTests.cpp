@@ -0,0 +1,137 @@
+#include <limits>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "CustomizableContractionHierarchy.hpp"
+#include "Digraph.hpp"
+#include "HubLabels.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+namespace
+{
+    HubLabels makeLabels(const Digraph<std::string, double>& d)
+    {
+        CompactDigraph g{d};
+        CustomizableContractionHierarchy cch{g};
+        return HubLabels{g, g.arcWeights<std::string, double>(d, identity), hierarchyHubOrder(cch)};
+    }
+
+
+    void expectMatchesDijkstra(
+        const Digraph<std::string, double>& d, const HubLabels& labels, const std::vector<int>& starts)
+    {
+        for (int from : starts)
+        {
+            ShortestPathTree<std::string, double> tree{d, from, identity};
+
+            for (int to : d.vertices())
+            {
+                DigraphPath path = labels.shortestPath(from, to);
+                EXPECT_TRUE(sameDistance(tree.distance(to), labels.distance(from, to)));
+
+                if (tree.distance(to) == std::numeric_limits<double>::infinity())
+                {
+                    EXPECT_TRUE(path.vertices.empty());
+                }
+                else
+                {
+                    ASSERT_FALSE(path.vertices.empty());
+                    EXPECT_EQ(from, path.vertices.front());
+                    EXPECT_EQ(to, path.vertices.back());
+                    EXPECT_NEAR(tree.distance(to), path.length, 1e-9);
+                    EXPECT_NEAR(tree.distance(to), pathLength(d, path.vertices), 1e-9);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(HubLabelsTests, distancesAndPathsMatchDijkstra)
+{
+    Digraph<std::string, double> d = makeRandomGrid(12, 23, 0.3);
+    HubLabels labels = makeLabels(d);
+
+    EXPECT_EQ(144, labels.vertexCount());
+    expectMatchesDijkstra(d, labels, {0, 470, 1430});
+}
+
+
+TEST(HubLabelsTests, anyOrderGivesCorrectLabels)
+{
+    Digraph<std::string, double> d = makeRandomGrid(6, 4, 0.2);
+    CompactDigraph g{d};
+    std::vector<int> order;
+
+    for (int v = 0; v < g.vertexCount(); ++v)
+    {
+        order.push_back(v);
+    }
+
+    HubLabels labels{g, g.arcWeights<std::string, double>(d, identity), order};
+    expectMatchesDijkstra(d, labels, {0, 170, 350});
+}
+
+
+TEST(HubLabelsTests, badInputThrows)
+{
+    Digraph<std::string, double> d = makeRandomGrid(2, 1);
+    CompactDigraph g{d};
+    std::vector<double> weights = g.arcWeights<std::string, double>(d, identity);
+
+    EXPECT_THROW((HubLabels{g, weights, {0, 1, 2, 2}}), DigraphException);
+    EXPECT_THROW((HubLabels{g, {1.0}, {0, 1, 2, 3}}), DigraphException);
+
+    HubLabels labels{g, weights, {0, 1, 2, 3}};
+    EXPECT_THROW(labels.distance(0, 5), DigraphException);
+}
+
+
+TEST(HubLabelsTests, labelsSurviveWritingAndReading)
+{
+    Digraph<std::string, double> d = makeRandomGrid(8, 9, 0.3);
+    HubLabels labels = makeLabels(d);
+
+    std::stringstream stream;
+    labels.write(stream);
+    HubLabels copy = HubLabels::read(stream);
+
+    EXPECT_EQ(labels.labelEntryCount(), copy.labelEntryCount());
+    expectMatchesDijkstra(d, copy, {0, 330, 630});
+}
+
+
+TEST(HubLabelsTests, readingSomethingElseThrows)
+{
+    std::stringstream garbage{"not hub labels at all"};
+    EXPECT_THROW(HubLabels::read(garbage), DigraphException);
+
+    HubLabels labels = makeLabels(makeRandomGrid(4, 2));
+    std::stringstream stream;
+    labels.write(stream);
+
+    std::string truncated = stream.str().substr(0, stream.str().size() - 5);
+    std::stringstream truncatedStream{truncated};
+    EXPECT_THROW(HubLabels::read(truncatedStream), DigraphException);
+}
+
+
+TEST(HubLabelsTests, readingOutOfRangeEntriesThrows)
+{
+    HubLabels labels = makeLabels(makeRandomGrid(4, 2));
+    std::stringstream stream;
+    labels.write(stream);
+
+    // The stream ends with the last backward label entry's previous
+    // vertex, which is replaced with one that doesn't exist.
+    std::string damaged = stream.str();
+    int badVertex = 1000;
+    damaged.replace(damaged.size() - sizeof(int), sizeof(int), reinterpret_cast<const char*>(&badVertex), sizeof(int));
+
+    std::stringstream damagedStream{damaged};
+    EXPECT_THROW(HubLabels::read(damagedStream), DigraphException);
+}
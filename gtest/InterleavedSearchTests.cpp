@@ -0,0 +1,85 @@
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "InterleavedSearch.hpp"
+#include "RandomGraphs.hpp"
+
+
+TEST(InterleavedSearchTests, findsShortestPathsAtAnyWidth)
+{
+    Digraph<std::string, double> d = makeRandomGrid(15, 45, 0.3);
+    CompactDigraph g{d, VertexOrder::CuthillMcKee};
+    std::vector<double> weights = g.arcInfos(d);
+
+    std::vector<std::pair<int, int>> queries;
+
+    for (int start : {0, 1120, 2240, 730})
+    {
+        for (int end : {0, 40, 1500, 2240, 1810})
+        {
+            queries.push_back({g.index(start), g.index(end)});
+        }
+    }
+
+    for (int width : {1, 3, 8, 64})
+    {
+        std::vector<DigraphPath> paths = interleavedShortestPaths(g, weights, queries, width);
+        ASSERT_EQ(queries.size(), paths.size());
+
+        for (std::size_t i = 0; i < queries.size(); ++i)
+        {
+            int start = g.vertexNumber(queries[i].first);
+            int end = g.vertexNumber(queries[i].second);
+            double expected = dijkstraDistance(d, start, end);
+
+            EXPECT_TRUE(sameDistance(expected, paths[i].length));
+
+            if (paths[i].vertices.empty())
+            {
+                EXPECT_EQ(std::numeric_limits<double>::infinity(), expected);
+            }
+            else
+            {
+                EXPECT_EQ(start, paths[i].vertices.front());
+                EXPECT_EQ(end, paths[i].vertices.back());
+                EXPECT_TRUE(sameDistance(expected, pathLength(d, paths[i].vertices)));
+            }
+        }
+    }
+}
+
+
+TEST(InterleavedSearchTests, unreachableEndsGetEmptyPaths)
+{
+    Digraph<std::string, double> d;
+
+    for (int v = 1; v <= 4; ++v)
+    {
+        d.addVertex(v, "");
+    }
+
+    d.addEdge(1, 2, 1.0);
+    d.addEdge(2, 3, 1.0);
+    d.addEdge(4, 1, 1.0);
+
+    CompactDigraph g{d};
+    std::vector<double> weights = g.arcInfos(d);
+
+    std::vector<DigraphPath> paths = interleavedShortestPaths(
+        g, weights, {{g.index(1), g.index(3)}, {g.index(1), g.index(4)}, {g.index(2), g.index(2)}}, 2);
+
+    EXPECT_EQ(2.0, paths[0].length);
+    EXPECT_EQ((std::vector<int>{1, 2, 3}), paths[0].vertices);
+    EXPECT_EQ(std::numeric_limits<double>::infinity(), paths[1].length);
+    EXPECT_TRUE(paths[1].vertices.empty());
+    EXPECT_EQ(0.0, paths[2].length);
+    EXPECT_EQ(std::vector<int>{2}, paths[2].vertices);
+
+    EXPECT_TRUE(interleavedShortestPaths(g, weights, {}).empty());
+    EXPECT_THROW(interleavedShortestPaths(g, {1.0}, {{0, 1}}), DigraphException);
+    EXPECT_THROW(interleavedShortestPaths(g, weights, {{0, 4}}), DigraphException);
+}
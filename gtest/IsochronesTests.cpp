@@ -0,0 +1,81 @@
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+#include "Isochrones.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+namespace
+{
+    const std::function<double(const double&)> weight = [](const double& e) { return e; };
+}
+
+
+TEST(IsochronesTests, reachableWithinMatchesAFullSearch)
+{
+    Digraph<std::string, double> d = makeRandomGrid(15, 49, 0.3);
+
+    for (int start : {0, 1120, 2240})
+    {
+        ShortestPathTree<std::string, double> tree{d, start, weight};
+
+        for (double budget : {0.0, 7.5, 30.0, 1e9})
+        {
+            std::map<int, double> reachable = reachableWithin(d, start, budget, weight);
+
+            for (int v : d.vertices())
+            {
+                auto found = reachable.find(v);
+
+                if (tree.distance(v) <= budget)
+                {
+                    ASSERT_NE(reachable.end(), found);
+                    EXPECT_TRUE(sameDistance(tree.distance(v), found->second));
+                }
+                else
+                {
+                    EXPECT_EQ(reachable.end(), found);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(IsochronesTests, batchesMatchSingleSearches)
+{
+    Digraph<std::string, double> d = makeRandomGrid(12, 50, 0.3);
+    std::vector<int> starts{0, 50, 700, 1430, 50};
+
+    for (int threads : {1, 3})
+    {
+        std::vector<std::map<int, double>> reachable =
+            reachableWithin(d, starts, 20.0, weight, threads);
+
+        ASSERT_EQ(starts.size(), reachable.size());
+
+        for (std::size_t i = 0; i < starts.size(); ++i)
+        {
+            EXPECT_EQ(reachableWithin(d, starts[i], 20.0, weight), reachable[i]);
+        }
+    }
+}
+
+
+TEST(IsochronesTests, badBudgetsAndStarts)
+{
+    Digraph<std::string, double> d = makeRandomGrid(3, 1);
+
+    EXPECT_TRUE(reachableWithin(d, 0, -1.0, weight).empty());
+    EXPECT_EQ((std::map<int, double>{{0, 0.0}}), reachableWithin(d, 0, 0.0, weight));
+
+    EXPECT_THROW(reachableWithin(d, 5, 1.0, weight), DigraphException);
+    EXPECT_THROW(reachableWithin(
+        d, 0, std::numeric_limits<double>::quiet_NaN(), weight), DigraphException);
+    EXPECT_THROW(reachableWithin(d, {0, 5}, 1.0, weight, 2), DigraphException);
+}
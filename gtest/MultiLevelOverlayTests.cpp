@@ -0,0 +1,145 @@
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "Digraph.hpp"
+#include "GraphPartitioner.hpp"
+#include "MultiLevelOverlay.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+namespace
+{
+    void expectMatchesDijkstra(
+        const Digraph<std::string, double>& d, OverlayQuery& query, const std::vector<int>& starts)
+    {
+        for (int from : starts)
+        {
+            ShortestPathTree<std::string, double> tree{d, from, identity};
+
+            for (int to : d.vertices())
+            {
+                DigraphPath path = query.shortestPath(from, to);
+                EXPECT_TRUE(sameDistance(tree.distance(to), query.distance(from, to)));
+
+                if (tree.distance(to) == std::numeric_limits<double>::infinity())
+                {
+                    EXPECT_TRUE(path.vertices.empty());
+                }
+                else
+                {
+                    ASSERT_FALSE(path.vertices.empty());
+                    EXPECT_EQ(from, path.vertices.front());
+                    EXPECT_EQ(to, path.vertices.back());
+                    EXPECT_NEAR(tree.distance(to), path.length, 1e-9);
+                    EXPECT_NEAR(tree.distance(to), pathLength(d, path.vertices), 1e-9);
+                }
+            }
+        }
+    }
+}
+
+
+TEST(MultiLevelOverlayTests, boundaryVerticesHaveCutArcs)
+{
+    CompactDigraph g{makeRandomGrid(12, 5)};
+    OverlayGraph overlay{g, partitionGraph(g, {8, 40})};
+
+    ASSERT_EQ(2, overlay.levelCount());
+
+    for (int l = 0; l < overlay.levelCount(); ++l)
+    {
+        const OverlayLevel& level = overlay.level(l);
+        std::vector<bool> cut(g.vertexCount(), false);
+
+        for (int arc = 0; arc < g.arcCount(); ++arc)
+        {
+            if (overlay.partition().cell(l, g.arcTail(arc)) != overlay.partition().cell(l, g.arcHead(arc)))
+            {
+                cut[g.arcTail(arc)] = true;
+                cut[g.arcHead(arc)] = true;
+            }
+        }
+
+        for (int v = 0; v < g.vertexCount(); ++v)
+        {
+            EXPECT_EQ(cut[v], level.boundaryIndex[v] != -1);
+        }
+    }
+}
+
+
+TEST(MultiLevelOverlayTests, distancesMatchDijkstra)
+{
+    Digraph<std::string, double> d = makeRandomGrid(14, 7, 0.3);
+    CompactDigraph g{d};
+    OverlayGraph overlay{g, partitionGraph(g, {6, 24, 80})};
+    OverlayMetric metric{overlay, g.arcWeights<std::string, double>(d, identity)};
+    OverlayQuery query{metric};
+
+    expectMatchesDijkstra(d, query, {0, 330, 1010, 1950});
+}
+
+
+TEST(MultiLevelOverlayTests, withoutLevelsItsPlainDijkstra)
+{
+    Digraph<std::string, double> d = makeRandomGrid(5, 2, 0.2);
+    CompactDigraph g{d};
+    OverlayGraph overlay{g, partitionGraph(g, {})};
+    OverlayMetric metric{overlay, g.arcWeights<std::string, double>(d, identity)};
+    OverlayQuery query{metric};
+
+    EXPECT_EQ(0, overlay.cliqueEntryCount());
+    expectMatchesDijkstra(d, query, {0, 120});
+    EXPECT_THROW(query.distance(0, 7), DigraphException);
+}
+
+
+TEST(MultiLevelOverlayTests, updatingWeightsMatchesCustomizingFromScratch)
+{
+    Digraph<std::string, double> d = makeRandomGrid(12, 19);
+    CompactDigraph g{d};
+    OverlayGraph overlay{g, partitionGraph(g, {8, 32})};
+    OverlayMetric metric{overlay, g.arcWeights<std::string, double>(d, identity), 2};
+
+    std::vector<std::pair<int, double>> changes;
+
+    for (int arc = 0; arc < g.arcCount(); arc += 37)
+    {
+        int from = g.vertexNumber(g.arcTail(arc));
+        int to = g.vertexNumber(g.arcHead(arc));
+        d.updateEdgeInfo(from, to, d.edgeInfo(from, to) * 3 + 1);
+        changes.push_back({arc, d.edgeInfo(from, to)});
+    }
+
+    int customized = metric.updateArcWeights(changes);
+    EXPECT_GT(customized, 0);
+    EXPECT_LT(customized, overlay.partition().cellCount(0) + overlay.partition().cellCount(1));
+
+    OverlayMetric fresh{overlay, g.arcWeights<std::string, double>(d, identity), 1};
+
+    for (int l = 0; l < overlay.levelCount(); ++l)
+    {
+        const OverlayLevel& level = overlay.level(l);
+
+        for (int c = 0; c < overlay.partition().cellCount(l); ++c)
+        {
+            int size = level.firstBoundary[c + 1] - level.firstBoundary[c];
+
+            for (int i = 0; i < size; ++i)
+            {
+                for (int j = 0; j < size; ++j)
+                {
+                    EXPECT_EQ(fresh.cliqueWeight(l, c, i, j), metric.cliqueWeight(l, c, i, j));
+                }
+            }
+        }
+    }
+
+    OverlayQuery query{metric};
+    expectMatchesDijkstra(d, query, {0, 650});
+    EXPECT_THROW(metric.updateArcWeights({{g.arcCount(), 1.0}}), DigraphException);
+}
@@ -0,0 +1,100 @@
+#include <limits>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "CompactDigraph.hpp"
+#include "CustomizableContractionHierarchy.hpp"
+#include "Digraph.hpp"
+#include "Phast.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+TEST(PhastTests, distancesMatchDijkstraForManyStartsAtOnce)
+{
+    Digraph<std::string, double> d = makeRandomGrid(15, 29, 0.3);
+    CompactDigraph g{d};
+    CustomizableContractionHierarchy cch{g};
+    CustomizedMetric metric{cch, g.arcWeights<std::string, double>(d, identity)};
+    PhastQuery query{metric};
+
+    // more starts than lanes, so some sweeps are only partly full
+    std::vector<int> starts;
+
+    for (int i = 0; i < PhastQuery::lanes + 3; ++i)
+    {
+        starts.push_back(10 * (i * 17 % 225));
+    }
+
+    for (int threads : {1, 3})
+    {
+        std::vector<std::vector<double>> distances = query.distances(starts, threads);
+        ASSERT_EQ(starts.size(), distances.size());
+
+        for (std::size_t i = 0; i < starts.size(); ++i)
+        {
+            ShortestPathTree<std::string, double> tree{d, starts[i], identity};
+
+            for (int v = 0; v < g.vertexCount(); ++v)
+            {
+                EXPECT_TRUE(sameDistance(tree.distance(g.vertexNumber(v)), distances[i][v]));
+            }
+        }
+    }
+}
+
+
+TEST(PhastTests, predecessorsFormShortestPathTrees)
+{
+    Digraph<std::string, double> d = makeRandomGrid(10, 31, 0.3);
+    CompactDigraph g{d};
+    CustomizableContractionHierarchy cch{g};
+    CustomizedMetric metric{cch, g.arcWeights<std::string, double>(d, identity)};
+    PhastQuery query{metric};
+
+    // more starts than lanes, so predecessors are found for a partly full
+    // batch too
+    std::vector<int> starts;
+
+    for (int i = 0; i < PhastQuery::lanes + 3; ++i)
+    {
+        starts.push_back(10 * (i * 13 % 100));
+    }
+
+    std::vector<SingleSourcePaths> trees = query.shortestPaths(starts, 3);
+    std::vector<std::vector<double>> distances = query.distances(starts);
+    ASSERT_EQ(starts.size(), trees.size());
+
+    for (std::size_t i = 0; i < trees.size(); ++i)
+    {
+        const SingleSourcePaths& tree = trees[i];
+        EXPECT_EQ(distances[i], tree.distances);
+
+        for (int v = 0; v < g.vertexCount(); ++v)
+        {
+            int p = tree.predecessors[v];
+
+            if (tree.distances[v] == 0.0 || tree.distances[v] == std::numeric_limits<double>::infinity())
+            {
+                EXPECT_EQ(-1, p);
+            }
+            else
+            {
+                ASSERT_NE(-1, p);
+                EXPECT_NEAR(tree.distances[v], tree.distances[p] + metric.arcWeight(g.findArc(p, v)), 1e-9);
+            }
+        }
+    }
+}
+
+
+TEST(PhastTests, unknownStartThrows)
+{
+    CompactDigraph g{makeRandomGrid(3, 1)};
+    CustomizableContractionHierarchy cch{g};
+    CustomizedMetric metric{cch, std::vector<double>(g.arcCount(), 1.0)};
+    PhastQuery query{metric};
+
+    EXPECT_THROW(query.distances({0, 5}), DigraphException);
+    EXPECT_TRUE(query.distances({}).empty());
+}
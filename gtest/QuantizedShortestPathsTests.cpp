@@ -0,0 +1,97 @@
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <map>
+#include <string>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+#include "QuantizedShortestPaths.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+namespace
+{
+    double truncated(const double& e)
+    {
+        return static_cast<std::uint64_t>(e);
+    }
+}
+
+
+TEST(QuantizedShortestPathsTests, matchesFindShortestPathsOnIntegerWeights)
+{
+    Digraph<std::string, double> d = makeRandomGrid(15, 36, 0.3);
+
+    // Whole-number weights with plenty of ties.
+    std::function<std::uint64_t(const double&)> weight =
+        [](const double& e) { return static_cast<std::uint64_t>(e); };
+
+    for (int start : {0, 1120, 2240})
+    {
+        std::map<int, int> expected = d.findShortestPaths(start, truncated);
+        std::map<int, int> actual = findShortestPathsQuantized(d, start, weight);
+        ShortestPathTree<std::string, double> tree{d, start, truncated};
+
+        ASSERT_EQ(expected.size(), actual.size());
+
+        for (auto& [vertex, predecessor] : actual)
+        {
+            // Ties can make the predecessors differ, but never the distances.
+            EXPECT_EQ(expected.at(vertex) == vertex, predecessor == vertex);
+
+            if (predecessor != vertex)
+            {
+                EXPECT_EQ(tree.distance(vertex),
+                    tree.distance(predecessor) + truncated(d.edgeInfo(predecessor, vertex)));
+            }
+        }
+    }
+}
+
+
+TEST(QuantizedShortestPathsTests, fineQuantizationFindsTheSamePaths)
+{
+    Digraph<std::string, double> d = makeRandomGrid(15, 37, 0.3);
+    auto weight = quantizedWeight<double>(identity, 1e6);
+
+    for (int start : {0, 1120, 2240})
+    {
+        EXPECT_EQ(d.findShortestPaths(start, identity), findShortestPathsQuantized(d, start, weight));
+    }
+}
+
+
+TEST(QuantizedShortestPathsTests, badInputThrows)
+{
+    Digraph<std::string, double> d = makeRandomGrid(2, 1);
+    CompactDigraph g{d};
+
+    EXPECT_THROW(quantizedShortestPaths(g, {1}, 0), DigraphException);
+    EXPECT_THROW(quantizedShortestPaths(g, std::vector<std::uint64_t>(g.arcCount(), 1), 4), DigraphException);
+    EXPECT_THROW(findShortestPathsQuantized(d, 5, quantizedWeight<double>(identity, 1.0)), DigraphException);
+
+    auto weight = quantizedWeight<double>(identity, 1.0);
+    EXPECT_EQ(3, weight(2.6));
+    EXPECT_THROW(weight(-1.0), DigraphException);
+    EXPECT_THROW(weight(std::numeric_limits<double>::infinity()), DigraphException);
+    EXPECT_THROW(weight(std::numeric_limits<double>::quiet_NaN()), DigraphException);
+}
+
+
+TEST(QuantizedShortestPathsTests, unreachableVerticesHaveNoPredecessor)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(1, "a");
+    d.addVertex(2, "b");
+    d.addVertex(3, "c");
+    d.addEdge(1, 2, 4.0);
+
+    CompactDigraph g{d};
+    QuantizedPaths paths = quantizedShortestPaths(g, {4}, g.index(1));
+
+    EXPECT_EQ(4, paths.distances[g.index(2)]);
+    EXPECT_EQ(QuantizedPaths::unreachable, paths.distances[g.index(3)]);
+    EXPECT_EQ(-1, paths.predecessors[g.index(3)]);
+    EXPECT_EQ(-1, paths.predecessors[g.index(1)]);
+}
@@ -0,0 +1,85 @@
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+#include <gtest/gtest.h>
+#include "RadixHeap.hpp"
+
+
+TEST(RadixHeapTests, startsEmpty)
+{
+    RadixHeap<int> heap;
+    EXPECT_TRUE(heap.empty());
+    EXPECT_EQ(0, heap.size());
+}
+
+
+TEST(RadixHeapTests, popsInOrderOfKeys)
+{
+    RadixHeap<int> heap;
+    std::vector<std::uint64_t> keys{40, 7, 7, 1000000000000ULL, 0, 63, 64, 65};
+
+    for (std::size_t i = 0; i < keys.size(); ++i)
+    {
+        heap.push(keys[i], i);
+    }
+
+    EXPECT_EQ(keys.size(), heap.size());
+    std::sort(keys.begin(), keys.end());
+
+    for (std::uint64_t key : keys)
+    {
+        EXPECT_EQ(key, heap.pop().first);
+    }
+
+    EXPECT_TRUE(heap.empty());
+}
+
+
+TEST(RadixHeapTests, behavesLikeAMonotonePriorityQueue)
+{
+    // Like Dijkstra's algorithm, push keys no smaller than the last one
+    // popped, and compare against a sorted list of what's waiting.
+    std::mt19937_64 random{46};
+    RadixHeap<std::uint64_t> heap;
+    std::vector<std::uint64_t> waiting;
+    std::uint64_t last = 0;
+
+    for (int step = 0; step < 20000; ++step)
+    {
+        if (waiting.empty() || random() % 3 != 0)
+        {
+            std::uint64_t key = last + random() % (1ULL << (random() % 40));
+            heap.push(key, key);
+            waiting.push_back(key);
+        }
+        else
+        {
+            auto [key, value] = heap.pop();
+            auto smallest = std::min_element(waiting.begin(), waiting.end());
+
+            ASSERT_EQ(*smallest, key);
+            EXPECT_EQ(key, value);
+
+            waiting.erase(smallest);
+            last = key;
+        }
+
+        ASSERT_EQ(waiting.size(), heap.size());
+    }
+}
+
+
+TEST(RadixHeapTests, keysBelowTheLastPoppedThrow)
+{
+    RadixHeap<int> heap;
+    heap.push(10, 1);
+    heap.push(20, 2);
+    heap.pop();
+
+    EXPECT_THROW(heap.push(9, 3), DigraphException);
+
+    heap.clear();
+    EXPECT_TRUE(heap.empty());
+    EXPECT_NO_THROW(heap.push(9, 3));
+}
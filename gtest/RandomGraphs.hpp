@@ -0,0 +1,165 @@
+// RandomGraphs.hpp
+//
+// Helpers shared by the tests that compare the acceleration structures in
+// core/ against plain Dijkstra on graphs too big to check by hand.
+
+#ifndef RANDOMGRAPHS_HPP
+#define RANDOMGRAPHS_HPP
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+#include "RoadMap.hpp"
+#include "ShortestPathTree.hpp"
+#include "TripMetricWeight.hpp"
+
+
+
+// identity() is the edge weight function for graphs whose edge
+// information is the weight itself.
+inline double identity(const double& e)
+{
+    return e;
+}
+
+
+// makeRandomGrid() returns a size-by-size grid of vertices numbered
+// 10 * (row * size + column) (so vertex numbers aren't just indices),
+// with a randomly weighted edge in each direction between neighbors.
+// With the given probability, one direction of a pair is left out,
+// which makes some streets one-way.
+inline Digraph<std::string, double> makeRandomGrid(
+    int size, unsigned int seed, double oneWayProbability = 0.0)
+{
+    Digraph<std::string, double> d;
+
+    for (int i = 0; i < size * size; ++i)
+    {
+        d.addVertex(10 * i, std::to_string(i));
+    }
+
+    std::mt19937 random{seed};
+    std::uniform_real_distribution<double> weight{1.0, 10.0};
+    std::uniform_real_distribution<double> chance{0.0, 1.0};
+
+    auto connect = [&](int a, int b)
+        {
+            bool oneWay = chance(random) < oneWayProbability;
+            bool forward = !oneWay || chance(random) < 0.5;
+
+            if (forward || !oneWay)
+            {
+                d.addEdge(10 * a, 10 * b, weight(random));
+            }
+            if (!forward || !oneWay)
+            {
+                d.addEdge(10 * b, 10 * a, weight(random));
+            }
+        };
+
+    for (int r = 0; r < size; ++r)
+    {
+        for (int c = 0; c < size; ++c)
+        {
+            int v = r * size + c;
+
+            if (c + 1 < size)
+            {
+                connect(v, v + 1);
+            }
+            if (r + 1 < size)
+            {
+                connect(v, v + size);
+            }
+        }
+    }
+
+    return d;
+}
+
+
+// makeRandomRoadMap() returns the grid makeRandomGrid() would as a
+// RoadMap, with each edge's weight in tenths of a mile and a random speed
+// between 20 and 70 miles per hour.
+inline RoadMap makeRandomRoadMap(
+    int size, unsigned int seed, double oneWayProbability = 0.0)
+{
+    Digraph<std::string, double> grid = makeRandomGrid(size, seed, oneWayProbability);
+    std::mt19937 random{seed};
+    std::uniform_real_distribution<double> speed{20.0, 70.0};
+    RoadMap roadMap;
+
+    for (int v : grid.vertices())
+    {
+        roadMap.addVertex(v, grid.vertexInfo(v));
+    }
+
+    for (auto [from, to] : grid.edges())
+    {
+        roadMap.addEdge(from, to, RoadSegment{grid.edgeInfo(from, to) / 10.0, speed(random)});
+    }
+
+    return roadMap;
+}
+
+
+// dijkstraDistance() returns the shortest distance between two vertices
+// of a graph whose edge information is its weight.
+inline double dijkstraDistance(const Digraph<std::string, double>& d, int from, int to)
+{
+    ShortestPathTree<std::string, double> tree{
+        d, from, identity};
+    return tree.distance(to);
+}
+
+
+// pathLength() returns the total weight of the edges along the given
+// sequence of vertices, which must all be edges of the graph.
+inline double pathLength(const Digraph<std::string, double>& d, const std::vector<int>& vertices)
+{
+    double length = 0.0;
+
+    for (std::size_t i = 1; i < vertices.size(); ++i)
+    {
+        length += d.edgeInfo(vertices[i - 1], vertices[i]);
+    }
+
+    return length;
+}
+
+
+// routeLength() returns the length under the given TripMetric of a route
+// through a RoadMap, whose consecutive vertices must all be road segments.
+inline double routeLength(const RoadMap& roadMap, const std::vector<int>& route, TripMetric metric)
+{
+    auto weight = tripMetricWeight(metric);
+    double length = 0.0;
+
+    for (std::size_t i = 1; i < route.size(); ++i)
+    {
+        length += weight(roadMap.edgeInfo(route[i - 1], route[i]));
+    }
+
+    return length;
+}
+
+
+// sameDistance() checks that two distances are equal up to rounding,
+// treating two infinite (unreachable) distances as equal.
+inline ::testing::AssertionResult sameDistance(double expected, double actual)
+{
+    if (expected == actual || std::abs(expected - actual) <= 1e-9)
+    {
+        return ::testing::AssertionSuccess();
+    }
+
+    return ::testing::AssertionFailure()
+        << "expected " << expected << " but got " << actual;
+}
+
+
+
+#endif
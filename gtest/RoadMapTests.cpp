@@ -0,0 +1,44 @@
+#include <string>
+#include <utility>
+#include <gtest/gtest.h>
+#include "RoadMap.hpp"
+
+
+TEST(RoadMapTests, namesAreKeptInThePool)
+{
+    RoadMap roadMap;
+    std::string name = "Anteater Drive";
+
+    roadMap.addVertex(0, name);
+    roadMap.addVertex(1, "Anteater Drive");
+    name.clear();
+
+    EXPECT_EQ("Anteater Drive", roadMap.vertexInfo(0));
+    EXPECT_EQ(roadMap.vertexInfo(0).data(), roadMap.vertexInfoRef(1).data());
+    EXPECT_TRUE(roadMap.names()->contains(roadMap.vertexInfo(0)));
+    EXPECT_EQ(1u, roadMap.names()->size());
+
+    EXPECT_THROW(roadMap.addVertex(1, "Jamboree"), DigraphException);
+}
+
+
+TEST(RoadMapTests, copiesShareTheirNames)
+{
+    RoadMap original;
+    original.addVertex(0, "Campus & Bison");
+
+    RoadMap copy{original};
+    copy.addVertex(1, "Jamboree");
+
+    EXPECT_EQ(original.names(), copy.names());
+    EXPECT_EQ(original.vertexInfo(0).data(), copy.vertexInfo(0).data());
+    EXPECT_EQ(1, original.vertexCount());
+
+    RoadMap moved{std::move(copy)};
+    EXPECT_EQ("Jamboree", moved.vertexInfo(1));
+
+    RoadMap other;
+    other = moved;
+    EXPECT_EQ(moved.names(), other.names());
+    EXPECT_EQ("Jamboree", other.vertexInfo(1));
+}
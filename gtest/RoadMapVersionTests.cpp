@@ -0,0 +1,72 @@
+#include <memory>
+#include <string_view>
+#include <thread>
+#include <gtest/gtest.h>
+#include "RandomGraphs.hpp"
+#include "RoadMapVersion.hpp"
+
+
+namespace
+{
+    // expectLabelsMatch() checks that a version's distance labels agree
+    // with Dijkstra's algorithm on the RoadMap it was built from.
+    void expectLabelsMatch(const RoadMapVersion& version, const RoadMap& roadMap)
+    {
+        ASSERT_TRUE(version.hubLabels.has_value());
+        const HubLabels& labels = version.hubLabels->labels(TripMetric::Distance);
+
+        for (int end : {0, 70, 240})
+        {
+            ShortestPathTree<std::string_view, RoadSegment> tree{
+                roadMap, end, tripMetricWeight(TripMetric::Distance)};
+
+            for (int start : roadMap.vertices())
+            {
+                EXPECT_TRUE(sameDistance(tree.distance(start), labels.distance(end, start)));
+            }
+        }
+    }
+}
+
+
+TEST(RoadMapVersionTests, readersKeepTheirLabelsAcrossPublish)
+{
+    RoadMap first = makeRandomRoadMap(5, 1);
+    RoadMap second = makeRandomRoadMap(5, 2);
+
+    RoadMapHolder holder{makeRoadMapVersion(first, true)};
+    std::shared_ptr<const RoadMapVersion> reader = holder.current();
+
+    // The reader keeps querying its version on another thread while the
+    // new one is built and published.
+    std::thread queries{
+        [&]
+        {
+            for (int i = 0; i < 20; ++i)
+            {
+                expectLabelsMatch(*reader, first);
+            }
+        }};
+
+    holder.publish(makeRoadMapVersion(second, true));
+    queries.join();
+
+    EXPECT_NE(
+        reader->hubLabels->labels(TripMetric::Distance).distance(0, 240),
+        holder.current()->hubLabels->labels(TripMetric::Distance).distance(0, 240));
+
+    expectLabelsMatch(*reader, first);
+    expectLabelsMatch(*holder.current(), second);
+    EXPECT_TRUE(holder.current()->stronglyConnected);
+    EXPECT_EQ(2, holder.version());
+}
+
+
+TEST(RoadMapVersionTests, hubLabelsAreOnlyBuiltWhenAskedFor)
+{
+    std::shared_ptr<const RoadMapVersion> version = makeRoadMapVersion(makeRandomRoadMap(4, 3));
+
+    EXPECT_FALSE(version->hubLabels.has_value());
+    EXPECT_EQ(16, version->roadMap.vertexCount());
+    EXPECT_TRUE(version->stronglyConnected);
+}
@@ -0,0 +1,182 @@
+#include <functional>
+#include <map>
+#include <random>
+#include <string>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+#include "RandomGraphs.hpp"
+#include "ShortestPathTree.hpp"
+
+
+namespace
+{
+    Digraph<std::string, double> makeGrid(int size)
+    {
+        Digraph<std::string, double> d;
+
+        for (int i = 0; i < size * size; ++i)
+        {
+            d.addVertex(i, std::to_string(i));
+        }
+
+        std::mt19937 random{46};
+        std::uniform_real_distribution<double> weight{1.0, 10.0};
+
+        for (int r = 0; r < size; ++r)
+        {
+            for (int c = 0; c < size; ++c)
+            {
+                int v = r * size + c;
+                if (c + 1 < size)
+                {
+                    d.addEdge(v, v + 1, weight(random));
+                    d.addEdge(v + 1, v, weight(random));
+                }
+                if (r + 1 < size)
+                {
+                    d.addEdge(v, v + size, weight(random));
+                    d.addEdge(v + size, v, weight(random));
+                }
+            }
+        }
+
+        return d;
+    }
+
+
+    void expectSameDistances(
+        const Digraph<std::string, double>& d,
+        const ShortestPathTree<std::string, double>& repaired)
+    {
+        ShortestPathTree<std::string, double> fresh{d, repaired.startVertex(), identity};
+
+        for (int v : d.vertices())
+        {
+            EXPECT_NEAR(fresh.distance(v), repaired.distance(v), 1e-9);
+
+            int pred = repaired.predecessor(v);
+            if (pred != v)
+            {
+                EXPECT_NEAR(
+                    repaired.distance(pred) + d.edgeInfo(pred, v),
+                    repaired.distance(v), 1e-9);
+            }
+        }
+    }
+}
+
+
+TEST(ShortestPathTreeTests, matchesFindShortestPaths)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addVertex(2, "c");
+    d.addVertex(3, "d");
+    d.addVertex(4, "e");
+
+    d.addEdge(0, 1, 1);
+    d.addEdge(1, 3, 4);
+    d.addEdge(3, 2, 5);
+    d.addEdge(2, 0, 7);
+    d.addEdge(3, 4, 10.0);
+    d.addEdge(2, 4, 9.0);
+    d.addEdge(4, 2, 12.0);
+
+    ShortestPathTree<std::string, double> t{d, 0, identity};
+
+    EXPECT_EQ(d.findShortestPaths(0, identity), t.predecessors());
+    EXPECT_EQ(0.0, t.distance(0));
+    EXPECT_EQ(15.0, t.distance(4));
+}
+
+
+TEST(ShortestPathTreeTests, unknownStartVertexThrows)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    EXPECT_THROW((ShortestPathTree<std::string, double>{d, 1, identity}), DigraphException);
+}
+
+
+TEST(ShortestPathTreeTests, increasingNonTreeEdgeCostsNothing)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addVertex(2, "c");
+    d.addEdge(0, 1, 1.0);
+    d.addEdge(1, 2, 1.0);
+    d.addEdge(0, 2, 5.0);
+
+    ShortestPathTree<std::string, double> t{d, 0, identity};
+
+    d.updateEdgeInfo(0, 2, 9.0);
+    EXPECT_EQ(0, t.edgeUpdated(d, 0, 2, 5.0));
+    EXPECT_EQ(1, t.predecessor(2));
+}
+
+
+TEST(ShortestPathTreeTests, increasingTreeEdgeReroutesSubtree)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addVertex(2, "c");
+    d.addVertex(3, "d");
+    d.addEdge(0, 1, 1.0);
+    d.addEdge(1, 2, 1.0);
+    d.addEdge(2, 3, 1.0);
+    d.addEdge(0, 2, 5.0);
+
+    ShortestPathTree<std::string, double> t{d, 0, identity};
+
+    d.updateEdgeInfo(1, 2, 10.0);
+    EXPECT_EQ(2, t.edgeUpdated(d, 1, 2, 1.0));
+    EXPECT_EQ(0, t.predecessor(2));
+    EXPECT_EQ(5.0, t.distance(2));
+    EXPECT_EQ(6.0, t.distance(3));
+    EXPECT_EQ(1.0, t.distance(1));
+}
+
+
+TEST(ShortestPathTreeTests, decreasingEdgeImprovesDownstreamVertices)
+{
+    Digraph<std::string, double> d;
+    d.addVertex(0, "a");
+    d.addVertex(1, "b");
+    d.addVertex(2, "c");
+    d.addVertex(3, "d");
+    d.addEdge(0, 1, 1.0);
+    d.addEdge(1, 2, 1.0);
+    d.addEdge(2, 3, 1.0);
+    d.addEdge(0, 2, 5.0);
+
+    ShortestPathTree<std::string, double> t{d, 0, identity};
+
+    d.updateEdgeInfo(0, 2, 0.5);
+    EXPECT_EQ(2, t.edgeUpdated(d, 0, 2, 5.0));
+    EXPECT_EQ(0, t.predecessor(2));
+    EXPECT_EQ(1.5, t.distance(3));
+}
+
+
+TEST(ShortestPathTreeTests, repairedTreeMatchesRecomputedTree)
+{
+    Digraph<std::string, double> d = makeGrid(8);
+    ShortestPathTree<std::string, double> t{d, 0, identity};
+
+    std::mt19937 random{1};
+    std::uniform_real_distribution<double> weight{0.5, 20.0};
+    std::vector<std::pair<int, int>> edges = d.edges();
+
+    for (int i = 0; i < 200; ++i)
+    {
+        auto [from, to] = edges[random() % edges.size()];
+        double oldWeight = d.edgeInfo(from, to);
+        d.updateEdgeInfo(from, to, weight(random));
+        t.edgeUpdated(d, from, to, oldWeight);
+    }
+
+    expectSameDistances(d, t);
+}
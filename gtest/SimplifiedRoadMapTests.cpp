@@ -0,0 +1,277 @@
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "RandomGraphs.hpp"
+#include "RoadMap.hpp"
+#include "ShortestPathTree.hpp"
+#include "SimplifiedRoadMap.hpp"
+#include "TripMetricWeight.hpp"
+
+
+namespace
+{
+    RoadMap makeRoadMap(int vertexCount)
+    {
+        RoadMap roadMap;
+
+        for (int v = 0; v < vertexCount; ++v)
+        {
+            roadMap.addVertex(v, "Intersection " + std::to_string(v));
+        }
+
+        return roadMap;
+    }
+
+
+    // subdividedGrid() returns a random grid in which every street between
+    // two neighbors passes through an extra intersection in the middle,
+    // so there's plenty to collapse.
+    RoadMap subdividedGrid(int size, unsigned int seed)
+    {
+        Digraph<std::string, double> grid = makeRandomGrid(size, seed, 0.3);
+        RoadMap roadMap;
+        std::mt19937 random{seed};
+        std::uniform_real_distribution<double> speed{20.0, 70.0};
+
+        for (int v : grid.vertices())
+        {
+            roadMap.addVertex(v, grid.vertexInfo(v));
+        }
+
+        int middle = 1;
+
+        for (auto& [from, to] : grid.edges())
+        {
+            bool twoWay = true;
+
+            try
+            {
+                grid.edgeInfo(to, from);
+            }
+            catch (DigraphException&)
+            {
+                twoWay = false;
+            }
+
+            if (twoWay && to < from)
+            {
+                continue;
+            }
+
+            roadMap.addVertex(middle, "Middle " + std::to_string(middle));
+            double half = grid.edgeInfo(from, to) / 2.0;
+
+            roadMap.addEdge(from, middle, RoadSegment{half, speed(random)});
+            roadMap.addEdge(middle, to, RoadSegment{half, speed(random)});
+
+            if (twoWay)
+            {
+                roadMap.addEdge(to, middle, RoadSegment{half, speed(random)});
+                roadMap.addEdge(middle, from, RoadSegment{half, speed(random)});
+            }
+
+            middle += 10;
+        }
+
+        return roadMap;
+    }
+
+
+    std::vector<int> pathTo(const ShortestPathTree<std::string_view, RoadSegment>& tree, int end)
+    {
+        std::vector<int> path{end};
+
+        for (int v = end; v != tree.startVertex(); v = tree.predecessor(v))
+        {
+            path.insert(path.begin(), tree.predecessor(v));
+        }
+
+        return path;
+    }
+
+
+    // expectSameShortestPaths() checks that, from each given start vertex,
+    // the simplified RoadMap has the same distances as the original to
+    // every kept vertex, and that its routes expand into routes of the
+    // same length in the original.
+    void expectSameShortestPaths(
+        const RoadMap& roadMap, const SimplifiedRoadMap& simplified, const std::vector<int>& starts)
+    {
+        for (TripMetric metric : {TripMetric::Distance, TripMetric::Time})
+        {
+            for (int start : starts)
+            {
+                ShortestPathTree<std::string_view, RoadSegment> original{roadMap, start, tripMetricWeight(metric)};
+                ShortestPathTree<std::string_view, RoadSegment> reduced{
+                    simplified.roadMap(), start, tripMetricWeight(metric)};
+
+                for (int end : simplified.roadMap().vertices())
+                {
+                    double expected = original.distance(end);
+                    ASSERT_TRUE(sameDistance(expected, reduced.distance(end)));
+
+                    if (expected != std::numeric_limits<double>::infinity())
+                    {
+                        std::vector<int> route = simplified.expandRoute(pathTo(reduced, end));
+                        ASSERT_FALSE(route.empty());
+                        EXPECT_EQ(start, route.front());
+                        EXPECT_EQ(end, route.back());
+                        EXPECT_NEAR(expected, routeLength(roadMap, route, metric), 1e-9);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+TEST(SimplifiedRoadMapTests, oneWayChainsCollapse)
+{
+    // 0 -> 1 -> 2 -> 3, like a freeway ramp
+    RoadMap roadMap = makeRoadMap(4);
+    roadMap.addEdge(0, 1, RoadSegment{1.0, 30.0});
+    roadMap.addEdge(1, 2, RoadSegment{2.0, 60.0});
+    roadMap.addEdge(2, 3, RoadSegment{3.0, 45.0});
+
+    SimplifiedRoadMap simplified{roadMap, {0, 3}};
+
+    EXPECT_EQ(2, simplified.roadMap().vertexCount());
+    ASSERT_EQ(1, simplified.roadMap().edgeCount());
+    EXPECT_EQ(2, simplified.hopCount(0, 3));
+
+    RoadSegment segment = simplified.roadMap().edgeInfo(0, 3);
+    EXPECT_DOUBLE_EQ(6.0, segment.miles);
+    EXPECT_DOUBLE_EQ(1.0 / 30.0 + 2.0 / 60.0 + 3.0 / 45.0, segment.miles / segment.milesPerHour);
+
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3}), simplified.expandRoute({0, 3}));
+    EXPECT_EQ((std::vector<int>{0}), simplified.expandRoute({0}));
+    EXPECT_TRUE(simplified.expandRoute({}).empty());
+}
+
+
+TEST(SimplifiedRoadMapTests, twoWayStreetsCollapseBothWays)
+{
+    RoadMap roadMap = makeRoadMap(4);
+
+    for (int v = 0; v < 3; ++v)
+    {
+        roadMap.addEdge(v, v + 1, RoadSegment{1.0, 25.0});
+        roadMap.addEdge(v + 1, v, RoadSegment{1.0, 35.0});
+    }
+
+    SimplifiedRoadMap simplified{roadMap, {0, 3}};
+
+    EXPECT_EQ(2, simplified.roadMap().vertexCount());
+    EXPECT_EQ(2, simplified.roadMap().edgeCount());
+    EXPECT_EQ((std::vector<int>{0, 1, 2, 3}), simplified.expandRoute({0, 3}));
+    EXPECT_EQ((std::vector<int>{3, 2, 1, 0}), simplified.expandRoute({3, 0}));
+}
+
+
+TEST(SimplifiedRoadMapTests, protectedVerticesAreKept)
+{
+    RoadMap roadMap = makeRoadMap(4);
+    roadMap.addEdge(0, 1, RoadSegment{1.0, 30.0});
+    roadMap.addEdge(1, 2, RoadSegment{2.0, 60.0});
+    roadMap.addEdge(2, 3, RoadSegment{3.0, 45.0});
+
+    SimplifiedRoadMap simplified{roadMap, {0, 2, 3}};
+
+    EXPECT_EQ(3, simplified.roadMap().vertexCount());
+    EXPECT_EQ(1, simplified.hopCount(0, 2));
+    EXPECT_EQ(0, simplified.hopCount(2, 3));
+    EXPECT_THROW(simplified.hopCount(0, 3), DigraphException);
+}
+
+
+TEST(SimplifiedRoadMapTests, parallelRunsAreNotMerged)
+{
+    // Two ways from 0 to 3: the shorter one through 1, the faster one
+    // through 2, plus a direct road that's worse than both.
+    RoadMap roadMap = makeRoadMap(4);
+    roadMap.addEdge(0, 1, RoadSegment{1.0, 10.0});
+    roadMap.addEdge(1, 3, RoadSegment{1.0, 10.0});
+    roadMap.addEdge(0, 2, RoadSegment{2.0, 60.0});
+    roadMap.addEdge(2, 3, RoadSegment{2.0, 60.0});
+    roadMap.addEdge(0, 3, RoadSegment{5.0, 20.0});
+
+    SimplifiedRoadMap simplified{roadMap, {0, 3}};
+
+    // Collapsing either run would give a second segment from 0 to 3.
+    EXPECT_EQ(4, simplified.roadMap().vertexCount());
+    expectSameShortestPaths(roadMap, simplified, {0});
+
+    roadMap.removeEdge(0, 3);
+    SimplifiedRoadMap withoutDirectRoad{roadMap, {0, 3}};
+
+    EXPECT_EQ(3, withoutDirectRoad.roadMap().vertexCount());
+    expectSameShortestPaths(roadMap, withoutDirectRoad, {0});
+}
+
+
+TEST(SimplifiedRoadMapTests, everyParallelStreetKeepsOneMidBlockVertex)
+{
+    // Junctions 0..9 in a ring, each joined to the next by two two-way
+    // streets through mid-block vertices 10 + 2j and 11 + 2j, so every
+    // block has a conflict to resolve.
+    RoadMap roadMap = makeRoadMap(30);
+
+    for (int j = 0; j < 10; ++j)
+    {
+        int next = (j + 1) % 10;
+
+        for (int mid : {10 + 2 * j, 11 + 2 * j})
+        {
+            double miles = mid % 2 == 0 ? 1.0 : 2.0;
+            roadMap.addEdge(j, mid, RoadSegment{miles, 30.0});
+            roadMap.addEdge(mid, j, RoadSegment{miles, 30.0});
+            roadMap.addEdge(mid, next, RoadSegment{1.0, 30.0});
+            roadMap.addEdge(next, mid, RoadSegment{1.0, 30.0});
+        }
+    }
+
+    SimplifiedRoadMap simplified{roadMap, {}};
+
+    EXPECT_EQ(20, simplified.roadMap().vertexCount());
+    expectSameShortestPaths(roadMap, simplified, {0, 5, 13});
+}
+
+
+TEST(SimplifiedRoadMapTests, ringsOfPassThroughsKeepAVertex)
+{
+    RoadMap roadMap = makeRoadMap(6);
+    roadMap.addEdge(0, 1, RoadSegment{1.0, 30.0});
+    roadMap.addEdge(1, 0, RoadSegment{1.0, 30.0});
+
+    // 2 -> 3 -> 4 -> 5 -> 2, with nothing else attached
+    for (int v = 2; v < 6; ++v)
+    {
+        roadMap.addEdge(v, v == 5 ? 2 : v + 1, RoadSegment{1.0, 30.0});
+    }
+
+    SimplifiedRoadMap simplified{roadMap, {0, 1}};
+
+    EXPECT_EQ(3, simplified.roadMap().vertexCount());
+    EXPECT_EQ(2, simplified.roadMap().edgeCount());
+}
+
+
+TEST(SimplifiedRoadMapTests, shortestPathsArePreservedOnGrids)
+{
+    RoadMap roadMap = subdividedGrid(8, 51);
+    std::vector<int> starts{0, 270, 630};
+    SimplifiedRoadMap simplified{roadMap, starts};
+
+    EXPECT_LT(simplified.roadMap().vertexCount(), roadMap.vertexCount() * 2 / 3);
+    expectSameShortestPaths(roadMap, simplified, starts);
+}
+
+
+TEST(SimplifiedRoadMapTests, tripEndpointsListsBothEnds)
+{
+    std::vector<Trip> trips{{1, 2, TripMetric::Distance}, {3, 1, TripMetric::Time}};
+    EXPECT_EQ((std::vector<int>{1, 2, 3, 1}), tripEndpoints(trips));
+}
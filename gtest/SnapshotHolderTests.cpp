@@ -0,0 +1,101 @@
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <gtest/gtest.h>
+#include "Digraph.hpp"
+#include "SnapshotHolder.hpp"
+
+
+TEST(SnapshotHolderTests, emptyHolderHasNoSnapshot)
+{
+    SnapshotHolder<Digraph<std::string, double>> h;
+    EXPECT_EQ(nullptr, h.current());
+    EXPECT_EQ(0, h.version());
+}
+
+
+TEST(SnapshotHolderTests, readersKeepTheirSnapshotAcrossPublish)
+{
+    auto first = std::make_shared<Digraph<std::string, double>>();
+    first->addVertex(0, "a");
+    SnapshotHolder<Digraph<std::string, double>> h{first};
+
+    std::shared_ptr<const Digraph<std::string, double>> reader = h.current();
+
+    auto second = std::make_shared<Digraph<std::string, double>>();
+    second->addVertex(0, "a");
+    second->addVertex(1, "b");
+    h.publish(second);
+
+    EXPECT_EQ(1, reader->vertexCount());
+    EXPECT_EQ(2, h.current()->vertexCount());
+    EXPECT_EQ(2, h.version());
+}
+
+
+TEST(SnapshotHolderTests, oldSnapshotIsFreedAfterLastReader)
+{
+    std::weak_ptr<const Digraph<std::string, double>> watcher;
+
+    SnapshotHolder<Digraph<std::string, double>> h{
+        std::make_shared<Digraph<std::string, double>>()};
+    std::shared_ptr<const Digraph<std::string, double>> reader = h.current();
+    watcher = reader;
+
+    h.publish(std::make_shared<Digraph<std::string, double>>());
+    EXPECT_FALSE(watcher.expired());
+
+    reader.reset();
+    EXPECT_TRUE(watcher.expired());
+}
+
+
+TEST(SnapshotHolderTests, concurrentReadersAlwaysSeeAWholeVersion)
+{
+    auto makeGraph = [](int n)
+        {
+            auto d = std::make_shared<Digraph<int, double>>();
+            for (int i = 0; i < n; ++i)
+            {
+                d->addVertex(i, n);
+            }
+            return d;
+        };
+
+    SnapshotHolder<Digraph<int, double>> h{makeGraph(1)};
+
+    std::vector<std::thread> readers;
+    std::vector<int> mismatches(4, 0);
+
+    for (int r = 0; r < 4; ++r)
+    {
+        readers.emplace_back([&, r]()
+            {
+                for (int i = 0; i < 2000; ++i)
+                {
+                    auto snapshot = h.current();
+                    if (snapshot->vertexInfo(0) != snapshot->vertexCount())
+                    {
+                        mismatches[r]++;
+                    }
+                }
+            });
+    }
+
+    for (int n = 2; n <= 50; ++n)
+    {
+        h.publish(makeGraph(n));
+    }
+
+    for (std::thread& t : readers)
+    {
+        t.join();
+    }
+
+    for (int m : mismatches)
+    {
+        EXPECT_EQ(0, m);
+    }
+    EXPECT_EQ(50, h.current()->vertexCount());
+}
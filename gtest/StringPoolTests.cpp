@@ -0,0 +1,58 @@
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "StringPool.hpp"
+
+
+TEST(StringPoolTests, internedStringsAreCopiesThatCompareEqual)
+{
+    StringPool pool;
+    std::string original = "Anteater Drive";
+
+    std::string_view interned = pool.intern(original);
+    original[0] = 'X';
+
+    EXPECT_EQ("Anteater Drive", interned);
+    EXPECT_NE(original.data(), interned.data());
+    EXPECT_TRUE(pool.contains(interned));
+    EXPECT_FALSE(pool.contains(original));
+}
+
+
+TEST(StringPoolTests, duplicatesAreStoredOnce)
+{
+    StringPool pool;
+
+    std::string_view first = pool.intern("Campus & Bison");
+    std::string_view second = pool.intern(std::string{"Campus & Bison"});
+    pool.intern("Jamboree");
+
+    EXPECT_EQ(first.data(), second.data());
+    EXPECT_EQ(2u, pool.size());
+    EXPECT_EQ(22u, pool.bytesUsed());
+}
+
+
+TEST(StringPoolTests, viewsStayValidAsThePoolGrows)
+{
+    StringPool pool{16};
+    std::vector<std::string_view> views;
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        views.push_back(pool.intern("Location " + std::to_string(i)));
+    }
+
+    views.push_back(pool.intern(std::string(100, 'z')));
+    views.push_back(pool.intern(""));
+
+    for (int i = 0; i < 1000; ++i)
+    {
+        EXPECT_EQ("Location " + std::to_string(i), views[i]);
+    }
+
+    EXPECT_EQ(std::string(100, 'z'), views[1000]);
+    EXPECT_EQ("", views[1001]);
+    EXPECT_EQ(1002u, pool.size());
+}
@@ -0,0 +1,12 @@
+#include <gtest/gtest.h>
+#include "TimeFormat.hpp"
+
+
+TEST(TimeFormatTests, showsOnlyTheUnitsNeeded)
+{
+    EXPECT_EQ("3.5 secs", formatTime(3.5));
+    EXPECT_EQ("1 min 0.0 secs", formatTime(60.0));
+    EXPECT_EQ("2 mins 5.2 secs", formatTime(125.25));
+    EXPECT_EQ("1 hr 4 mins 3.5 secs", formatTime(3843.5));
+    EXPECT_EQ("2 hrs 0.0 secs", formatTime(7200.0));
+}
@@ -0,0 +1,140 @@
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include "InputReader.hpp"
+#include "MultiLevelOverlay.hpp"
+#include "RandomGraphs.hpp"
+#include "RoadMap.hpp"
+#include "RoadMapOverlay.hpp"
+#include "TrafficDeltaReader.hpp"
+#include "TrafficUpdater.hpp"
+#include "TripMetricWeight.hpp"
+
+
+namespace
+{
+    // deltaFile() writes a traffic delta file that changes the speed of
+    // every tenth road segment, alternately slowing it down and speeding
+    // it up.
+    std::string deltaFile(const RoadMap& roadMap)
+    {
+        std::vector<std::pair<int, int>> edges = roadMap.edges();
+        std::ostringstream out;
+
+        out << "# number of updates\n" << (edges.size() + 9) / 10 << "\n\n# the updates\n";
+
+        for (std::size_t i = 0; i < edges.size(); i += 10)
+        {
+            double mph = roadMap.edgeInfo(edges[i].first, edges[i].second).milesPerHour;
+            out << edges[i].first << " " << edges[i].second << " " << (i % 20 == 0 ? mph / 3 : mph * 2) << "\n";
+        }
+
+        return out.str();
+    }
+
+
+    std::vector<TrafficDelta> readDeltas(const std::string& text)
+    {
+        std::istringstream in{text};
+        InputReader reader{in};
+        return TrafficDeltaReader{}.readTrafficDeltas(reader);
+    }
+}
+
+
+TEST(TrafficUpdaterTests, readsDeltaFiles)
+{
+    std::vector<TrafficDelta> deltas = readDeltas(
+        "# number of updates\n2\n\n# the updates\n11 10 23.5\n  \n10 9 31.0\n");
+
+    ASSERT_EQ(2u, deltas.size());
+    EXPECT_EQ(11, deltas[0].fromVertex);
+    EXPECT_EQ(10, deltas[0].toVertex);
+    EXPECT_EQ(23.5, deltas[0].milesPerHour);
+    EXPECT_EQ(10, deltas[1].fromVertex);
+    EXPECT_EQ(9, deltas[1].toVertex);
+    EXPECT_EQ(31.0, deltas[1].milesPerHour);
+}
+
+
+TEST(TrafficUpdaterTests, repairedTreesMatchTreesBuiltFromScratch)
+{
+    RoadMap roadMap = makeRandomRoadMap(12, 27, 0.3);
+    std::vector<TrafficDelta> deltas = readDeltas(deltaFile(roadMap));
+    ASSERT_FALSE(deltas.empty());
+
+    std::vector<RoadMapShortestPathTree> trees;
+
+    for (int start : {0, 370, 1430})
+    {
+        trees.emplace_back(roadMap, start, tripMetricWeight(TripMetric::Time));
+        trees.emplace_back(roadMap, start, tripMetricWeight(TripMetric::Distance));
+    }
+
+    int changed = TrafficUpdater{}.applyDeltas(roadMap, deltas, trees);
+    EXPECT_GT(changed, 0);
+
+    for (const TrafficDelta& delta : deltas)
+    {
+        EXPECT_EQ(delta.milesPerHour, roadMap.edgeInfo(delta.fromVertex, delta.toVertex).milesPerHour);
+    }
+
+    for (std::size_t i = 0; i < trees.size(); ++i)
+    {
+        TripMetric metric = i % 2 == 0 ? TripMetric::Time : TripMetric::Distance;
+        RoadMapShortestPathTree fresh{roadMap, trees[i].startVertex(), tripMetricWeight(metric)};
+
+        for (int v : roadMap.vertices())
+        {
+            EXPECT_TRUE(sameDistance(fresh.distance(v), trees[i].distance(v)));
+        }
+    }
+
+    std::vector<TrafficDelta> missing{{0, 9999, 30.0}};
+    EXPECT_THROW(TrafficUpdater{}.applyDeltas(roadMap, missing, trees), DigraphException);
+}
+
+
+TEST(TrafficUpdaterTests, overlayUpdatesMatchCustomizingFromScratch)
+{
+    RoadMap roadMap = makeRandomRoadMap(12, 28, 0.3);
+    std::vector<TrafficDelta> deltas = readDeltas(deltaFile(roadMap));
+
+    RoadMapOverlay overlay{roadMap, 2};
+    int customized = overlay.applyTrafficDeltas(deltas, 2);
+    EXPECT_GT(customized, 0);
+
+    std::vector<RoadMapShortestPathTree> noTrees;
+    TrafficUpdater{}.applyDeltas(roadMap, deltas, noTrees);
+
+    const CompactDigraph& g = overlay.graph();
+    OverlayMetric fresh{overlay.overlay(), g.arcWeights(roadMap, tripMetricWeight(TripMetric::Time)), 1};
+    const OverlayMetric& updated = overlay.metric(TripMetric::Time);
+
+    for (int arc = 0; arc < g.arcCount(); ++arc)
+    {
+        EXPECT_EQ(fresh.arcWeight(arc), updated.arcWeight(arc));
+    }
+
+    for (int l = 0; l < overlay.overlay().levelCount(); ++l)
+    {
+        const OverlayLevel& level = overlay.overlay().level(l);
+
+        for (int c = 0; c < overlay.overlay().partition().cellCount(l); ++c)
+        {
+            int size = level.firstBoundary[c + 1] - level.firstBoundary[c];
+
+            for (int i = 0; i < size; ++i)
+            {
+                for (int j = 0; j < size; ++j)
+                {
+                    EXPECT_EQ(fresh.cliqueWeight(l, c, i, j), updated.cliqueWeight(l, c, i, j));
+                }
+            }
+        }
+    }
+
+    std::vector<TrafficDelta> missing{{0, 9999, 30.0}};
+    EXPECT_THROW(overlay.applyTrafficDeltas(missing), DigraphException);
+}
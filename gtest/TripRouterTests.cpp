@@ -0,0 +1,90 @@
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <gtest/gtest.h>
+#include "RandomGraphs.hpp"
+#include "RoadMap.hpp"
+#include "TripMetricWeight.hpp"
+#include "TripRouter.hpp"
+
+
+namespace
+{
+    // expectShortestRoutes() checks that the given engine's route for each
+    // trip runs from its start to its end along road segments, and is as
+    // short under the trip's metric as a Dijkstra search says it can be.
+    void expectShortestRoutes(
+        const std::string& engine, const RoadMap& roadMap, const std::vector<Trip>& trips,
+        const std::string& indexPath = "")
+    {
+        std::vector<std::vector<int>> routes =
+            makeTripRouter(engine, roadMap, indexPath)->findRoutes(trips);
+        ASSERT_EQ(trips.size(), routes.size());
+
+        for (std::size_t i = 0; i < trips.size(); ++i)
+        {
+            const Trip& trip = trips[i];
+            ShortestPathTree<std::string_view, RoadSegment> tree{
+                roadMap, trip.startVertex, tripMetricWeight(trip.metric)};
+
+            if (tree.distance(trip.endVertex) == std::numeric_limits<double>::infinity())
+            {
+                EXPECT_TRUE(routes[i].empty());
+                continue;
+            }
+
+            const std::vector<int>& route = routes[i];
+            ASSERT_FALSE(route.empty());
+            EXPECT_EQ(trip.startVertex, route.front());
+            EXPECT_EQ(trip.endVertex, route.back());
+            EXPECT_NEAR(tree.distance(trip.endVertex), routeLength(roadMap, route, trip.metric), 1e-9);
+        }
+    }
+}
+
+
+TEST(TripRouterTests, dijkstraSearchesForwardFromSharedStarts)
+{
+    RoadMap roadMap = makeRandomRoadMap(8, 3, 0.3);
+    std::vector<Trip> trips;
+
+    for (int end : {70, 330, 450, 630})
+    {
+        trips.push_back(Trip{0, end, TripMetric::Distance});
+        trips.push_back(Trip{0, end, TripMetric::Time});
+    }
+
+    expectShortestRoutes("dijkstra", roadMap, trips);
+}
+
+
+TEST(TripRouterTests, dijkstraSearchesBackwardToASharedDepot)
+{
+    // Every trip of each metric ends at the same depot, so one backward
+    // search per metric covers them all.
+    RoadMap roadMap = makeRandomRoadMap(8, 4, 0.3);
+    std::vector<Trip> trips;
+
+    for (int start : {0, 70, 210, 330, 450, 560, 630})
+    {
+        trips.push_back(Trip{start, 270, TripMetric::Distance});
+        trips.push_back(Trip{start, 270, TripMetric::Time});
+    }
+
+    trips.push_back(Trip{270, 0, TripMetric::Time});
+
+    expectShortestRoutes("dijkstra", roadMap, trips);
+}
+
+
+TEST(TripRouterTests, allPairsAnswersTripsWhenTheIndexCantBeWritten)
+{
+    RoadMap roadMap = makeRandomRoadMap(6, 5, 0.3);
+    std::vector<Trip> trips{
+        Trip{0, 350, TripMetric::Distance},
+        Trip{350, 0, TripMetric::Time},
+        Trip{70, 280, TripMetric::Time}};
+
+    expectShortestRoutes("all-pairs", roadMap, trips, "/nonexistent/dir/index");
+}